@@ -0,0 +1,37 @@
+#!/usr/bin/env python
+
+# Prepends the header read by shell/app/browser_snapshot.cc to a snapshot
+# blob: the magic, the V8 version, and the size and CRC-32 of the blob.
+
+import re
+import struct
+import sys
+import zlib
+
+MAGIC = b'ELECTRONSNAPSHOT'
+VERSION_SIZE = 32
+HEADER_SIZE = 64
+
+def read_v8_version(version_header):
+  with open(version_header, 'r') as f:
+    content = f.read()
+  parts = []
+  for name in ['MAJOR_VERSION', 'MINOR_VERSION', 'BUILD_NUMBER', 'PATCH_LEVEL']:
+    match = re.search(r'#define V8_' + name + r'\s+(\d+)', content)
+    parts.append(match.group(1))
+  return '.'.join(parts)
+
+def main(blob_path, version_header, output_path):
+  with open(blob_path, 'rb') as f:
+    blob = f.read()
+  version = read_v8_version(version_header).encode('ascii')
+  header = MAGIC + version.ljust(VERSION_SIZE, b'\0')
+  header += struct.pack('<II', len(blob), zlib.crc32(blob) & 0xffffffff)
+  header = header.ljust(HEADER_SIZE, b'\0')
+  with open(output_path, 'wb') as f:
+    f.write(header)
+    f.write(blob)
+  return 0
+
+if __name__ == '__main__':
+  sys.exit(main(*sys.argv[1:]))
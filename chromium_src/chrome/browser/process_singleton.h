@@ -90,6 +90,16 @@ class ProcessSingleton {
 
 #if defined(OS_POSIX) && !defined(OS_ANDROID)
   static void DisablePromptForTesting();
+
+  // Notifies the instance of the same app that enabled early notifications,
+  // from main() before anything but the command line is initialized. Returns
+  // true when the instance handled the command line, and this process should
+  // exit.
+  static bool NotifyOtherProcessEarly(int argc, char* argv[]);
+
+  // Lets the next processes of the same app notify this instance with
+  // NotifyOtherProcessEarly(), once it is the singleton instance.
+  bool EnableEarlyNotification();
 #endif
 #if defined(OS_WIN)
   // Called to query whether to kill a hung browser process that has visible
@@ -168,6 +178,9 @@ class ProcessSingleton {
   // Path in file system to the cookie file.
   base::FilePath cookie_path_;
 
+  // Path in file system to the link for early notifications, if enabled.
+  base::FilePath early_notification_link_path_;
+
   // Temporary directory to hold the socket.
   base::ScopedTempDir socket_dir_;
 
@@ -36,6 +36,12 @@
 // process will be considered as hung for some reason. The second process then
 // retrieves the process id from the symbol link and kills it by sending
 // SIGKILL. Then the second process starts as normal.
+//
+// The user data dir is only known once the app's JavaScript runs, which
+// happens after the browser is initialized. An instance can therefore also
+// link its user data dir from a per-user directory, under a name derived from
+// the executable and app paths. The next processes of the same app find it
+// from main() and notify the instance before initializing anything else.
 
 #include "chrome/browser/process_singleton.h"
 
@@ -58,18 +64,21 @@
 #include "shell/browser/browser.h"
 #include "shell/common/electron_command_line.h"
 
+#include "base/at_exit.h"
 #include "base/base_paths.h"
 #include "base/bind.h"
 #include "base/command_line.h"
 #include "base/files/file_descriptor_watcher_posix.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
+#include "base/hash/md5.h"
 #include "base/location.h"
 #include "base/logging.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
 #include "base/message_loop/message_loop.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/no_destructor.h"
 #include "base/path_service.h"
 #include "base/posix/eintr_wrapper.h"
 #include "base/posix/safe_strerror.h"
@@ -98,6 +107,10 @@
 #include "ui/views/linux_ui/linux_ui.h"
 #endif
 
+#if defined(OS_MACOSX)
+#include "shell/common/mac/main_application_bundle.h"
+#endif
+
 using content::BrowserThread;
 
 namespace {
@@ -108,6 +121,9 @@ const int kTimeoutInSeconds = 20;
 // Number of retries to notify the browser. 20 retries over 20 seconds = 1 try
 // per second.
 const int kRetryAttempts = 20;
+// Timeout for the early notification, which is followed by the regular one
+// when the browser process doesn't respond.
+const int kEarlyTimeoutInSeconds = 2;
 static bool g_disable_prompt;
 const char kStartToken[] = "START";
 const char kACKToken[] = "ACK";
@@ -126,6 +142,8 @@ const base::FilePath::CharType kSingletonLockFilename[] =
 const base::FilePath::CharType kSingletonSocketFilename[] =
     FILE_PATH_LITERAL("SS");
 
+const char kEarlyNotificationLinkPrefix[] = "electron-singleton-";
+
 // Set the close-on-exec bit on a file descriptor.
 // Returns 0 on success, -1 on failure.
 int SetCloseOnExec(int fd) {
@@ -457,6 +475,70 @@ bool ReplaceOldSingletonLock(const base::FilePath& symlink_content,
 }
 #endif  // defined(OS_MACOSX)
 
+// The link to the user data dir of the instance that enabled early
+// notifications, computed when the process starts since it depends on the
+// current directory.
+base::FilePath& GetEarlyNotificationLinkPath() {
+  static base::NoDestructor<base::FilePath> path;
+  return *path;
+}
+
+// Returns whether the app is bundled with the executable, rather than passed
+// to the default app on the command line.
+bool IsPackagedApp(const base::FilePath& exe_path) {
+#if defined(OS_MACOSX)
+  base::FilePath resources_path = electron::MainApplicationBundlePath()
+                                      .Append("Contents")
+                                      .Append("Resources");
+#else
+  base::FilePath resources_path = exe_path.DirName().Append("resources");
+#endif
+  return base::PathExists(resources_path.Append("app.asar")) ||
+         base::DirectoryExists(resources_path.Append("app"));
+}
+
+// Computes where the instance of this app links its user data dir, which is in
+// a directory only the user can write to so the link can't lead to the socket
+// of another user. The name hashes the executable path and, when the app isn't
+// packaged, the resolved app path passed as the first positional argument.
+// Must be called while base::CommandLine is initialized.
+base::FilePath ComputeEarlyNotificationLinkPath() {
+  base::FilePath link_dir;
+#if defined(OS_MACOSX)
+  // The temporary directory is per user on macOS.
+  if (!base::GetTempDir(&link_dir))
+    return base::FilePath();
+#else
+  const char* runtime_dir = getenv("XDG_RUNTIME_DIR");
+  if (!runtime_dir || !runtime_dir[0])
+    return base::FilePath();
+  link_dir = base::FilePath(runtime_dir);
+#endif
+
+  base::FilePath exe_path;
+  if (!base::PathService::Get(base::FILE_EXE, &exe_path))
+    return base::FilePath();
+  std::string key = exe_path.value();
+
+  if (!IsPackagedApp(exe_path)) {
+    // The default app runs the first argument that isn't a switch. It is
+    // resolved so that the same app matches whichever directory it was
+    // started from and however its path was spelled.
+    const auto args = base::CommandLine::ForCurrentProcess()->GetArgs();
+    if (args.empty())
+      return base::FilePath();
+    const base::FilePath app_path =
+        base::MakeAbsoluteFilePath(base::FilePath(args[0]));
+    if (app_path.empty())
+      return base::FilePath();
+    key.push_back(kTokenDelimiter);
+    key.append(app_path.value());
+  }
+
+  return link_dir.Append(kEarlyNotificationLinkPrefix +
+                         base::MD5String(key));
+}
+
 }  // namespace
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -753,7 +835,8 @@ ProcessSingleton::NotifyResult ProcessSingleton::NotifyOtherProcessWithTimeout(
   DCHECK_GE(retry_attempts, 0);
   DCHECK_GE(timeout.InMicroseconds(), 0);
 
-  base::TimeDelta sleep_interval = timeout / retry_attempts;
+  base::TimeDelta sleep_interval =
+      retry_attempts > 0 ? timeout / retry_attempts : timeout;
 
   ScopedSocket socket;
   for (int retries = 0; retries <= retry_attempts; ++retries) {
@@ -956,6 +1039,60 @@ void ProcessSingleton::DisablePromptForTesting() {
   g_disable_prompt = true;
 }
 
+// static
+bool ProcessSingleton::NotifyOtherProcessEarly(int argc, char* argv[]) {
+  base::AtExitManager at_exit_manager;
+  base::CommandLine::Init(argc, argv);
+  // Leave the command line to be parsed again by the browser, which may
+  // change the arguments before.
+  struct ResetCommandLine {
+    ~ResetCommandLine() { base::CommandLine::Reset(); }
+  } reset_command_line;
+
+  // Child processes are started by the browser with their type, and an
+  // explicit user data dir may not be the one of the linked instance.
+  const auto* command_line = base::CommandLine::ForCurrentProcess();
+  if (command_line->HasSwitch("type") ||
+      command_line->HasSwitch("user-data-dir"))
+    return false;
+
+  const base::FilePath link_path = ComputeEarlyNotificationLinkPath();
+  GetEarlyNotificationLinkPath() = link_path;
+  if (link_path.empty())
+    return false;
+
+  struct stat link_info;
+  if (lstat(link_path.value().c_str(), &link_info) != 0 ||
+      !S_ISLNK(link_info.st_mode) || link_info.st_uid != geteuid())
+    return false;
+  base::FilePath user_data_dir = ReadLink(link_path);
+  if (user_data_dir.empty() || !base::DirectoryExists(user_data_dir))
+    return false;
+
+  // Anything but a notified instance falls back to the regular startup, which
+  // waits for instances that are starting and handles hung ones, so a hung
+  // instance is only given a short time here.
+  ProcessSingleton singleton(user_data_dir, NotificationCallback());
+  return singleton.NotifyOtherProcessWithTimeout(
+             *command_line, 0,
+             base::TimeDelta::FromSeconds(kEarlyTimeoutInSeconds),
+             false) == PROCESS_NOTIFIED;
+}
+
+bool ProcessSingleton::EnableEarlyNotification() {
+  base::ThreadRestrictions::ScopedAllowIO allow_io;
+  const base::FilePath& link_path = GetEarlyNotificationLinkPath();
+  if (link_path.empty())
+    return false;
+
+  // Replace the link of a previous instance that didn't clean up.
+  UnlinkPath(link_path);
+  if (!SymlinkPath(socket_path_.DirName(), link_path))
+    return false;
+  early_notification_link_path_ = link_path;
+  return true;
+}
+
 bool ProcessSingleton::Create() {
   base::ThreadRestrictions::ScopedAllowIO allow_io;
   int sock;
@@ -1059,6 +1196,8 @@ void ProcessSingleton::Cleanup() {
   UnlinkPath(socket_path_);
   UnlinkPath(cookie_path_);
   UnlinkPath(lock_path_);
+  if (!early_notification_link_path_.empty())
+    UnlinkPath(early_notification_link_path_);
 }
 
 bool ProcessSingleton::IsSameChromeInstance(pid_t pid) {
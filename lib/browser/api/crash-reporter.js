@@ -1,12 +1,55 @@
 'use strict'
 
 const CrashReporter = require('@electron/internal/common/crash-reporter')
-const { crashReporterInit } = require('@electron/internal/browser/crash-reporter-init')
+const { crashReporterInit, setCrashPipelineEnabled } = require('@electron/internal/browser/crash-reporter-init')
+
+const binding = process.electronBinding('crash_reporter')
+
+// Throws when the |name| option of the pipeline isn't a number of at least
+// |min|, or isn't an integer when it's a count.
+const checkPipelineOption = (pipeline, name, min, integer) => {
+  const value = pipeline[name]
+  if (value == null) return
+  if (typeof value !== 'number' || !(value >= min) || (integer && !Number.isInteger(value))) {
+    throw new Error(`pipeline.${name} must be ${integer ? 'an integer' : 'a number'} of at least ${min}`)
+  }
+}
 
 class CrashReporterMain extends CrashReporter {
   init (options) {
     return crashReporterInit(options)
   }
+
+  start (options) {
+    const pipeline = options != null && process.platform === 'linux' ? options.pipeline : null
+    if (pipeline != null && typeof pipeline !== 'object') throw new Error('pipeline must be an object')
+    if (pipeline != null) {
+      checkPipelineOption(pipeline, 'maxReportsPerSignature', 0, true)
+      checkPipelineOption(pipeline, 'rateLimitWindow', 1, false)
+      checkPipelineOption(pipeline, 'batchSize', 1, true)
+      checkPipelineOption(pipeline, 'uploadInterval', 1, false)
+      checkPipelineOption(pipeline, 'maxPendingReports', 1, true)
+    }
+    setCrashPipelineEnabled(pipeline != null)
+
+    super.start(options)
+
+    if (pipeline != null) {
+      binding.startCrashPipeline(this.crashesDirectory, {
+        ...pipeline,
+        uploadURL: pipeline.uploadURL || options.submitURL,
+        // Servers taking the regular uploads may not accept gzipped bodies.
+        compress: pipeline.compress != null ? pipeline.compress : !!pipeline.uploadURL
+      })
+    }
+  }
+
+  getCrashSignatures () {
+    if (process.platform !== 'linux') {
+      return Promise.reject(new Error('getCrashSignatures is only available on Linux'))
+    }
+    return binding.getCrashSignatures()
+  }
 }
 
 module.exports = new CrashReporterMain()
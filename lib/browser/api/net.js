@@ -36,11 +36,13 @@ const discardableDuplicateHeaders = new Set([
 ])
 
 class IncomingMessage extends Readable {
-  constructor (responseHead) {
+  constructor (responseHead, resumeLoader) {
     super()
     this._shouldPush = false
     this._data = []
     this._responseHead = responseHead
+    this._resumeLoader = resumeLoader
+    this._loaderPaused = false
   }
 
   get statusCode () {
@@ -101,6 +103,8 @@ class IncomingMessage extends Readable {
   }
 
   _storeInternalData (chunk) {
+    // The loader does not read more of the body until the chunk is consumed.
+    if (chunk !== null) this._loaderPaused = true
     this._data.push(chunk)
     this._pushInternalData()
   }
@@ -110,6 +114,10 @@ class IncomingMessage extends Readable {
       const chunk = this._data.shift()
       this._shouldPush = this.push(chunk)
     }
+    if (this._shouldPush && this._loaderPaused) {
+      this._loaderPaused = false
+      this._resumeLoader()
+    }
   }
 
   _read () {
@@ -230,12 +238,22 @@ function parseOptions (options) {
     throw new TypeError('headers must be an object')
   }
 
+  if (options.chunkSize != null && !(Number.isInteger(options.chunkSize) && options.chunkSize >= 0)) {
+    throw new TypeError('chunkSize must be a non-negative integer')
+  }
+
+  if (options.downloadPath != null && typeof options.downloadPath !== 'string') {
+    throw new TypeError('downloadPath must be a string')
+  }
+
   const urlLoaderOptions = {
     method: method,
     url: urlStr,
     redirectPolicy,
     extraHeaders: options.headers || {}
   }
+  if (options.chunkSize) urlLoaderOptions.chunkSize = options.chunkSize
+  if (options.downloadPath) urlLoaderOptions.downloadPath = options.downloadPath
   for (const [name, value] of Object.entries(urlLoaderOptions.extraHeaders)) {
     if (!_isValidHeaderName(name)) {
       throw new Error(`Invalid header name: '${name}'`)
@@ -373,11 +391,13 @@ class ClientRequest extends Writable {
     const opts = { ...this._urlLoaderOptions, extraHeaders: stringifyValues(this._urlLoaderOptions.extraHeaders) }
     this._urlLoader = new URLLoader(opts)
     this._urlLoader.on('response-started', (event, finalUrl, responseHead) => {
-      const response = this._response = new IncomingMessage(responseHead)
+      const response = this._response = new IncomingMessage(responseHead, () => {
+        this._urlLoader.resume()
+      })
       this.emit('response', response)
     })
     this._urlLoader.on('data', (event, data) => {
-      this._response._storeInternalData(Buffer.from(data))
+      this._response._storeInternalData(Buffer.from(data.buffer, data.byteOffset, data.byteLength))
     })
     this._urlLoader.on('complete', () => {
       if (this._response) { this._response._storeInternalData(null) }
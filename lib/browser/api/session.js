@@ -23,6 +23,16 @@ Session.prototype._init = function () {
   app.emit('session-created', this)
 }
 
+// Changes are only converted for "changed" while it has listeners.
+Cookies.prototype._init = function () {
+  this.on('newListener', (event) => {
+    if (event === 'changed') this._setChangedListenersCount(this.listenerCount('changed') + 1)
+  })
+  this.on('removeListener', (event) => {
+    if (event === 'changed') this._setChangedListenersCount(this.listenerCount('changed'))
+  })
+}
+
 const _originalStartLogging = NetLog.prototype.startLogging
 NetLog.prototype.startLogging = function (path, ...args) {
   this._currentlyLoggingPath = path
@@ -573,5 +573,13 @@ module.exports = {
 
   getAllWebContents () {
     return binding.getAllWebContents()
+  },
+
+  createOffscreenRenderPool (options) {
+    if (!features.isOffscreenRenderingEnabled()) {
+      throw new Error('Offscreen rendering is not enabled in this build')
+    }
+    const { OffscreenRenderPool } = require('@electron/internal/browser/offscreen-render-pool')
+    return new OffscreenRenderPool(options)
   }
 }
@@ -13,6 +13,14 @@ const getTempDirectory = function () {
   }
 }
 
+// Whether the crash pipeline uploads the reports, in which case no process
+// uploads them when crashing.
+let crashPipelineEnabled = false
+
+exports.setCrashPipelineEnabled = function (enabled) {
+  crashPipelineEnabled = enabled
+}
+
 exports.crashReporterInit = function (options) {
   const productName = options.productName || app.name
   const crashesDirectory = path.join(getTempDirectory(), `${productName} Crashes`)
@@ -20,6 +28,7 @@ exports.crashReporterInit = function (options) {
   return {
     productName,
     crashesDirectory,
-    appVersion: app.getVersion()
+    appVersion: app.getVersion(),
+    deferUploads: crashPipelineEnabled
   }
 }
@@ -0,0 +1,241 @@
+'use strict'
+
+const { EventEmitter } = require('events')
+
+const defaultOptions = {
+  size: 4,
+  width: 800,
+  height: 600,
+  frameRate: 60,
+  transparent: false,
+  maxQueueSize: 256,
+  timeout: 30000
+}
+
+const formats = ['png', 'bitmap', 'image']
+
+const toURL = function (job) {
+  if (typeof job.url === 'string') return job.url
+  if (typeof job.html === 'string') {
+    return `data:text/html;charset=utf-8,${encodeURIComponent(job.html)}`
+  }
+  throw new Error('Either "html" or "url" must be specified')
+}
+
+// Resolves with the first full frame painted after the page finished loading.
+const waitForFrame = function (webContents) {
+  return new Promise((resolve) => {
+    webContents.once('paint', (event, dirty, image) => resolve(image))
+    webContents.invalidate()
+  })
+}
+
+const convertImage = function (image, format) {
+  switch (format) {
+    case 'png': return image.toPNG()
+    case 'bitmap': return image.toBitmap()
+    default: return image
+  }
+}
+
+// A fixed set of reusable offscreen WebContents fed from a bounded job queue.
+//
+// Every worker is a hidden offscreen BrowserWindow that only paints while it
+// is rendering a job, so idle workers do not subscribe to the shared
+// begin-frame clock. Once |maxQueueSize| jobs are waiting, render() rejects
+// and the caller should wait for the 'drain' event.
+class OffscreenRenderPool extends EventEmitter {
+  constructor (options = {}) {
+    super()
+
+    this._options = { ...defaultOptions, ...options }
+    if (!Number.isInteger(this._options.size) || this._options.size < 1) {
+      throw new Error('"size" must be a positive integer')
+    }
+
+    this._queue = []
+    this._workers = []
+    this._destroyed = false
+    this._saturated = false
+    this._stats = { completed: 0, failed: 0 }
+
+    for (let i = 0; i < this._options.size; i++) {
+      this._workers.push(this._createWorker())
+    }
+  }
+
+  render (job) {
+    if (this._destroyed) {
+      return Promise.reject(new Error('OffscreenRenderPool has been destroyed'))
+    }
+    if (!job || typeof job !== 'object') {
+      return Promise.reject(new Error('Invalid render job'))
+    }
+
+    const format = job.format || 'png'
+    if (!formats.includes(format)) {
+      return Promise.reject(new Error(`Invalid format "${format}"`))
+    }
+
+    let url
+    try {
+      url = toURL(job)
+    } catch (error) {
+      return Promise.reject(error)
+    }
+
+    if (this._queue.length >= this._options.maxQueueSize) {
+      this._saturated = true
+      return Promise.reject(new Error('Render queue is full'))
+    }
+
+    return new Promise((resolve, reject) => {
+      this._queue.push({ ...job, url, format, resolve, reject })
+      this._schedule()
+      if (this._queue.length >= this._options.maxQueueSize) {
+        this._saturated = true
+      }
+    })
+  }
+
+  getStats () {
+    return {
+      size: this._workers.length,
+      busy: this._workers.filter(worker => worker.job !== null).length,
+      queued: this._queue.length,
+      completed: this._stats.completed,
+      failed: this._stats.failed
+    }
+  }
+
+  destroy () {
+    if (this._destroyed) return
+    this._destroyed = true
+
+    const error = new Error('OffscreenRenderPool has been destroyed')
+    for (const job of this._queue.splice(0)) job.reject(error)
+    for (const worker of this._workers) this._destroyWorker(worker, error)
+    this._workers = []
+  }
+
+  isDestroyed () {
+    return this._destroyed
+  }
+
+  _createWorker () {
+    const { BrowserWindow } = require('electron')
+    const { width, height, frameRate, transparent, webPreferences } = this._options
+
+    const window = new BrowserWindow({
+      show: false,
+      width,
+      height,
+      transparent,
+      webPreferences: {
+        ...webPreferences,
+        offscreen: true,
+        backgroundThrottling: false
+      }
+    })
+    window.webContents.frameRate = frameRate
+    window.webContents.stopPainting()
+
+    const worker = { window, job: null }
+    window.webContents.on('crashed', () => {
+      this._replaceWorker(worker, new Error('Render process crashed'))
+    })
+    return worker
+  }
+
+  _destroyWorker (worker, error) {
+    if (worker.job) {
+      worker.job.reject(error)
+      worker.job = null
+    }
+    if (!worker.window.isDestroyed()) worker.window.destroy()
+  }
+
+  _replaceWorker (worker, error) {
+    const index = this._workers.indexOf(worker)
+    if (index === -1) return
+
+    if (worker.job) this._stats.failed++
+    this._destroyWorker(worker, error)
+    this._workers[index] = this._createWorker()
+    this._schedule()
+  }
+
+  _schedule () {
+    for (const worker of this._workers) {
+      if (this._queue.length === 0) break
+      if (worker.job !== null) continue
+
+      worker.job = this._queue.shift()
+      this._run(worker, worker.job)
+    }
+
+    if (this._saturated && this._queue.length < this._options.maxQueueSize) {
+      this._saturated = false
+      this.emit('drain')
+    }
+  }
+
+  async _run (worker, job) {
+    const { window } = worker
+    const { webContents } = window
+    const width = job.width || this._options.width
+    const height = job.height || this._options.height
+    const timeout = job.timeout || this._options.timeout
+
+    let timer
+    let timedOut = false
+    const timeoutPromise = new Promise((resolve, reject) => {
+      timer = setTimeout(() => {
+        timedOut = true
+        reject(new Error('Render job timed out'))
+      }, timeout)
+    })
+
+    let image
+    let error
+    try {
+      const [currentWidth, currentHeight] = window.getSize()
+      if (currentWidth !== width || currentHeight !== height) {
+        window.setSize(width, height)
+      }
+
+      webContents.startPainting()
+      image = await Promise.race([
+        webContents.loadURL(job.url).then(() => waitForFrame(webContents)),
+        timeoutPromise
+      ])
+    } catch (err) {
+      error = err
+    } finally {
+      clearTimeout(timer)
+    }
+
+    // The worker was recycled or the pool destroyed while the job was running.
+    if (worker.job !== job) return
+
+    // A page that did not produce a frame in time is in an unknown state, so
+    // the worker is recycled instead of being reused.
+    if (timedOut) {
+      this._replaceWorker(worker, error)
+      return
+    }
+
+    webContents.stopPainting()
+    worker.job = null
+    if (error) {
+      this._stats.failed++
+      job.reject(error)
+    } else {
+      this._stats.completed++
+      job.resolve(convertImage(image, job.format))
+    }
+    this._schedule()
+  }
+}
+
+module.exports = { OffscreenRenderPool }
@@ -65,6 +65,14 @@ ipcMainUtils.handleSync('ELECTRON_BROWSER_CLIPBOARD', function (event, method, .
   return typeUtils.serialize(electron.clipboard[method](...typeUtils.deserialize(args)))
 })
 
+ipcMainInternal.handle('ELECTRON_BROWSER_CLIPBOARD_ASYNC', async function (event, method, ...args) {
+  if (!allowedClipboardMethods.has(method) || !method.endsWith('Async')) {
+    throw new Error(`Invalid method: ${method}`)
+  }
+
+  return typeUtils.serialize(await electron.clipboard[method](...typeUtils.deserialize(args)))
+})
+
 if (features.isDesktopCapturerEnabled()) {
   const desktopCapturer = require('@electron/internal/browser/desktop-capturer')
 
@@ -3,6 +3,7 @@
 const clipboard = process.electronBinding('clipboard')
 
 if (process.type === 'renderer') {
+  const { ipcRendererInternal } = require('@electron/internal/renderer/ipc-renderer-internal')
   const ipcRendererUtils = require('@electron/internal/renderer/ipc-renderer-internal-utils')
   const typeUtils = require('@electron/internal/common/type-utils')
 
@@ -14,10 +15,18 @@ if (process.type === 'renderer') {
     }
   }
 
+  const makeRemoteAsyncMethod = function (method) {
+    return async (...args) => {
+      args = typeUtils.serialize(args)
+      const result = await ipcRendererInternal.invoke('ELECTRON_BROWSER_CLIPBOARD_ASYNC', method, ...args)
+      return typeUtils.deserialize(result)
+    }
+  }
+
   if (process.platform === 'linux') {
     // On Linux we could not access clipboard in renderer process.
     for (const method of Object.keys(clipboard)) {
-      clipboard[method] = makeRemoteMethod(method)
+      clipboard[method] = method.endsWith('Async') ? makeRemoteAsyncMethod(method) : makeRemoteMethod(method)
     }
   } else if (process.platform === 'darwin') {
     // Read/write to find pasteboard over IPC since only main process is notified of changes
@@ -39,6 +39,7 @@ class CrashReporter {
     if (extra._companyName == null) extra._companyName = companyName
     if (extra._version == null) extra._version = ret.appVersion
 
+    binding.setUploadsDeferred(!!ret.deferUploads)
     binding.start(ret.productName, companyName, submitURL, ret.crashesDirectory, uploadToServer, ignoreSystemCrashHandler, extra)
   }
 
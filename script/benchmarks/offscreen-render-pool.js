@@ -0,0 +1,63 @@
+// Measures OffscreenRenderPool throughput in renders per second.
+//
+// Usage:
+//   out/Testing/electron script/benchmarks/offscreen-render-pool.js \
+//     [--jobs=1000] [--size=8] [--width=640] [--height=480] [--format=png]
+
+const { app, webContents } = require('electron')
+
+const parseArgs = () => {
+  const args = { jobs: 1000, size: 8, width: 640, height: 480, format: 'png' }
+  for (const arg of process.argv.slice(2)) {
+    const match = /^--([^=]+)=(.*)$/.exec(arg)
+    if (!match || !(match[1] in args)) continue
+    args[match[1]] = typeof args[match[1]] === 'number' ? Number(match[2]) : match[2]
+  }
+  return args
+}
+
+const snippet = (i) => `<!doctype html>
+<body style="margin:0;font:24px sans-serif;background:hsl(${i % 360},60%,80%)">
+  <h1>Snippet #${i}</h1>
+  <p>${'lorem ipsum '.repeat(50)}</p>
+</body>`
+
+app.disableHardwareAcceleration()
+
+app.whenReady().then(async () => {
+  const { jobs, size, width, height, format } = parseArgs()
+  const maxQueueSize = size * 4
+  const pool = webContents.createOffscreenRenderPool({ size, width, height, maxQueueSize })
+
+  // Warm up every worker so renderer startup is not counted.
+  await Promise.all(Array.from({ length: size }, (_, i) => pool.render({ html: snippet(i), format })))
+
+  const start = process.hrtime.bigint()
+  let bytes = 0
+  const pending = []
+
+  for (let i = 0; i < jobs; i++) {
+    // Respect the pool's backpressure instead of letting submissions fail.
+    if (pool.getStats().queued >= maxQueueSize) {
+      await new Promise(resolve => pool.once('drain', resolve))
+    }
+    pending.push(pool.render({ html: snippet(i), format }).then((result) => {
+      if (format !== 'image') bytes += result.length
+    }))
+  }
+  await Promise.all(pending)
+
+  const seconds = Number(process.hrtime.bigint() - start) / 1e9
+  const { completed, failed } = pool.getStats()
+  console.log(`pool size:     ${size}`)
+  console.log(`jobs:          ${jobs} (${failed} failed)`)
+  console.log(`elapsed:       ${seconds.toFixed(2)} s`)
+  console.log(`throughput:    ${((completed - size) / seconds).toFixed(1)} renders/sec`)
+  if (bytes) console.log(`output:        ${(bytes / 1024 / 1024).toFixed(1)} MiB`)
+
+  pool.destroy()
+  app.quit()
+}).catch((error) => {
+  console.error(error)
+  app.exit(1)
+})
@@ -0,0 +1,127 @@
+// Reports how long a second instance takes to hand its command line over to
+// the running instance, with and without `earlyHandoff`: the latency until
+// the `second-instance` event is emitted, and until the second instance exits.
+//
+// Usage:
+//   node script/benchmarks/second-instance.js [--runs=10] [--json]
+//
+// Set ELECTRON_OUT_DIR to pick the build, as with `npm start`.
+
+const cp = require('child_process')
+const fs = require('fs')
+const os = require('os')
+const path = require('path')
+
+const READY_LINE = 'SECOND_INSTANCE_READY'
+const RESULT_PREFIX = 'SECOND_INSTANCE '
+
+// Runs inside Electron, both as the primary and as the second instances.
+const runChild = () => {
+  const { app } = require('electron')
+  const earlyHandoff = process.argv.includes('--early-handoff')
+  app.setPath('userData', process.argv[process.argv.length - 1])
+  if (!app.requestSingleInstanceLock({ earlyHandoff })) {
+    app.exit(0)
+    return
+  }
+  app.on('second-instance', () => {
+    console.log(RESULT_PREFIX + Date.now())
+  })
+  app.whenReady().then(() => {
+    console.log(READY_LINE)
+  })
+}
+
+const parseArgs = () => {
+  const args = { runs: 10, json: false }
+  for (const arg of process.argv.slice(2)) {
+    if (arg === '--json') {
+      args.json = true
+      continue
+    }
+    const match = /^--runs=(\d+)$/.exec(arg)
+    if (match) args.runs = Number(match[1])
+  }
+  return args
+}
+
+// Calls |callback| with every line the primary instance prints.
+const watchLines = (child, callback) => {
+  let buffer = ''
+  child.stdout.setEncoding('utf8')
+  child.stdout.on('data', (data) => {
+    buffer += data
+    const lines = buffer.split('\n')
+    buffer = lines.pop()
+    lines.forEach(callback)
+  })
+}
+
+const measure = async (electronPath, earlyHandoff, runs) => {
+  const userDataDir = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-second-instance-'))
+  const args = [__filename, ...(earlyHandoff ? ['--early-handoff'] : []), userDataDir]
+  const primary = cp.spawn(electronPath, args)
+  let onLine = () => {}
+  watchLines(primary, line => onLine(line))
+  const nextLine = (prefix) => new Promise(resolve => {
+    onLine = (line) => { if (line.startsWith(prefix)) resolve(line) }
+  })
+
+  const events = []
+  const exits = []
+  try {
+    await nextLine(READY_LINE)
+    for (let i = 0; i < runs; i++) {
+      const event = nextLine(RESULT_PREFIX)
+      const start = Date.now()
+      const second = cp.spawn(electronPath, args)
+      const exited = new Promise(resolve => second.once('exit', () => resolve(Date.now())))
+      const [line, exitTime] = await Promise.all([event, exited])
+      events.push(Number(line.slice(RESULT_PREFIX.length)) - start)
+      exits.push(exitTime - start)
+    }
+  } finally {
+    primary.kill()
+    fs.rmdirSync(userDataDir, { recursive: true })
+  }
+  return { event: median(events), exit: median(exits) }
+}
+
+const median = (values) => {
+  const sorted = [...values].sort((a, b) => a - b)
+  const middle = Math.floor(sorted.length / 2)
+  return sorted.length % 2 ? sorted[middle] : (sorted[middle - 1] + sorted[middle]) / 2
+}
+
+const main = async () => {
+  const { runs, json } = parseArgs()
+  const electronPath = require('../lib/utils').getAbsoluteElectronExec()
+  if (process.platform === 'win32' || (process.platform === 'linux' && !process.env.XDG_RUNTIME_DIR)) {
+    console.warn('earlyHandoff is not available here, both modes take the regular path')
+  }
+
+  const result = {
+    runs,
+    regular: await measure(electronPath, false, runs),
+    early: await measure(electronPath, true, runs)
+  }
+  if (json) {
+    console.log(JSON.stringify(result, null, 2))
+  } else {
+    console.log(`second instance latency, median of ${runs} runs`)
+    console.log(`  ${'mode'.padEnd(12)}${'event (ms)'.padStart(12)}${'exit (ms)'.padStart(12)}`)
+    for (const mode of ['regular', 'early']) {
+      const { event, exit } = result[mode]
+      console.log(`  ${mode.padEnd(12)}${event.toFixed(1).padStart(12)}${exit.toFixed(1).padStart(12)}`)
+    }
+  }
+}
+
+if (process.versions.electron) {
+  runChild()
+} else {
+  main().catch((error) => {
+    console.error(error)
+    process.exit(1)
+  })
+}
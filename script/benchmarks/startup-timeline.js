@@ -0,0 +1,128 @@
+// Reports the per-phase startup breakdown of the main process and of the first
+// renderer, for cold starts (fresh user data directory) and warm starts
+// (reusing the directory of a previous launch).
+//
+// Usage:
+//   node script/benchmarks/startup-timeline.js [--runs=10] [--json]
+//
+// Set ELECTRON_OUT_DIR to pick the build, as with `npm start`.
+
+const cp = require('child_process')
+const fs = require('fs')
+const os = require('os')
+const path = require('path')
+
+const RESULT_PREFIX = 'STARTUP_TIMELINE '
+
+// Runs inside Electron, reports one launch.
+const runChild = () => {
+  const { app, BrowserWindow } = require('electron')
+  app.setPath('userData', process.argv[process.argv.length - 1])
+  app.whenReady().then(async () => {
+    const w = new BrowserWindow({
+      show: false,
+      webPreferences: { nodeIntegration: true }
+    })
+    const readyToShow = new Promise(resolve => w.once('ready-to-show', resolve))
+    await w.loadURL('data:text/html,<h1>startup</h1>')
+    await readyToShow
+    const renderer = await w.webContents.executeJavaScript('process.getStartupTimeline()')
+    const browser = process.getStartupTimeline()
+    console.log(RESULT_PREFIX + JSON.stringify({ browser, renderer }))
+    app.quit()
+  }).catch((error) => {
+    console.error(error)
+    app.exit(1)
+  })
+}
+
+const parseArgs = () => {
+  const args = { runs: 10, json: false }
+  for (const arg of process.argv.slice(2)) {
+    if (arg === '--json') {
+      args.json = true
+      continue
+    }
+    const match = /^--runs=(\d+)$/.exec(arg)
+    if (match) args.runs = Number(match[1])
+  }
+  return args
+}
+
+const launch = (electronPath, userDataDir) => {
+  const { stdout, status } = cp.spawnSync(electronPath, [__filename, userDataDir], { encoding: 'utf8' })
+  const line = stdout.split('\n').find(line => line.startsWith(RESULT_PREFIX))
+  if (status !== 0 || !line) throw new Error(`launch failed with status ${status}:\n${stdout}`)
+  return JSON.parse(line.slice(RESULT_PREFIX.length))
+}
+
+const median = (values) => {
+  const sorted = [...values].sort((a, b) => a - b)
+  const middle = Math.floor(sorted.length / 2)
+  return sorted.length % 2 ? sorted[middle] : (sorted[middle - 1] + sorted[middle]) / 2
+}
+
+// Returns the median duration of every phase, keyed by process and mark name.
+const summarize = (results) => {
+  const summary = {}
+  for (const processType of ['browser', 'renderer']) {
+    const durations = {}
+    for (const result of results) {
+      for (const { name, duration } of result[processType]) {
+        (durations[name] = durations[name] || []).push(duration)
+      }
+    }
+    summary[processType] = {}
+    for (const name of Object.keys(durations)) {
+      summary[processType][name] = median(durations[name])
+    }
+  }
+  return summary
+}
+
+const print = (cold, warm) => {
+  for (const processType of ['browser', 'renderer']) {
+    console.log(`\n${processType} process          cold (ms)   warm (ms)`)
+    let coldTotal = 0
+    let warmTotal = 0
+    for (const name of Object.keys(cold[processType])) {
+      const coldMs = cold[processType][name]
+      const warmMs = warm[processType][name] || 0
+      coldTotal += coldMs
+      warmTotal += warmMs
+      console.log(`  ${name.padEnd(32)}${coldMs.toFixed(1).padStart(9)}${warmMs.toFixed(1).padStart(12)}`)
+    }
+    console.log(`  ${'total'.padEnd(32)}${coldTotal.toFixed(1).padStart(9)}${warmTotal.toFixed(1).padStart(12)}`)
+  }
+}
+
+const main = () => {
+  const { runs, json } = parseArgs()
+  const electronPath = require('../lib/utils').getAbsoluteElectronExec()
+  const cold = []
+  const warm = []
+
+  for (let i = 0; i < runs; i++) {
+    const userDataDir = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-startup-'))
+    try {
+      cold.push(launch(electronPath, userDataDir))
+      warm.push(launch(electronPath, userDataDir))
+    } finally {
+      fs.rmdirSync(userDataDir, { recursive: true })
+    }
+  }
+
+  const result = { runs, cold: summarize(cold), warm: summarize(warm) }
+  if (json) {
+    console.log(JSON.stringify(result, null, 2))
+  } else {
+    console.log(`startup breakdown, median of ${runs} runs`)
+    print(result.cold, result.warm)
+  }
+}
+
+if (process.versions.electron) {
+  runChild()
+} else {
+  main()
+}
@@ -0,0 +1,112 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/app/browser_snapshot.h"
+
+#include <cstring>
+#include <utility>
+
+#include "base/files/file.h"
+#include "base/files/memory_mapped_file.h"
+#include "base/logging.h"
+#include "base/strings/stringprintf.h"
+#include "gin/v8_initializer.h"
+#include "third_party/zlib/zlib.h"
+#include "v8/include/v8-version.h"
+
+namespace electron {
+
+namespace {
+
+const char kMagic[] = "ELECTRONSNAPSHOT";
+constexpr size_t kMagicSize = sizeof(kMagic) - 1;
+constexpr size_t kVersionOffset = kMagicSize;
+constexpr size_t kVersionSize = 32;
+constexpr size_t kSizeOffset = kVersionOffset + kVersionSize;
+constexpr size_t kChecksumOffset = kSizeOffset + 4;
+
+static_assert(kChecksumOffset + 4 <= kBrowserSnapshotHeaderSize,
+              "the header fields must fit in the header");
+
+uint32_t ReadUint32(const uint8_t* data) {
+  return data[0] | data[1] << 8 | data[2] << 16 |
+         static_cast<uint32_t>(data[3]) << 24;
+}
+
+#if defined(V8_USE_EXTERNAL_STARTUP_DATA)
+bool IsV8SnapshotLoaded() {
+  const char* data = nullptr;
+  int size = 0;
+  gin::V8Initializer::GetV8ExternalSnapshotData(&data, &size);
+  return data != nullptr;
+}
+#endif
+
+}  // namespace
+
+std::string GetBrowserSnapshotV8Version() {
+  return base::StringPrintf("%d.%d.%d.%d", V8_MAJOR_VERSION, V8_MINOR_VERSION,
+                            V8_BUILD_NUMBER, V8_PATCH_LEVEL);
+}
+
+bool ValidateBrowserSnapshot(base::span<const uint8_t> data,
+                             const std::string& v8_version) {
+  if (data.size() < kBrowserSnapshotHeaderSize ||
+      memcmp(data.data(), kMagic, kMagicSize) != 0)
+    return false;
+
+  const char* version =
+      reinterpret_cast<const char*>(data.data() + kVersionOffset);
+  if (v8_version.size() >= kVersionSize ||
+      std::string(version, strnlen(version, kVersionSize)) != v8_version)
+    return false;
+
+  const auto blob = data.subspan(kBrowserSnapshotHeaderSize);
+  if (blob.empty() || blob.size() != ReadUint32(data.data() + kSizeOffset))
+    return false;
+  const uLong checksum = crc32(crc32(0L, Z_NULL, 0), blob.data(), blob.size());
+  return checksum == ReadUint32(data.data() + kChecksumOffset);
+}
+
+bool LoadBrowserSnapshot(const base::FilePath& path) {
+#if defined(V8_USE_EXTERNAL_STARTUP_DATA)
+  base::File file(path, base::File::FLAG_OPEN | base::File::FLAG_READ);
+  if (!file.IsValid())
+    return false;
+
+  // The blob is read twice, but the second time from the page cache, and a
+  // blob V8 can't use would otherwise abort the app.
+  size_t blob_size = 0;
+  {
+    base::MemoryMappedFile mapped_file;
+    if (!mapped_file.Initialize(file.Duplicate()) ||
+        !ValidateBrowserSnapshot(
+            base::make_span(mapped_file.data(), mapped_file.length()),
+            GetBrowserSnapshotV8Version())) {
+      LOG(ERROR) << "Ignoring the browser snapshot " << path.value()
+                 << ", which wasn't built for this version of Electron";
+      return false;
+    }
+    blob_size = mapped_file.length() - kBrowserSnapshotHeaderSize;
+  }
+
+  // gin ignores every snapshot after the first one, so a snapshot loaded by
+  // now would silently win over this one.
+  if (IsV8SnapshotLoaded()) {
+    NOTREACHED() << "A V8 snapshot was loaded before the browser snapshot";
+    return false;
+  }
+
+  base::MemoryMappedFile::Region region = {kBrowserSnapshotHeaderSize,
+                                           blob_size};
+  gin::V8Initializer::LoadV8SnapshotFromFile(
+      std::move(file), &region,
+      gin::V8Initializer::V8SnapshotFileType::kDefault);
+  return IsV8SnapshotLoaded();
+#else
+  return false;
+#endif
+}
+
+}  // namespace electron
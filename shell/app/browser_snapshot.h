@@ -0,0 +1,43 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_APP_BROWSER_SNAPSHOT_H_
+#define SHELL_APP_BROWSER_SNAPSHOT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+
+#include "base/containers/span.h"
+#include "base/files/file_path.h"
+
+namespace electron {
+
+// The snapshot built by the "electron_browser_snapshot" target is the blob
+// written by mksnapshot behind a header of kBrowserSnapshotHeaderSize bytes,
+// written by build/wrap_browser_snapshot.py:
+//   - the magic "ELECTRONSNAPSHOT",
+//   - the version of V8 that built the blob, NUL padded to 32 bytes,
+//   - the size and the CRC-32 of the blob, little-endian uint32s,
+//   - 8 bytes of padding, keeping the blob aligned.
+constexpr size_t kBrowserSnapshotHeaderSize = 64;
+
+// Returns the version of V8 this build needs the snapshots to be built by.
+std::string GetBrowserSnapshotV8Version();
+
+// Returns whether |data| is a complete browser snapshot built for
+// |v8_version|, V8 aborting on blobs it can't use.
+bool ValidateBrowserSnapshot(base::span<const uint8_t> data,
+                             const std::string& v8_version);
+
+// Hands the browser snapshot at |path| to V8, which has to happen before
+// content loads the default snapshot; calling it after a snapshot was loaded
+// is a bug. Returns false, leaving the default snapshot to be used, when the
+// file is missing or isn't valid.
+bool LoadBrowserSnapshot(const base::FilePath& path);
+
+}  // namespace electron
+
+#endif  // SHELL_APP_BROWSER_SNAPSHOT_H_
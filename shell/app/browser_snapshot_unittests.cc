@@ -0,0 +1,121 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/app/browser_snapshot.h"
+
+#include <string>
+#include <vector>
+
+#include "base/files/file.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/test/gtest_util.h"
+#include "gin/v8_initializer.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/zlib/zlib.h"
+
+namespace electron {
+
+namespace {
+
+void AppendUint32(std::vector<uint8_t>* data, uint32_t value) {
+  for (int i = 0; i < 4; ++i)
+    data->push_back(static_cast<uint8_t>(value >> (8 * i)));
+}
+
+// Wraps |blob| like build/wrap_browser_snapshot.py does.
+std::vector<uint8_t> WrapBlob(const std::string& blob,
+                              const std::string& v8_version) {
+  const std::string magic = "ELECTRONSNAPSHOT";
+  std::vector<uint8_t> data(magic.begin(), magic.end());
+  data.insert(data.end(), v8_version.begin(), v8_version.end());
+  data.resize(magic.size() + 32);
+  AppendUint32(&data, blob.size());
+  AppendUint32(&data, crc32(crc32(0L, Z_NULL, 0),
+                            reinterpret_cast<const Bytef*>(blob.data()),
+                            blob.size()));
+  data.resize(kBrowserSnapshotHeaderSize);
+  data.insert(data.end(), blob.begin(), blob.end());
+  return data;
+}
+
+}  // namespace
+
+TEST(BrowserSnapshotTest, AcceptsSnapshotsOfThisVersion) {
+  const std::string version = GetBrowserSnapshotV8Version();
+  EXPECT_TRUE(ValidateBrowserSnapshot(WrapBlob("blob", version), version));
+}
+
+TEST(BrowserSnapshotTest, RejectsInvalidSnapshots) {
+  const std::string version = GetBrowserSnapshotV8Version();
+  const std::vector<uint8_t> valid = WrapBlob("blob", version);
+
+  // Raw mksnapshot output, without the header.
+  const std::string raw = "blob";
+  EXPECT_FALSE(ValidateBrowserSnapshot(
+      std::vector<uint8_t>(raw.begin(), raw.end()), version));
+
+  EXPECT_FALSE(ValidateBrowserSnapshot(WrapBlob("blob", "1.2.3.4"), version));
+  EXPECT_FALSE(ValidateBrowserSnapshot(WrapBlob("", version), version));
+
+  std::vector<uint8_t> corrupt = valid;
+  corrupt.back() ^= 1;
+  EXPECT_FALSE(ValidateBrowserSnapshot(corrupt, version));
+
+  std::vector<uint8_t> truncated(valid.begin(), valid.end() - 1);
+  EXPECT_FALSE(ValidateBrowserSnapshot(truncated, version));
+
+  std::vector<uint8_t> bad_magic = valid;
+  bad_magic[0] = 'X';
+  EXPECT_FALSE(ValidateBrowserSnapshot(bad_magic, version));
+}
+
+TEST(BrowserSnapshotTest, FallsBackOnInvalidFiles) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  const base::FilePath path =
+      temp_dir.GetPath().Append(FILE_PATH_LITERAL("browser_snapshot_blob.bin"));
+
+  // Missing files and mismatched blobs are left to the default snapshot,
+  // instead of being handed to V8 which would abort.
+  EXPECT_FALSE(LoadBrowserSnapshot(path));
+
+  const std::vector<uint8_t> data = WrapBlob("blob", "1.2.3.4");
+  ASSERT_EQ(static_cast<int>(data.size()),
+            base::WriteFile(path, reinterpret_cast<const char*>(data.data()),
+                            data.size()));
+  EXPECT_FALSE(LoadBrowserSnapshot(path));
+}
+
+#if defined(V8_USE_EXTERNAL_STARTUP_DATA)
+TEST(BrowserSnapshotTest, RefusesToLoadAfterAnotherSnapshot) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  const base::FilePath default_path =
+      temp_dir.GetPath().Append(FILE_PATH_LITERAL("snapshot_blob.bin"));
+  const base::FilePath path =
+      temp_dir.GetPath().Append(FILE_PATH_LITERAL("browser_snapshot_blob.bin"));
+  const std::string blob = "blob";
+  ASSERT_EQ(static_cast<int>(blob.size()),
+            base::WriteFile(default_path, blob.data(), blob.size()));
+  const std::vector<uint8_t> data =
+      WrapBlob(blob, GetBrowserSnapshotV8Version());
+  ASSERT_EQ(static_cast<int>(data.size()),
+            base::WriteFile(path, reinterpret_cast<const char*>(data.data()),
+                            data.size()));
+
+  // Stands in for content loading the default snapshot first, after which gin
+  // ignores the browser snapshot.
+  gin::V8Initializer::LoadV8SnapshotFromFile(
+      base::File(default_path, base::File::FLAG_OPEN | base::File::FLAG_READ),
+      nullptr, gin::V8Initializer::V8SnapshotFileType::kDefault);
+#if DCHECK_IS_ON()
+  EXPECT_DCHECK_DEATH(LoadBrowserSnapshot(path));
+#else
+  EXPECT_FALSE(LoadBrowserSnapshot(path));
+#endif
+}
+#endif
+
+}  // namespace electron
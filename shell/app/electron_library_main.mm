@@ -8,6 +8,7 @@
 #include "base/i18n/icu_util.h"
 #include "base/mac/bundle_locations.h"
 #include "base/mac/scoped_nsautorelease_pool.h"
+#include "chrome/browser/process_singleton.h"
 #include "content/public/app/content_main.h"
 #include "shell/app/electron_main_delegate.h"
 #include "shell/app/node_main.h"
@@ -15,11 +16,19 @@
 #include "shell/common/mac/main_application_bundle.h"
 
 int ElectronMain(int argc, char* argv[]) {
+  electron::ElectronCommandLine::Init(argc, argv);
+  {
+    // A second instance only has to hand its command line over, which
+    // doesn't need the browser to be initialized.
+    base::mac::ScopedNSAutoreleasePool pool;
+    if (ProcessSingleton::NotifyOtherProcessEarly(argc, argv))
+      return 0;
+  }
+
   electron::ElectronMainDelegate delegate;
   content::ContentMainParams params(&delegate);
   params.argc = argc;
   params.argv = const_cast<const char**>(argv);
-  electron::ElectronCommandLine::Init(argc, argv);
   return content::ContentMain(params);
 }
 
@@ -29,6 +29,7 @@
 #elif defined(OS_LINUX)  // defined(OS_WIN)
 #include <unistd.h>
 #include <cstdio>
+#include "chrome/browser/process_singleton.h"
 #include "content/public/app/content_main.h"
 #include "shell/app/electron_main_delegate.h"  // NOLINT
 #else                                          // defined(OS_LINUX)
@@ -171,11 +172,16 @@ int main(int argc, char* argv[]) {
   }
 #endif
 
+  electron::ElectronCommandLine::Init(argc, argv);
+  // A second instance only has to hand its command line over, which doesn't
+  // need the browser to be initialized.
+  if (ProcessSingleton::NotifyOtherProcessEarly(argc, argv))
+    return 0;
+
   electron::ElectronMainDelegate delegate;
   content::ContentMainParams params(&delegate);
   params.argc = argc;
   params.argv = const_cast<const char**>(argv);
-  electron::ElectronCommandLine::Init(argc, argv);
   return content::ContentMain(params);
 }
 
@@ -27,12 +27,14 @@
 #include "services/service_manager/embedder/switches.h"
 #include "services/service_manager/sandbox/switches.h"
 #include "services/tracing/public/cpp/stack_sampling/tracing_sampler_profiler.h"
+#include "shell/app/browser_snapshot.h"
 #include "shell/app/electron_content_client.h"
 #include "shell/browser/electron_browser_client.h"
 #include "shell/browser/electron_gpu_client.h"
 #include "shell/browser/feature_list.h"
 #include "shell/browser/relauncher.h"
 #include "shell/common/options_switches.h"
+#include "shell/common/startup_timeline.h"
 #include "shell/renderer/electron_renderer_client.h"
 #include "shell/renderer/electron_sandboxed_renderer_client.h"
 #include "shell/utility/electron_content_utility_client.h"
@@ -86,6 +88,17 @@ bool SubprocessNeedsResourceBundle(const std::string& process_type) {
       process_type == ::switches::kUtilityProcess;
 }
 
+base::FilePath GetResourcesPath() {
+  base::FilePath path;
+#if defined(OS_MACOSX)
+  path =
+      base::mac::FrameworkBundlePath().Append(FILE_PATH_LITERAL("Resources"));
+#else
+  base::PathService::Get(base::DIR_MODULE, &path);
+#endif
+  return path;
+}
+
 #if defined(OS_WIN)
 void InvalidParameterHandler(const wchar_t*,
                              const wchar_t*,
@@ -104,13 +117,7 @@ void LoadResourceBundle(const std::string& locale) {
     ui::ResourceBundle::CleanupSharedInstance();
 
   // Load other resource files.
-  base::FilePath pak_dir;
-#if defined(OS_MACOSX)
-  pak_dir =
-      base::mac::FrameworkBundlePath().Append(FILE_PATH_LITERAL("Resources"));
-#else
-  base::PathService::Get(base::DIR_MODULE, &pak_dir);
-#endif
+  base::FilePath pak_dir = GetResourcesPath();
 
   ui::ResourceBundle::InitSharedInstanceWithLocale(
       locale, nullptr, ui::ResourceBundle::LOAD_COMMON_RESOURCES);
@@ -130,6 +137,7 @@ const size_t ElectronMainDelegate::kNonWildcardDomainNonPortSchemesSize =
     base::size(kNonWildcardDomainNonPortSchemes);
 
 bool ElectronMainDelegate::BasicStartupComplete(int* exit_code) {
+  startup_timeline::AddMark("basic-startup");
   auto* command_line = base::CommandLine::ForCurrentProcess();
 
   logging::LoggingSettings settings;
@@ -269,6 +277,15 @@ void ElectronMainDelegate::PreSandboxStartup() {
   if (!IsBrowserProcess(command_line))
     return;
 
+#if BUILDFLAG(ENABLE_BROWSER_SNAPSHOT)
+  // Only the snapshot shipped in the resources is used, since it runs code in
+  // the main process. Content loads the default snapshot in
+  // InitializeV8IfNeeded, which runs after PreSandboxStartup, so this one is
+  // always the first to be handed to V8.
+  LoadBrowserSnapshot(GetResourcesPath().Append(
+      FILE_PATH_LITERAL("browser_snapshot_blob.bin")));
+#endif
+
   // Allow file:// URIs to read other file:// URIs by default.
   command_line->AppendSwitch(::switches::kAllowFileAccessFromFiles);
 
@@ -4,6 +4,7 @@
 
 #include "shell/browser/api/electron_api_app.h"
 
+#include <map>
 #include <memory>
 
 #include <string>
@@ -49,6 +50,7 @@
 #include "shell/common/gin_converters/gurl_converter.h"
 #include "shell/common/gin_converters/image_converter.h"
 #include "shell/common/gin_converters/net_converter.h"
+#include "shell/common/gin_converters/std_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/object_template_builder.h"
@@ -90,6 +92,102 @@ struct Converter<electron::ProcessIntegrityLevel> {
   }
 };
 
+template <>
+struct Converter<electron::ProcessMemoryInfo> {
+  static v8::Local<v8::Value> ToV8(
+      v8::Isolate* isolate,
+      const electron::ProcessMemoryInfo& memory_info) {
+    gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+    // TODO(zcbenz): Just call SetHidden when this file is converted to gin.
+    gin_helper::Dictionary(isolate, dict.GetHandle()).SetHidden("simple", true);
+    dict.Set("workingSetSize",
+             static_cast<double>(memory_info.working_set_size >> 10));
+    dict.Set("peakWorkingSetSize",
+             static_cast<double>(memory_info.peak_working_set_size >> 10));
+#if defined(OS_WIN) || defined(OS_LINUX)
+    dict.Set("privateBytes",
+             static_cast<double>(memory_info.private_bytes >> 10));
+#endif
+#if defined(OS_LINUX)
+    dict.Set("sharedBytes",
+             static_cast<double>(memory_info.shared_bytes >> 10));
+    if (memory_info.proportional_set_size > 0) {
+      dict.Set("proportionalSetSize",
+               static_cast<double>(memory_info.proportional_set_size >> 10));
+    }
+#endif
+    return dict.GetHandle();
+  }
+};
+
+template <>
+struct Converter<electron::ProcessMetricsSample> {
+  static v8::Local<v8::Value> ToV8(
+      v8::Isolate* isolate,
+      const electron::ProcessMetricsSample& sample) {
+    gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+    gin_helper::Dictionary cpu_dict = gin::Dictionary::CreateEmpty(isolate);
+    // TODO(zcbenz): Just call SetHidden when this file is converted to gin.
+    gin_helper::Dictionary(isolate, dict.GetHandle()).SetHidden("simple", true);
+    gin_helper::Dictionary(isolate, cpu_dict.GetHandle())
+        .SetHidden("simple", true);
+    cpu_dict.Set("percentCPUUsage", sample.percent_cpu_usage);
+    cpu_dict.Set("idleWakeupsPerSecond", sample.idle_wakeups_per_second);
+    dict.Set("pid", sample.pid);
+    dict.Set("type", content::GetProcessTypeNameInEnglish(sample.type));
+    dict.Set("timestamp", sample.time.ToJsTime());
+    dict.Set("cpu", cpu_dict);
+    dict.Set("memory", sample.memory);
+    if (sample.handle_count >= 0)
+      dict.Set("handleCount", sample.handle_count);
+    return dict.GetHandle();
+  }
+};
+
+template <>
+struct Converter<electron::DurationHistogram> {
+  static v8::Local<v8::Value> ToV8(
+      v8::Isolate* isolate,
+      const electron::DurationHistogram& histogram) {
+    std::vector<gin_helper::Dictionary> buckets;
+    for (size_t i = 0; i < histogram.buckets().size(); ++i) {
+      const int64_t lower_bound = electron::DurationHistogram::GetBucketMin(i);
+      gin_helper::Dictionary bucket = gin::Dictionary::CreateEmpty(isolate);
+      bucket.Set("lowerBound", static_cast<double>(lower_bound));
+      bucket.Set("count", static_cast<double>(histogram.buckets()[i]));
+      buckets.push_back(bucket);
+    }
+    gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+    dict.Set("count", static_cast<double>(histogram.count()));
+    dict.Set("sum", histogram.sum().InMillisecondsF());
+    dict.Set("max", histogram.max().InMillisecondsF());
+    dict.Set("buckets", buckets);
+    return dict.GetHandle();
+  }
+};
+
+template <>
+struct Converter<electron::LongTask> {
+  static v8::Local<v8::Value> ToV8(v8::Isolate* isolate,
+                                   const electron::LongTask& task) {
+    gin_helper::Dictionary posted_from = gin::Dictionary::CreateEmpty(isolate);
+    if (task.posted_from.function_name())
+      posted_from.Set("functionName", task.posted_from.function_name());
+    if (task.posted_from.file_name()) {
+      posted_from.Set("fileName", task.posted_from.file_name());
+      posted_from.Set("lineNumber", task.posted_from.line_number());
+    }
+    gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+    dict.Set("startTime", task.start_time.ToJsTime());
+    dict.Set("duration", task.duration.InMillisecondsF());
+    if (task.queueing_delay)
+      dict.Set("queueingDelay", task.queueing_delay->InMillisecondsF());
+    dict.Set("microtaskDuration", task.microtask_duration.InMillisecondsF());
+    dict.Set("postedFrom", posted_from);
+    return dict.GetHandle();
+  }
+};
+
 template <>
 struct Converter<Browser::UserTask> {
   static bool FromV8(v8::Isolate* isolate,
@@ -540,6 +638,7 @@ App::App(v8::Isolate* isolate) {
       ->set_delegate(this);
   Browser::Get()->AddObserver(this);
   content::GpuDataManager::GetInstance()->AddObserver(this);
+  MainThreadMonitor::Get()->AddObserver(this);
 
   base::ProcessId pid = base::GetCurrentProcId();
   auto process_metric = std::make_unique<electron::ProcessMetric>(
@@ -555,6 +654,8 @@ App::~App() {
   Browser::Get()->RemoveObserver(this);
   content::GpuDataManager::GetInstance()->RemoveObserver(this);
   content::BrowserChildProcessObserver::Remove(this);
+  if (auto* monitor = MainThreadMonitor::Get())
+    monitor->RemoveObserver(this);
 }
 
 void App::OnBeforeQuit(bool* prevent_default) {
@@ -807,10 +908,14 @@ void App::ChildProcessLaunched(int process_type, base::ProcessHandle handle) {
 #endif
   app_metrics_[pid] = std::make_unique<electron::ProcessMetric>(
       process_type, handle, std::move(metrics));
+  if (metrics_sampler_)
+    metrics_sampler_->AddProcess(process_type, app_metrics_[pid]->process);
 }
 
 void App::ChildProcessDisconnected(base::ProcessId pid) {
   app_metrics_.erase(pid);
+  if (metrics_sampler_)
+    metrics_sampler_->RemoveProcess(pid);
 }
 
 base::FilePath App::GetAppPath() const {
@@ -947,10 +1052,15 @@ bool App::HasSingleInstanceLock() const {
   return false;
 }
 
-bool App::RequestSingleInstanceLock() {
+bool App::RequestSingleInstanceLock(gin_helper::Arguments* args) {
   if (HasSingleInstanceLock())
     return true;
 
+  bool early_handoff = false;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options))
+    options.Get("earlyHandoff", &early_handoff);
+
   base::FilePath user_dir;
   base::PathService::Get(DIR_USER_DATA, &user_dir);
 
@@ -968,6 +1078,10 @@ bool App::RequestSingleInstanceLock() {
     }
     case ProcessSingleton::NotifyResult::PROCESS_NONE:
     default:  // Shouldn't be needed, but VS warns if it is not there.
+#if defined(OS_POSIX)
+      if (early_handoff)
+        process_singleton_->EnableEarlyNotification();
+#endif
       return true;
   }
 }
@@ -1217,26 +1331,7 @@ std::vector<gin_helper::Dictionary> App::GetAppMetrics(v8::Isolate* isolate) {
     pid_dict.Set("creationTime",
                  process_metric.second->process.CreationTime().ToJsTime());
 
-#if !defined(OS_LINUX)
-    auto memory_info = process_metric.second->GetMemoryInfo();
-
-    gin_helper::Dictionary memory_dict = gin::Dictionary::CreateEmpty(isolate);
-    // TODO(zcbenz): Just call SetHidden when this file is converted to gin.
-    gin_helper::Dictionary(isolate, memory_dict.GetHandle())
-        .SetHidden("simple", true);
-    memory_dict.Set("workingSetSize",
-                    static_cast<double>(memory_info.working_set_size >> 10));
-    memory_dict.Set(
-        "peakWorkingSetSize",
-        static_cast<double>(memory_info.peak_working_set_size >> 10));
-
-#if defined(OS_WIN)
-    memory_dict.Set("privateBytes",
-                    static_cast<double>(memory_info.private_bytes >> 10));
-#endif
-
-    pid_dict.Set("memory", memory_dict);
-#endif
+    pid_dict.Set("memory", process_metric.second->GetMemoryInfo());
 
 #if defined(OS_MACOSX)
     pid_dict.Set("sandboxed", process_metric.second->IsSandboxed());
@@ -1253,6 +1348,111 @@ std::vector<gin_helper::Dictionary> App::GetAppMetrics(v8::Isolate* isolate) {
   return result;
 }
 
+void App::StartMetricsSampling(gin_helper::Arguments* args) {
+  ProcessMetricsSampler::Options options;
+  gin_helper::Dictionary dict;
+  if (args->GetNext(&dict)) {
+    double interval;
+    if (dict.Get("interval", &interval)) {
+      if (interval < 100) {
+        args->ThrowError("interval must be at least 100 milliseconds");
+        return;
+      }
+      options.interval = base::TimeDelta::FromMillisecondsD(interval);
+    }
+
+    int history_size;
+    if (dict.Get("historySize", &history_size)) {
+      if (history_size < 1) {
+        args->ThrowError("historySize must be a positive number");
+        return;
+      }
+      options.history_size = history_size;
+    }
+
+    if (dict.Has("thresholds") &&
+        !dict.Get("thresholds", &options.thresholds)) {
+      args->ThrowError("thresholds must map metric names to numbers");
+      return;
+    }
+    ProcessMetricsSample probe;
+    probe.handle_count = 0;
+    for (const auto& threshold : options.thresholds) {
+      double value;
+      if (!ProcessMetricsSampler::GetMetricValue(probe, threshold.first,
+                                                 &value)) {
+        args->ThrowError("Unsupported metric: " + threshold.first);
+        return;
+      }
+    }
+  }
+
+  metrics_sampler_ = std::make_unique<ProcessMetricsSampler>(
+      options, base::BindRepeating(&App::OnMetricsThresholdExceeded,
+                                   base::Unretained(this)));
+  for (const auto& process_metric : app_metrics_) {
+    metrics_sampler_->AddProcess(process_metric.second->type,
+                                 process_metric.second->process);
+  }
+}
+
+void App::StopMetricsSampling() {
+  metrics_sampler_.reset();
+}
+
+std::vector<ProcessMetricsSample> App::GetMetricsHistory(base::ProcessId pid) {
+  if (!metrics_sampler_)
+    return std::vector<ProcessMetricsSample>();
+  return metrics_sampler_->GetHistory(pid);
+}
+
+std::vector<ProcessMetricsSample> App::GetLatestMetrics() {
+  if (!metrics_sampler_)
+    return std::vector<ProcessMetricsSample>();
+  return metrics_sampler_->GetLatestSamples();
+}
+
+void App::OnMetricsThresholdExceeded(const ProcessMetricsSample& sample,
+                                     const std::string& metric,
+                                     double value,
+                                     double threshold) {
+  Emit("process-metrics-threshold", sample, metric, value, threshold);
+}
+
+v8::Local<v8::Value> App::GetMainThreadMetrics(v8::Isolate* isolate) {
+  auto* monitor = MainThreadMonitor::Get();
+  if (!monitor)
+    return v8::Null(isolate);
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  dict.Set("taskDuration", monitor->task_durations());
+  dict.Set("queueingDelay", monitor->queueing_delays());
+  dict.Set("microtaskDuration", monitor->microtask_durations());
+  dict.Set("longTaskThreshold",
+           monitor->long_task_threshold().InMillisecondsF());
+  dict.Set("longTasks", monitor->GetLongTasks());
+  return dict.GetHandle();
+}
+
+void App::ResetMainThreadMetrics() {
+  if (auto* monitor = MainThreadMonitor::Get())
+    monitor->Reset();
+}
+
+void App::SetLongTaskThreshold(double threshold, gin_helper::Arguments* args) {
+  if (threshold < 1) {
+    args->ThrowError("threshold must be at least 1 millisecond");
+    return;
+  }
+  if (auto* monitor = MainThreadMonitor::Get()) {
+    monitor->set_long_task_threshold(
+        base::TimeDelta::FromMillisecondsD(threshold));
+  }
+}
+
+void App::OnLongTask(const LongTask& task) {
+  Emit("long-task", task);
+}
+
 v8::Local<v8::Value> App::GetGPUFeatureStatus(v8::Isolate* isolate) {
   auto status = content::GetFeatureStatus();
   base::DictionaryValue temp;
@@ -1507,6 +1707,13 @@ void App::BuildPrototype(v8::Isolate* isolate,
                  &App::DisableDomainBlockingFor3DAPIs)
       .SetMethod("getFileIcon", &App::GetFileIcon)
       .SetMethod("getAppMetrics", &App::GetAppMetrics)
+      .SetMethod("startMetricsSampling", &App::StartMetricsSampling)
+      .SetMethod("stopMetricsSampling", &App::StopMetricsSampling)
+      .SetMethod("getMetricsHistory", &App::GetMetricsHistory)
+      .SetMethod("getLatestMetrics", &App::GetLatestMetrics)
+      .SetMethod("getMainThreadMetrics", &App::GetMainThreadMetrics)
+      .SetMethod("resetMainThreadMetrics", &App::ResetMainThreadMetrics)
+      .SetMethod("setLongTaskThreshold", &App::SetLongTaskThreshold)
       .SetMethod("getGPUFeatureStatus", &App::GetGPUFeatureStatus)
       .SetMethod("getGPUInfo", &App::GetGPUInfo)
 #if defined(MAS_BUILD)
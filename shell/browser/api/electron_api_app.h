@@ -22,9 +22,11 @@
 #include "net/base/completion_repeating_callback.h"
 #include "net/ssl/client_cert_identity.h"
 #include "shell/browser/api/process_metric.h"
+#include "shell/browser/api/process_metrics_sampler.h"
 #include "shell/browser/browser.h"
 #include "shell/browser/browser_observer.h"
 #include "shell/browser/electron_browser_client.h"
+#include "shell/browser/main_thread_monitor.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/event_emitter.h"
@@ -50,7 +52,8 @@ class App : public ElectronBrowserClient::Delegate,
             public gin_helper::EventEmitter<App>,
             public BrowserObserver,
             public content::GpuDataManagerObserver,
-            public content::BrowserChildProcessObserver {
+            public content::BrowserChildProcessObserver,
+            public MainThreadMonitor::Observer {
  public:
   using FileIconCallback =
       base::RepeatingCallback<void(v8::Local<v8::Value>, const gfx::Image&)>;
@@ -106,6 +109,9 @@ class App : public ElectronBrowserClient::Delegate,
   void OnNewWindowForTab() override;
 #endif
 
+  // MainThreadMonitor::Observer:
+  void OnLongTask(const LongTask& task) override;
+
   // content::ContentBrowserClient:
   void AllowCertificateError(
       content::WebContents* web_contents,
@@ -174,7 +180,7 @@ class App : public ElectronBrowserClient::Delegate,
   void OnSecondInstance(const base::CommandLine::StringVector& cmd,
                         const base::FilePath& cwd);
   bool HasSingleInstanceLock() const;
-  bool RequestSingleInstanceLock();
+  bool RequestSingleInstanceLock(gin_helper::Arguments* args);
   void ReleaseSingleInstanceLock();
   bool Relaunch(gin_helper::Arguments* args);
   void DisableHardwareAcceleration(gin_helper::ErrorThrower thrower);
@@ -191,6 +197,17 @@ class App : public ElectronBrowserClient::Delegate,
                                      gin_helper::Arguments* args);
 
   std::vector<gin_helper::Dictionary> GetAppMetrics(v8::Isolate* isolate);
+  void StartMetricsSampling(gin_helper::Arguments* args);
+  void StopMetricsSampling();
+  std::vector<ProcessMetricsSample> GetMetricsHistory(base::ProcessId pid);
+  std::vector<ProcessMetricsSample> GetLatestMetrics();
+  void OnMetricsThresholdExceeded(const ProcessMetricsSample& sample,
+                                  const std::string& metric,
+                                  double value,
+                                  double threshold);
+  v8::Local<v8::Value> GetMainThreadMetrics(v8::Isolate* isolate);
+  void ResetMainThreadMetrics();
+  void SetLongTaskThreshold(double threshold, gin_helper::Arguments* args);
   v8::Local<v8::Value> GetGPUFeatureStatus(v8::Isolate* isolate);
   v8::Local<v8::Promise> GetGPUInfo(v8::Isolate* isolate,
                                     const std::string& info_type);
@@ -239,6 +256,8 @@ class App : public ElectronBrowserClient::Delegate,
                          std::unique_ptr<electron::ProcessMetric>>;
   ProcessMetricMap app_metrics_;
 
+  std::unique_ptr<ProcessMetricsSampler> metrics_sampler_;
+
   DISALLOW_COPY_AND_ASSIGN(App);
 };
 
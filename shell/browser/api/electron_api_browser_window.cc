@@ -12,6 +12,7 @@
 #include "content/browser/web_contents/web_contents_impl.h"  // nogncheck
 #include "content/public/browser/render_process_host.h"
 #include "content/public/browser/render_view_host.h"
+#include "shell/browser/api/electron_api_session.h"
 #include "shell/browser/browser.h"
 #include "shell/browser/unresponsive_suppressor.h"
 #include "shell/browser/web_contents_preferences.h"
@@ -23,6 +24,7 @@
 #include "shell/common/gin_helper/object_template_builder.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/options_switches.h"
+#include "shell/common/startup_timeline.h"
 #include "ui/gl/gpu_switching_manager.h"
 
 namespace electron {
@@ -60,7 +62,16 @@ BrowserWindow::BrowserWindow(gin::Arguments* args,
     web_preferences.Set(options::kShow, show);
   }
 
-  if (options.Get("webContents", &web_contents) && !web_contents.IsEmpty()) {
+  bool use_existing_web_contents =
+      options.Get("webContents", &web_contents) && !web_contents.IsEmpty();
+  if (!use_existing_web_contents) {
+    // Use a WebContents whose renderer has already been launched if the
+    // session has a spare one with the same preferences.
+    web_contents = Session::TakeSpareWebContents(isolate, web_preferences);
+    use_existing_web_contents = !web_contents.IsEmpty();
+  }
+
+  if (use_existing_web_contents) {
     // Set webPreferences from options if using an existing webContents.
     // These preferences will be used when the webContent launches new
     // render processes.
@@ -146,6 +157,7 @@ void BrowserWindow::RenderViewCreated(
 }
 
 void BrowserWindow::DidFirstVisuallyNonEmptyPaint() {
+  startup_timeline::AddMark("first-window-paint");
   if (window()->IsVisible())
     return;
 
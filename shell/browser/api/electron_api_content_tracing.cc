@@ -2,13 +2,20 @@
 // Use of this source code is governed by the MIT license that can be
 // found in the LICENSE file.
 
+#include <memory>
 #include <set>
 #include <string>
 #include <utility>
 
+#include "base/files/file.h"
 #include "base/files/file_util.h"
+#include "base/memory/weak_ptr.h"
+#include "base/no_destructor.h"
 #include "base/optional.h"
+#include "base/task/post_task.h"
 #include "base/threading/thread_restrictions.h"
+#include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
 #include "content/public/browser/tracing_controller.h"
 #include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_converters/file_path_converter.h"
@@ -16,7 +23,9 @@
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/promise.h"
 #include "shell/common/node_includes.h"
+#include "third_party/zlib/google/compression_utils.h"
 
+using content::BrowserThread;
 using content::TracingController;
 
 namespace gin {
@@ -55,6 +64,172 @@ struct Converter<base::trace_event::TraceConfig> {
 namespace {
 
 using CompletionCallback = base::OnceCallback<void(const base::FilePath&)>;
+using ChunkCallback = base::RepeatingCallback<void(v8::Local<v8::Value>)>;
+
+// The config of the current recording, used to restart it after
+// streamRecording() has collected its data.
+base::Optional<base::trace_event::TraceConfig>& CurrentTraceConfig() {
+  static base::NoDestructor<base::Optional<base::trace_event::TraceConfig>>
+      config;
+  return *config;
+}
+
+// Owns the promise and the JS callback of a streamRecording() call, and
+// deletes itself once all trace data has been received. Lives on the UI
+// thread.
+class TraceStream {
+ public:
+  TraceStream(gin_helper::Promise<void> promise,
+              ChunkCallback on_chunk,
+              bool restart)
+      : promise_(std::move(promise)),
+        on_chunk_(std::move(on_chunk)),
+        restart_(restart) {}
+
+  void Start(const base::FilePath& path, bool compress);
+
+  void OnChunk(std::unique_ptr<std::string> chunk);
+  void OnFinished(bool success);
+
+ private:
+  gin_helper::Promise<void> promise_;
+  ChunkCallback on_chunk_;
+  bool restart_;
+
+  base::WeakPtrFactory<TraceStream> weak_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(TraceStream);
+};
+
+// Receives the trace data of a TraceStream. Chunks are compressed and written
+// on a background sequence as they arrive, instead of being collected into a
+// file that is read again afterwards.
+class StreamEndpoint : public TracingController::TraceDataEndpoint {
+ public:
+  StreamEndpoint(base::WeakPtr<TraceStream> stream,
+                 const base::FilePath& path,
+                 bool compress,
+                 bool forward_chunks)
+      : stream_(std::move(stream)),
+        path_(path),
+        compress_(compress),
+        forward_chunks_(forward_chunks),
+        task_runner_(base::CreateSequencedTaskRunner(
+            {base::ThreadPool(), base::MayBlock(),
+             base::TaskPriority::USER_VISIBLE})) {}
+
+  // TracingController::TraceDataEndpoint:
+  void ReceiveTraceChunk(std::unique_ptr<std::string> chunk) override {
+    task_runner_->PostTask(FROM_HERE,
+                           base::BindOnce(&StreamEndpoint::WriteChunk, this,
+                                          std::move(chunk)));
+  }
+
+  void ReceivedTraceFinalContents() override {
+    task_runner_->PostTask(FROM_HERE,
+                           base::BindOnce(&StreamEndpoint::Finish, this));
+  }
+
+ private:
+  ~StreamEndpoint() override = default;
+
+  void WriteChunk(std::unique_ptr<std::string> chunk) {
+    if (failed_)
+      return;
+    if (compress_) {
+      // Every chunk is a complete gzip member, so their concatenation is a
+      // valid gzip stream.
+      auto compressed = std::make_unique<std::string>();
+      if (!compression::GzipCompress(*chunk, compressed.get())) {
+        failed_ = true;
+        return;
+      }
+      chunk = std::move(compressed);
+    }
+    if (!path_.empty()) {
+      if (!OpenFile() || file_.WriteAtCurrentPos(chunk->data(),
+                                                 chunk->size()) !=
+                             static_cast<int>(chunk->size())) {
+        failed_ = true;
+        return;
+      }
+    }
+    if (forward_chunks_) {
+      base::PostTask(FROM_HERE, {BrowserThread::UI},
+                     base::BindOnce(&TraceStream::OnChunk, stream_,
+                                    std::move(chunk)));
+    }
+  }
+
+  void Finish() {
+    // Still create the file when no data was recorded.
+    if (!path_.empty() && !failed_ && !OpenFile())
+      failed_ = true;
+    file_.Close();
+    base::PostTask(
+        FROM_HERE, {BrowserThread::UI},
+        base::BindOnce(&TraceStream::OnFinished, stream_, !failed_));
+  }
+
+  bool OpenFile() {
+    if (!file_.IsValid())
+      file_.Initialize(path_,
+                       base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+    return file_.IsValid();
+  }
+
+  base::WeakPtr<TraceStream> stream_;
+  const base::FilePath path_;
+  const bool compress_;
+  const bool forward_chunks_;
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+
+  // Only accessed on |task_runner_|.
+  base::File file_;
+  bool failed_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(StreamEndpoint);
+};
+
+void TraceStream::Start(const base::FilePath& path, bool compress) {
+  auto endpoint = base::MakeRefCounted<StreamEndpoint>(
+      weak_factory_.GetWeakPtr(), path, compress, !on_chunk_.is_null());
+  if (!TracingController::GetInstance()->StopTracing(endpoint)) {
+    promise_.RejectWithErrorMessage("Trace data is not being recorded");
+    delete this;
+  }
+}
+
+void TraceStream::OnChunk(std::unique_ptr<std::string> chunk) {
+  if (chunk->empty())
+    return;
+  v8::Isolate* isolate = promise_.isolate();
+  v8::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+  // The Buffer takes over the chunk instead of copying it.
+  std::string* data = chunk.release();
+  on_chunk_.Run(node::Buffer::New(
+                    isolate, &data->front(), data->size(),
+                    [](char*, void* hint) {
+                      delete static_cast<std::string*>(hint);
+                    },
+                    data)
+                    .ToLocalChecked());
+}
+
+void TraceStream::OnFinished(bool success) {
+  // Restart right away so that a ring buffer only misses the events of the
+  // time it took to collect the data.
+  if (restart_ && CurrentTraceConfig()) {
+    TracingController::GetInstance()->StartTracing(*CurrentTraceConfig(),
+                                                   base::DoNothing());
+  }
+  if (success)
+    promise_.Resolve();
+  else
+    promise_.RejectWithErrorMessage("Failed to write trace data");
+  delete this;
+}
 
 base::Optional<base::FilePath> CreateTemporaryFileOnIO() {
   base::FilePath temp_file_path;
@@ -97,6 +272,35 @@ v8::Local<v8::Promise> StopRecording(gin_helper::Arguments* args) {
   return handle;
 }
 
+v8::Local<v8::Promise> StreamRecording(gin_helper::Arguments* args) {
+  gin_helper::Promise<void> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  gin_helper::Dictionary options;
+  if (!args->GetNext(&options)) {
+    promise.RejectWithErrorMessage("Expected an options object");
+    return handle;
+  }
+  ChunkCallback on_chunk;
+  base::FilePath path;
+  bool compress = false;
+  bool restart = false;
+  options.Get("onChunk", &on_chunk);
+  options.Get("resultFilePath", &path);
+  options.Get("compress", &compress);
+  options.Get("restart", &restart);
+  if (on_chunk.is_null() && path.empty()) {
+    promise.RejectWithErrorMessage(
+        "Either onChunk or resultFilePath must be specified");
+    return handle;
+  }
+
+  auto* stream = new TraceStream(std::move(promise), std::move(on_chunk),
+                                 restart);
+  stream->Start(path, compress);
+  return handle;
+}
+
 v8::Local<v8::Promise> GetCategories(v8::Isolate* isolate) {
   gin_helper::Promise<const std::set<std::string>&> promise(isolate);
   v8::Local<v8::Promise> handle = promise.GetHandle();
@@ -125,6 +329,7 @@ v8::Local<v8::Promise> StartTracing(
     // this point).
     return gin_helper::Promise<void>::ResolvedPromise(isolate);
   }
+  CurrentTraceConfig() = trace_config;
   return handle;
 }
 
@@ -157,6 +362,7 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("getCategories", &GetCategories);
   dict.SetMethod("startRecording", &StartTracing);
   dict.SetMethod("stopRecording", &StopRecording);
+  dict.SetMethod("streamRecording", &StreamRecording);
   dict.SetMethod("getTraceBufferUsage", &GetTraceBufferUsage);
 }
 
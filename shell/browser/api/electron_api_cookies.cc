@@ -4,9 +4,16 @@
 
 #include "shell/browser/api/electron_api_cookies.h"
 
+#include <algorithm>
 #include <memory>
+#include <tuple>
 #include <utility>
 
+#include "base/stl_util.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_util.h"
+#include "base/task/post_task.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "base/time/time.h"
 #include "base/values.h"
 #include "content/public/browser/browser_context.h"
@@ -20,6 +27,7 @@
 #include "net/cookies/cookie_util.h"
 #include "shell/browser/cookie_change_notifier.h"
 #include "shell/browser/electron_browser_context.h"
+#include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_converters/gurl_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
@@ -70,6 +78,63 @@ struct Converter<net::CookieChangeCause> {
   }
 };
 
+template <>
+struct Converter<electron::api::Cookies::QueryResult> {
+  static v8::Local<v8::Value> ToV8(
+      v8::Isolate* isolate,
+      const electron::api::Cookies::QueryResult& val) {
+    gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+    dict.Set("total", static_cast<double>(val.total));
+    if (!val.compact) {
+      dict.Set("cookies", val.cookies);
+      return dict.GetHandle();
+    }
+
+    // Rows of plain values avoid creating an object with nine properties for
+    // every cookie.
+    static constexpr const char* kFields[] = {
+        "name",   "value",    "domain",  "hostOnly",      "path",
+        "secure", "httpOnly", "session", "expirationDate"};
+    std::vector<v8::Local<v8::Value>> rows;
+    rows.reserve(val.cookies.size());
+    for (const auto& cookie : val.cookies) {
+      v8::Local<v8::Value> row[] = {
+          StringToV8(isolate, cookie.Name()),
+          StringToV8(isolate, cookie.Value()),
+          StringToV8(isolate, cookie.Domain()),
+          v8::Boolean::New(
+              isolate, net::cookie_util::DomainIsHostOnly(cookie.Domain())),
+          StringToV8(isolate, cookie.Path()),
+          v8::Boolean::New(isolate, cookie.IsSecure()),
+          v8::Boolean::New(isolate, cookie.IsHttpOnly()),
+          v8::Boolean::New(isolate, !cookie.IsPersistent()),
+          cookie.IsPersistent()
+              ? v8::Number::New(isolate, cookie.ExpiryDate().ToDoubleT())
+                    .As<v8::Value>()
+              : v8::Null(isolate).As<v8::Value>()};
+      static_assert(base::size(row) == base::size(kFields),
+                    "Each row must have a value for every field");
+      rows.push_back(v8::Array::New(isolate, row, base::size(row)));
+    }
+    dict.Set("fields", std::vector<std::string>(std::begin(kFields),
+                                                std::end(kFields)));
+    dict.Set("cookies", v8::Array::New(isolate, rows.data(), rows.size()));
+    return dict.GetHandle();
+  }
+};
+
+template <>
+struct Converter<net::CookieChangeInfo> {
+  static v8::Local<v8::Value> ToV8(v8::Isolate* isolate,
+                                   const net::CookieChangeInfo& val) {
+    gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+    dict.Set("cookie", val.cookie);
+    dict.Set("cause", val.cause);
+    dict.Set("removed", val.cause != net::CookieChangeCause::INSERTED);
+    return dict.GetHandle();
+  }
+};
+
 }  // namespace gin
 
 namespace electron {
@@ -78,65 +143,141 @@ namespace api {
 
 namespace {
 
-// Returns whether |domain| matches |filter|.
-bool MatchesDomain(std::string filter, const std::string& domain) {
-  // Add a leading '.' character to the filter domain if it doesn't exist.
-  if (net::cookie_util::DomainIsHostOnly(filter))
-    filter.insert(0, ".");
+// The filter of cookies.get() and cookies.query(), read once from the JS
+// object instead of looking up its keys again for every cookie.
+struct CookieFilter {
+  base::Optional<std::string> name;
+  base::Optional<std::string> path;
+  // Always starts with a '.' character.
+  base::Optional<std::string> domain;
+  base::Optional<bool> secure;
+  base::Optional<bool> session;
+};
 
-  std::string sub_domain(domain);
-  // Strip any leading '.' character from the input cookie domain.
-  if (!net::cookie_util::DomainIsHostOnly(sub_domain))
-    sub_domain = sub_domain.substr(1);
-
-  // Now check whether the domain argument is a subdomain of the filter domain.
-  for (sub_domain.insert(0, "."); sub_domain.length() >= filter.length();) {
-    if (sub_domain == filter)
-      return true;
-    const size_t next_dot = sub_domain.find('.', 1);  // Skip over leading dot.
-    sub_domain.erase(0, next_dot);
+CookieFilter ParseCookieFilter(const gin_helper::Dictionary& dict) {
+  CookieFilter filter;
+  std::string str;
+  bool flag;
+  if (dict.Get("name", &str))
+    filter.name = str;
+  if (dict.Get("path", &str))
+    filter.path = str;
+  if (dict.Get("domain", &str)) {
+    // Add a leading '.' character to the filter domain if it doesn't exist.
+    if (net::cookie_util::DomainIsHostOnly(str))
+      str.insert(0, ".");
+    filter.domain = str;
   }
-  return false;
+  if (dict.Get("secure", &flag))
+    filter.secure = flag;
+  if (dict.Get("session", &flag))
+    filter.session = flag;
+  return filter;
+}
+
+// Returns whether |domain| matches |filter|, which starts with a '.'.
+bool MatchesDomain(const std::string& filter, const std::string& domain) {
+  base::StringPiece host(domain);
+  // Strip any leading '.' character from the input cookie domain.
+  if (!net::cookie_util::DomainIsHostOnly(domain))
+    host.remove_prefix(1);
+
+  // Now check whether the domain argument is the filter domain or one of its
+  // subdomains, the leading '.' of |filter| makes sure the suffix starts at a
+  // label boundary.
+  if (host.size() + 1 == filter.size())
+    return host == base::StringPiece(filter).substr(1);
+  return base::EndsWith(host, filter, base::CompareCase::SENSITIVE);
 }
 
 // Returns whether |cookie| matches |filter|.
-bool MatchesCookie(const base::Value& filter,
+bool MatchesCookie(const CookieFilter& filter,
                    const net::CanonicalCookie& cookie) {
-  const std::string* str;
-  if ((str = filter.FindStringKey("name")) && *str != cookie.Name())
+  if (filter.name && *filter.name != cookie.Name())
     return false;
-  if ((str = filter.FindStringKey("path")) && *str != cookie.Path())
+  if (filter.path && *filter.path != cookie.Path())
     return false;
-  if ((str = filter.FindStringKey("domain")) &&
-      !MatchesDomain(*str, cookie.Domain()))
+  if (filter.domain && !MatchesDomain(*filter.domain, cookie.Domain()))
     return false;
-  base::Optional<bool> secure_filter = filter.FindBoolKey("secure");
-  if (secure_filter && *secure_filter == cookie.IsSecure())
+  if (filter.secure && *filter.secure == cookie.IsSecure())
     return false;
-  base::Optional<bool> session_filter = filter.FindBoolKey("session");
-  if (session_filter && *session_filter != !cookie.IsPersistent())
+  if (filter.session && *filter.session != !cookie.IsPersistent())
     return false;
   return true;
 }
 
-// Remove cookies from |list| not matching |filter|, and pass it to |callback|.
-void FilterCookies(const base::Value& filter,
-                   gin_helper::Promise<net::CookieList> promise,
-                   const net::CookieList& cookies) {
-  net::CookieList result;
-  for (const auto& cookie : cookies) {
-    if (MatchesCookie(filter, cookie))
-      result.push_back(cookie);
-  }
-  promise.Resolve(result);
+// Removes cookies from |cookies| not matching |filter|, runs on the thread
+// pool.
+net::CookieList FilterCookieList(const CookieFilter& filter,
+                                 net::CookieList cookies) {
+  base::EraseIf(cookies, [&filter](const net::CanonicalCookie& cookie) {
+    return !MatchesCookie(filter, cookie);
+  });
+  return cookies;
 }
 
-void FilterCookieWithStatuses(const base::Value& filter,
-                              gin_helper::Promise<net::CookieList> promise,
-                              const net::CookieStatusList& list,
-                              const net::CookieStatusList& excluded_list) {
-  FilterCookies(filter, std::move(promise),
-                net::cookie_util::StripStatuses(list));
+// Filters |cookies| and returns the requested page of them, runs on the
+// thread pool.
+Cookies::QueryResult QueryCookieList(const CookieFilter& filter,
+                                     size_t offset,
+                                     base::Optional<size_t> limit,
+                                     bool compact,
+                                     net::CookieList cookies) {
+  Cookies::QueryResult result;
+  result.compact = compact;
+  result.cookies = FilterCookieList(filter, std::move(cookies));
+  result.total = result.cookies.size();
+
+  // Sort so that pages are stable as long as the store does not change.
+  std::sort(result.cookies.begin(), result.cookies.end(),
+            [](const net::CanonicalCookie& a, const net::CanonicalCookie& b) {
+              return std::tie(a.Domain(), a.Path(), a.Name()) <
+                     std::tie(b.Domain(), b.Path(), b.Name());
+            });
+
+  offset = std::min(offset, result.cookies.size());
+  size_t end = result.cookies.size();
+  if (limit)
+    end = std::min(end, offset + *limit);
+  result.cookies.erase(result.cookies.begin() + end, result.cookies.end());
+  result.cookies.erase(result.cookies.begin(),
+                       result.cookies.begin() + offset);
+  return result;
+}
+
+// The network service does not support filtering cookies other than by URL,
+// so the filter runs on the thread pool to keep large stores from blocking
+// the UI thread.
+template <typename Result>
+void PostFilterTask(base::OnceCallback<Result(net::CookieList)> task,
+                    gin_helper::Promise<Result> promise,
+                    net::CookieList cookies) {
+  base::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::ThreadPool(), base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(std::move(task), std::move(cookies)),
+      base::BindOnce(
+          [](gin_helper::Promise<Result> promise, Result result) {
+            promise.Resolve(result);
+          },
+          std::move(promise)));
+}
+
+// The cookie manager passes the list by reference, so it is copied once here.
+template <typename Result>
+void PostFilterTaskWithList(base::OnceCallback<Result(net::CookieList)> task,
+                            gin_helper::Promise<Result> promise,
+                            const net::CookieList& cookies) {
+  PostFilterTask(std::move(task), std::move(promise), cookies);
+}
+
+template <typename Result>
+void PostFilterTaskWithStatuses(
+    base::OnceCallback<Result(net::CookieList)> task,
+    gin_helper::Promise<Result> promise,
+    const net::CookieStatusList& list,
+    const net::CookieStatusList& excluded_list) {
+  PostFilterTask(std::move(task), std::move(promise),
+                 net::cookie_util::StripStatuses(list));
 }
 
 // Parse dictionary property to CanonicalCookie time correctly.
@@ -184,22 +325,27 @@ Cookies::Cookies(v8::Isolate* isolate, ElectronBrowserContext* browser_context)
 
 Cookies::~Cookies() = default;
 
-v8::Local<v8::Promise> Cookies::Get(const gin_helper::Dictionary& filter) {
-  gin_helper::Promise<net::CookieList> promise(isolate());
-  v8::Local<v8::Promise> handle = promise.GetHandle();
+Cookies::ChangeSubscription::ChangeSubscription() = default;
+Cookies::ChangeSubscription::~ChangeSubscription() = default;
 
+Cookies::QueryResult::QueryResult() = default;
+Cookies::QueryResult::QueryResult(QueryResult&&) = default;
+Cookies::QueryResult::~QueryResult() = default;
+Cookies::QueryResult& Cookies::QueryResult::operator=(QueryResult&&) = default;
+
+template <typename Result>
+void Cookies::GetCookies(const gin_helper::Dictionary& filter,
+                         base::OnceCallback<Result(net::CookieList)> task,
+                         gin_helper::Promise<Result> promise) {
   auto* storage_partition = content::BrowserContext::GetDefaultStoragePartition(
       browser_context_.get());
   auto* manager = storage_partition->GetCookieManagerForBrowserProcess();
 
-  base::DictionaryValue dict;
-  gin::ConvertFromV8(isolate(), filter.GetHandle(), &dict);
-
   std::string url;
   filter.Get("url", &url);
   if (url.empty()) {
-    manager->GetAllCookies(
-        base::BindOnce(&FilterCookies, std::move(dict), std::move(promise)));
+    manager->GetAllCookies(base::BindOnce(
+        &PostFilterTaskWithList<Result>, std::move(task), std::move(promise)));
   } else {
     net::CookieOptions options;
     options.set_include_httponly();
@@ -207,11 +353,61 @@ v8::Local<v8::Promise> Cookies::Get(const gin_helper::Dictionary& filter) {
         net::CookieOptions::SameSiteCookieContext::SAME_SITE_STRICT);
     options.set_do_not_update_access_time();
 
-    manager->GetCookieList(GURL(url), options,
-                           base::BindOnce(&FilterCookieWithStatuses,
-                                          std::move(dict), std::move(promise)));
+    manager->GetCookieList(
+        GURL(url), options,
+        base::BindOnce(&PostFilterTaskWithStatuses<Result>, std::move(task),
+                       std::move(promise)));
   }
+}
 
+v8::Local<v8::Promise> Cookies::Get(const gin_helper::Dictionary& filter) {
+  gin_helper::Promise<net::CookieList> promise(isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  GetCookies(filter,
+             base::BindOnce(&FilterCookieList, ParseCookieFilter(filter)),
+             std::move(promise));
+  return handle;
+}
+
+v8::Local<v8::Promise> Cookies::Query(const gin_helper::Dictionary& filter,
+                                      gin::Arguments* args) {
+  gin_helper::Promise<QueryResult> promise(isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  gin_helper::Dictionary options;
+  if (!args->GetNext(&options))
+    options = gin::Dictionary::CreateEmpty(isolate());
+
+  double offset = 0;
+  if (options.Get("offset", &offset) && !(offset >= 0)) {
+    promise.RejectWithErrorMessage("offset must be a non-negative number");
+    return handle;
+  }
+  base::Optional<size_t> limit;
+  double limit_value;
+  if (options.Get("limit", &limit_value)) {
+    if (!(limit_value >= 0)) {
+      promise.RejectWithErrorMessage("limit must be a non-negative number");
+      return handle;
+    }
+    limit = static_cast<size_t>(
+        std::min(limit_value, static_cast<double>(SIZE_MAX / 2)));
+  }
+  std::string format = "objects";
+  options.Get("format", &format);
+  if (format != "objects" && format != "compact") {
+    promise.RejectWithErrorMessage(
+        "format must be either 'objects' or 'compact'");
+    return handle;
+  }
+
+  GetCookies(filter,
+             base::BindOnce(&QueryCookieList, ParseCookieFilter(filter),
+                            static_cast<size_t>(std::min(
+                                offset, static_cast<double>(SIZE_MAX / 2))),
+                            limit, format == "compact"),
+             std::move(promise));
   return handle;
 }
 
@@ -313,7 +509,83 @@ v8::Local<v8::Promise> Cookies::FlushStore() {
   return handle;
 }
 
+int32_t Cookies::SubscribeChanges(gin::Arguments* args) {
+  auto subscription = std::make_unique<ChangeSubscription>();
+  gin_helper::Dictionary options;
+  if (!args->GetNext(&options) || !args->GetNext(&subscription->callback)) {
+    args->ThrowTypeError("Expected options and a callback");
+    return 0;
+  }
+
+  std::vector<std::string> domains;
+  if (options.Get("domains", &domains)) {
+    for (auto& domain : domains) {
+      // Add a leading '.' character to the filter domain if it doesn't exist.
+      if (net::cookie_util::DomainIsHostOnly(domain))
+        domain.insert(0, ".");
+    }
+    subscription->domains = std::move(domains);
+  }
+  double delay = 0;
+  if (options.Get("delay", &delay)) {
+    if (!(delay >= 0)) {
+      args->ThrowTypeError("delay must be a non-negative number");
+      return 0;
+    }
+    subscription->delay = base::TimeDelta::FromMillisecondsD(delay);
+  }
+
+  int32_t id = ++next_subscription_id_;
+  change_subscriptions_[id] = std::move(subscription);
+  return id;
+}
+
+void Cookies::UnsubscribeChanges(int32_t id) {
+  change_subscriptions_.erase(id);
+}
+
+void Cookies::FlushChanges(int32_t id) {
+  auto it = change_subscriptions_.find(id);
+  if (it == change_subscriptions_.end())
+    return;
+
+  // The callback may unsubscribe, so take the changes out first.
+  ChangesCallback callback = it->second->callback;
+  std::vector<net::CookieChangeInfo> changes;
+  changes.swap(it->second->pending);
+
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  callback.Run(gin::ConvertToV8(isolate(), changes));
+}
+
+void Cookies::SetChangedListenersCount(int32_t count) {
+  changed_listener_count_ = count;
+}
+
 void Cookies::OnCookieChanged(const net::CookieChangeInfo& change) {
+  for (auto& it : change_subscriptions_) {
+    ChangeSubscription* subscription = it.second.get();
+    if (!subscription->domains.empty() &&
+        std::none_of(subscription->domains.begin(),
+                     subscription->domains.end(),
+                     [&change](const std::string& domain) {
+                       return MatchesDomain(domain, change.cookie.Domain());
+                     }))
+      continue;
+
+    if (subscription->pending.empty()) {
+      base::ThreadTaskRunnerHandle::Get()->PostDelayedTask(
+          FROM_HERE,
+          base::BindOnce(&Cookies::FlushChanges,
+                         weak_ptr_factory_.GetWeakPtr(), it.first),
+          subscription->delay);
+    }
+    subscription->pending.push_back(change);
+  }
+
+  if (changed_listener_count_ == 0)
+    return;
   Emit("changed", gin::ConvertToV8(isolate(), change.cookie),
        gin::ConvertToV8(isolate(), change.cause),
        gin::ConvertToV8(isolate(),
@@ -332,9 +604,14 @@ void Cookies::BuildPrototype(v8::Isolate* isolate,
   prototype->SetClassName(gin::StringToV8(isolate, "Cookies"));
   gin_helper::ObjectTemplateBuilder(isolate, prototype->PrototypeTemplate())
       .SetMethod("get", &Cookies::Get)
+      .SetMethod("query", &Cookies::Query)
       .SetMethod("remove", &Cookies::Remove)
       .SetMethod("set", &Cookies::Set)
-      .SetMethod("flushStore", &Cookies::FlushStore);
+      .SetMethod("flushStore", &Cookies::FlushStore)
+      .SetMethod("subscribeChanges", &Cookies::SubscribeChanges)
+      .SetMethod("unsubscribeChanges", &Cookies::UnsubscribeChanges)
+      .SetMethod("_setChangedListenersCount",
+                 &Cookies::SetChangedListenersCount);
 }
 
 }  // namespace api
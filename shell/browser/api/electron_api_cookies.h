@@ -5,10 +5,15 @@
 #ifndef SHELL_BROWSER_API_ELECTRON_API_COOKIES_H_
 #define SHELL_BROWSER_API_ELECTRON_API_COOKIES_H_
 
+#include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/callback_list.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "gin/arguments.h"
 #include "gin/handle.h"
 #include "net/cookies/canonical_cookie.h"
 #include "net/cookies/cookie_change_dispatcher.h"
@@ -35,6 +40,22 @@ namespace api {
 
 class Cookies : public gin_helper::TrackableObject<Cookies> {
  public:
+  // A page of the cookies matching the filter of cookies.query().
+  struct QueryResult {
+    QueryResult();
+    QueryResult(QueryResult&&);
+    ~QueryResult();
+    QueryResult& operator=(QueryResult&&);
+
+    net::CookieList cookies;
+    // Number of matching cookies before paging.
+    size_t total = 0;
+    // Whether the cookies are converted to arrays instead of objects.
+    bool compact = false;
+
+    DISALLOW_COPY_AND_ASSIGN(QueryResult);
+  };
+
   static gin::Handle<Cookies> Create(v8::Isolate* isolate,
                                      ElectronBrowserContext* browser_context);
 
@@ -47,19 +68,61 @@ class Cookies : public gin_helper::TrackableObject<Cookies> {
   ~Cookies() override;
 
   v8::Local<v8::Promise> Get(const gin_helper::Dictionary& filter);
+  v8::Local<v8::Promise> Query(const gin_helper::Dictionary& filter,
+                               gin::Arguments* args);
   v8::Local<v8::Promise> Set(base::DictionaryValue details);
   v8::Local<v8::Promise> Remove(const GURL& url, const std::string& name);
   v8::Local<v8::Promise> FlushStore();
+  int32_t SubscribeChanges(gin::Arguments* args);
+  void UnsubscribeChanges(int32_t id);
+  void SetChangedListenersCount(int32_t count);
 
   // CookieChangeNotifier subscription:
   void OnCookieChanged(const net::CookieChangeInfo& change);
 
  private:
+  // Fetches the cookies of the filter's url, or all cookies, and resolves
+  // |promise| with the result of running |task| on them.
+  template <typename Result>
+  void GetCookies(const gin_helper::Dictionary& filter,
+                  base::OnceCallback<Result(net::CookieList)> task,
+                  gin_helper::Promise<Result> promise);
+
+  using ChangesCallback = base::RepeatingCallback<void(v8::Local<v8::Value>)>;
+
+  // A listener added with subscribeChanges(), which receives the changes of
+  // a task or time window at once.
+  struct ChangeSubscription {
+    ChangeSubscription();
+    ~ChangeSubscription();
+
+    // Domains with a leading '.', changes of other domains are dropped before
+    // they are converted. Empty if the subscription has no domain filter.
+    std::vector<std::string> domains;
+    // How long changes are collected after the first one, zero to deliver
+    // them once the current task has finished.
+    base::TimeDelta delay;
+    ChangesCallback callback;
+    std::vector<net::CookieChangeInfo> pending;
+  };
+
+  // Delivers the pending changes of the subscription |id|.
+  void FlushChanges(int32_t id);
+
+
   std::unique_ptr<base::CallbackList<void(
       const net::CookieChangeInfo& change)>::Subscription>
       cookie_change_subscription_;
   scoped_refptr<ElectronBrowserContext> browser_context_;
 
+  std::map<int32_t, std::unique_ptr<ChangeSubscription>> change_subscriptions_;
+  int32_t next_subscription_id_ = 0;
+  // Number of JS listeners of the "changed" event, kept up to date by
+  // lib/browser/api/session.js. Changes are only converted while it is set.
+  int32_t changed_listener_count_ = 0;
+
+  base::WeakPtrFactory<Cookies> weak_ptr_factory_{this};
+
   DISALLOW_COPY_AND_ASSIGN(Cookies);
 };
 
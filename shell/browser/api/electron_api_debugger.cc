@@ -7,9 +7,12 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/json/json_reader.h"
 #include "base/json/json_writer.h"
+#include "base/stl_util.h"
+#include "base/strings/string_util.h"
 #include "content/public/browser/devtools_agent_host.h"
 #include "content/public/browser/web_contents.h"
 #include "shell/common/gin_converters/value_converter.h"
@@ -23,6 +26,70 @@ namespace electron {
 
 namespace api {
 
+namespace {
+
+// Returns the position after the JSON string starting at |begin|, or npos if
+// the string is not terminated.
+size_t SkipString(base::StringPiece json, size_t begin) {
+  for (size_t i = begin + 1; i < json.size(); ++i) {
+    if (json[i] == '\\')
+      ++i;
+    else if (json[i] == '"')
+      return i + 1;
+  }
+  return base::StringPiece::npos;
+}
+
+// Finds the method of a CDP event without parsing the message, so events that
+// are filtered out or passed on raw are never turned into a base::Value.
+// Returns false for command responses, which have an "id" instead.
+bool GetEventMethod(base::StringPiece json, base::StringPiece* method) {
+  int depth = 0;
+  bool expect_key = false;
+  for (size_t i = 0; i < json.size();) {
+    char c = json[i];
+    if (c == '"') {
+      size_t end = SkipString(json, i);
+      if (end == base::StringPiece::npos)
+        return false;
+      if (depth == 1 && expect_key) {
+        expect_key = false;
+        base::StringPiece key = json.substr(i + 1, end - i - 2);
+        if (key == "id")
+          return false;
+        if (key == "method") {
+          // Method names never contain escaped characters.
+          base::StringPiece rest = base::TrimWhitespaceASCII(
+              json.substr(end), base::TRIM_LEADING);
+          if (!base::StartsWith(rest, ":", base::CompareCase::SENSITIVE))
+            return false;
+          rest = base::TrimWhitespaceASCII(rest.substr(1), base::TRIM_LEADING);
+          size_t close = rest.find_first_of("\"\\", 1);
+          if (!base::StartsWith(rest, "\"", base::CompareCase::SENSITIVE) ||
+              close == base::StringPiece::npos || rest[close] != '"')
+            return false;
+          *method = rest.substr(1, close - 1);
+          return true;
+        }
+      }
+      i = end;
+      continue;
+    }
+    if (c == '{' || c == '[') {
+      if (++depth == 1)
+        expect_key = true;
+    } else if (c == '}' || c == ']') {
+      --depth;
+    } else if (c == ',' && depth == 1) {
+      expect_key = true;
+    }
+    ++i;
+  }
+  return false;
+}
+
+}  // namespace
+
 Debugger::Debugger(v8::Isolate* isolate, content::WebContents* web_contents)
     : content::WebContentsObserver(web_contents), web_contents_(web_contents) {
   Init(isolate);
@@ -46,6 +113,23 @@ void Debugger::DispatchProtocolMessage(DevToolsAgentHost* agent_host,
 
   base::StringPiece message_str(reinterpret_cast<const char*>(message.data()),
                                 message.size());
+  base::StringPiece event_method;
+  if (GetEventMethod(message_str, &event_method)) {
+    if (!ShouldEmitEvent(event_method))
+      return;
+    if (message_format_ == MessageFormat::kBuffer) {
+      Emit("raw-message", event_method,
+           node::Buffer::Copy(isolate(), message_str.data(),
+                              message_str.size())
+               .ToLocalChecked());
+      return;
+    }
+    if (message_format_ == MessageFormat::kJSON) {
+      Emit("raw-message", event_method, message_str);
+      return;
+    }
+  }
+
   std::unique_ptr<base::Value> parsed_message =
       base::JSONReader::ReadDeprecated(message_str,
                                        base::JSON_REPLACE_INVALID_CHARACTERS);
@@ -166,6 +250,49 @@ v8::Local<v8::Promise> Debugger::SendCommand(gin_helper::Arguments* args) {
   return handle;
 }
 
+void Debugger::SetMessageOptions(gin_helper::Arguments* args) {
+  gin_helper::Dictionary options;
+  if (!args->GetNext(&options)) {
+    args->ThrowError("Expected an options object");
+    return;
+  }
+
+  MessageFormat format = MessageFormat::kObject;
+  std::string format_name;
+  if (options.Get("format", &format_name)) {
+    if (format_name == "json") {
+      format = MessageFormat::kJSON;
+    } else if (format_name == "buffer") {
+      format = MessageFormat::kBuffer;
+    } else if (format_name != "object") {
+      args->ThrowError("format must be one of 'object', 'json' or 'buffer'");
+      return;
+    }
+  }
+
+  std::vector<std::string> methods;
+  options.Get("methods", &methods);
+  event_methods_.clear();
+  event_domains_.clear();
+  for (const auto& method : methods) {
+    // "Domain.*" matches all events of a domain.
+    if (base::EndsWith(method, ".*", base::CompareCase::SENSITIVE))
+      event_domains_.insert(method.substr(0, method.size() - 2));
+    else
+      event_methods_.insert(method);
+  }
+  message_format_ = format;
+}
+
+bool Debugger::ShouldEmitEvent(base::StringPiece method) const {
+  if (event_methods_.empty() && event_domains_.empty())
+    return true;
+  if (base::Contains(event_methods_, method.as_string()))
+    return true;
+  return base::Contains(event_domains_,
+                        method.substr(0, method.find('.')).as_string());
+}
+
 void Debugger::ClearPendingRequests() {
   for (auto& it : pending_requests_)
     it.second.RejectWithErrorMessage("target closed while handling command");
@@ -185,7 +312,8 @@ void Debugger::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("attach", &Debugger::Attach)
       .SetMethod("isAttached", &Debugger::IsAttached)
       .SetMethod("detach", &Debugger::Detach)
-      .SetMethod("sendCommand", &Debugger::SendCommand);
+      .SetMethod("sendCommand", &Debugger::SendCommand)
+      .SetMethod("setMessageOptions", &Debugger::SetMessageOptions);
 }
 
 }  // namespace api
@@ -6,6 +6,7 @@
 #define SHELL_BROWSER_API_ELECTRON_API_DEBUGGER_H_
 
 #include <map>
+#include <set>
 #include <string>
 
 #include "base/callback.h"
@@ -53,18 +54,34 @@ class Debugger : public gin_helper::TrackableObject<Debugger>,
   using PendingRequestMap =
       std::map<int, gin_helper::Promise<base::DictionaryValue>>;
 
+  // How events are passed to JS.
+  enum class MessageFormat {
+    kObject,  // 'message' with the parsed params.
+    kJSON,    // 'raw-message' with the message as a string.
+    kBuffer,  // 'raw-message' with the message as a Buffer.
+  };
+
   void Attach(gin_helper::Arguments* args);
   bool IsAttached();
   void Detach();
   v8::Local<v8::Promise> SendCommand(gin_helper::Arguments* args);
+  void SetMessageOptions(gin_helper::Arguments* args);
   void ClearPendingRequests();
 
+  // Whether the event |method| passes the filter of SetMessageOptions.
+  bool ShouldEmitEvent(base::StringPiece method) const;
+
   content::WebContents* web_contents_;  // Weak Reference.
   scoped_refptr<content::DevToolsAgentHost> agent_host_;
 
   PendingRequestMap pending_requests_;
   int previous_request_id_ = 0;
 
+  // Events that are emitted, all events if both are empty.
+  std::set<std::string> event_methods_;
+  std::set<std::string> event_domains_;
+  MessageFormat message_format_ = MessageFormat::kObject;
+
   DISALLOW_COPY_AND_ASSIGN(Debugger);
 };
 
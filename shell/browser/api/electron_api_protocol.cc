@@ -4,6 +4,7 @@
 
 #include "shell/browser/api/electron_api_protocol.h"
 
+#include <map>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -13,7 +14,10 @@
 #include "shell/browser/browser.h"
 #include "shell/browser/electron_browser_context.h"
 #include "shell/common/gin_converters/callback_converter.h"
+#include "shell/common/gin_converters/file_path_converter.h"
+#include "shell/common/gin_converters/gurl_converter.h"
 #include "shell/common/gin_converters/net_converter.h"
+#include "shell/common/gin_converters/std_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/object_template_builder.h"
 #include "shell/common/gin_helper/promise.h"
@@ -69,6 +73,49 @@ struct Converter<CustomScheme> {
   }
 };
 
+template <>
+struct Converter<electron::StaticProtocolOptions> {
+  static bool FromV8(v8::Isolate* isolate,
+                     v8::Local<v8::Value> val,
+                     electron::StaticProtocolOptions* out) {
+    gin::Dictionary dict(isolate);
+    if (!ConvertFromV8(isolate, val, &dict))
+      return false;
+    if (!dict.Get("root", &out->root) || !out->root.IsAbsolute())
+      return false;
+    dict.Get("rewrites", &out->rewrites);
+    std::map<std::string, std::string> headers;
+    if (dict.Get("headers", &headers))
+      out->headers.assign(headers.begin(), headers.end());
+    return true;
+  }
+};
+
+template <>
+struct Converter<electron::ProtocolResponseCache::Options> {
+  static bool FromV8(v8::Isolate* isolate,
+                     v8::Local<v8::Value> val,
+                     electron::ProtocolResponseCache::Options* out) {
+    gin::Dictionary dict(isolate);
+    if (!ConvertFromV8(isolate, val, &dict))
+      return false;
+    double max_size;
+    if (dict.Get("maxSize", &max_size)) {
+      if (max_size <= 0)
+        return false;
+      out->max_size = static_cast<size_t>(max_size);
+    }
+    double max_age;
+    if (dict.Get("maxAge", &max_age)) {
+      if (max_age <= 0)
+        return false;
+      out->max_age = base::TimeDelta::FromSecondsD(max_age);
+    }
+    dict.Get("varyHeaders", &out->vary_headers);
+    return true;
+  }
+};
+
 }  // namespace gin
 
 namespace electron {
@@ -172,27 +219,113 @@ void Protocol::RegisterURLLoaderFactories(
     content::ContentBrowserClient::NonNetworkURLLoaderFactoryMap* factories) {
   for (const auto& it : handlers_) {
     factories->emplace(it.first, std::make_unique<ElectronURLLoaderFactory>(
-                                     it.second.first, it.second.second));
+                                     it.second.first, it.second.second,
+                                     caches_[it.first]));
+  }
+  for (const auto& it : static_handlers_) {
+    factories->emplace(it.first,
+                       std::make_unique<StaticURLLoaderFactory>(it.second));
   }
 }
 
 ProtocolError Protocol::RegisterProtocol(ProtocolType type,
                                          const std::string& scheme,
                                          const ProtocolHandler& handler) {
+  if (base::Contains(static_handlers_, scheme))
+    return ProtocolError::REGISTERED;
   const bool added = base::TryEmplace(handlers_, scheme, type, handler).second;
-  return added ? ProtocolError::OK : ProtocolError::REGISTERED;
+  if (!added)
+    return ProtocolError::REGISTERED;
+  caches_[scheme] = base::MakeRefCounted<ProtocolResponseCache>();
+  return ProtocolError::OK;
 }
 
 void Protocol::UnregisterProtocol(const std::string& scheme,
                                   gin::Arguments* args) {
-  const bool removed = handlers_.erase(scheme) != 0;
+  const bool removed =
+      handlers_.erase(scheme) != 0 || static_handlers_.erase(scheme) != 0;
+  // Factories of loaded pages keep the cache, which must not serve responses
+  // of the unregistered handler.
+  auto cache = caches_.find(scheme);
+  if (cache != caches_.end()) {
+    cache->second->Disable();
+    caches_.erase(cache);
+  }
   const auto error =
       removed ? ProtocolError::OK : ProtocolError::NOT_REGISTERED;
   HandleOptionalCallback(args, error);
 }
 
 bool Protocol::IsProtocolRegistered(const std::string& scheme) {
-  return base::Contains(handlers_, scheme);
+  return base::Contains(handlers_, scheme) ||
+         base::Contains(static_handlers_, scheme);
+}
+
+bool Protocol::RegisterStaticProtocol(gin_helper::ErrorThrower thrower,
+                                      const std::string& scheme,
+                                      v8::Local<v8::Value> val) {
+  StaticProtocolOptions options;
+  if (!gin::ConvertFromV8(thrower.isolate(), val, &options)) {
+    thrower.ThrowError("The 'root' option must be an absolute path");
+    return false;
+  }
+  if (IsProtocolRegistered(scheme))
+    return false;
+  static_handlers_.emplace(scheme, options);
+  return true;
+}
+
+bool Protocol::EnableResponseCache(gin_helper::ErrorThrower thrower,
+                                   const std::string& scheme,
+                                   gin::Arguments* args) {
+  ProtocolResponseCache::Options options;
+  v8::Local<v8::Value> val;
+  if (args->GetNext(&val) && !val->IsUndefined() &&
+      !gin::ConvertFromV8(args->isolate(), val, &options)) {
+    thrower.ThrowError(
+        "The 'maxSize' and 'maxAge' options must be positive numbers");
+    return false;
+  }
+  auto it = caches_.find(scheme);
+  if (it == caches_.end())
+    return false;
+  it->second->Enable(options);
+  return true;
+}
+
+bool Protocol::DisableResponseCache(const std::string& scheme) {
+  auto it = caches_.find(scheme);
+  if (it == caches_.end() || !it->second->enabled())
+    return false;
+  it->second->Disable();
+  return true;
+}
+
+bool Protocol::InvalidateResponseCache(const std::string& scheme,
+                                       gin::Arguments* args) {
+  auto it = caches_.find(scheme);
+  if (it == caches_.end() || !it->second->enabled())
+    return false;
+  GURL url;
+  if (args->GetNext(&url))
+    it->second->Invalidate(url);
+  else
+    it->second->Clear();
+  return true;
+}
+
+v8::Local<v8::Value> Protocol::GetResponseCacheInfo(
+    const std::string& scheme) {
+  auto it = caches_.find(scheme);
+  if (it == caches_.end() || !it->second->enabled())
+    return v8::Null(isolate());
+  const ProtocolResponseCache& cache = *it->second;
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate());
+  dict.Set("entries", static_cast<double>(cache.entry_count()));
+  dict.Set("size", static_cast<double>(cache.size()));
+  dict.Set("hits", static_cast<double>(cache.hits()));
+  dict.Set("misses", static_cast<double>(cache.misses()));
+  return dict.GetHandle();
 }
 
 ProtocolError Protocol::InterceptProtocol(ProtocolType type,
@@ -277,9 +410,14 @@ void Protocol::BuildPrototype(v8::Isolate* isolate,
                  &Protocol::RegisterProtocolFor<ProtocolType::kStream>)
       .SetMethod("registerProtocol",
                  &Protocol::RegisterProtocolFor<ProtocolType::kFree>)
+      .SetMethod("registerStaticProtocol", &Protocol::RegisterStaticProtocol)
       .SetMethod("unregisterProtocol", &Protocol::UnregisterProtocol)
       .SetMethod("isProtocolRegistered", &Protocol::IsProtocolRegistered)
       .SetMethod("isProtocolHandled", &Protocol::IsProtocolHandled)
+      .SetMethod("enableResponseCache", &Protocol::EnableResponseCache)
+      .SetMethod("disableResponseCache", &Protocol::DisableResponseCache)
+      .SetMethod("invalidateResponseCache", &Protocol::InvalidateResponseCache)
+      .SetMethod("getResponseCacheInfo", &Protocol::GetResponseCacheInfo)
       .SetMethod("interceptStringProtocol",
                  &Protocol::InterceptProtocolFor<ProtocolType::kString>)
       .SetMethod("interceptBufferProtocol",
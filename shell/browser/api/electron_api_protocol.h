@@ -5,12 +5,15 @@
 #ifndef SHELL_BROWSER_API_ELECTRON_API_PROTOCOL_H_
 #define SHELL_BROWSER_API_ELECTRON_API_PROTOCOL_H_
 
+#include <map>
 #include <string>
 #include <vector>
 
 #include "content/public/browser/content_browser_client.h"
 #include "gin/handle.h"
 #include "shell/browser/net/electron_url_loader_factory.h"
+#include "shell/browser/net/protocol_response_cache.h"
+#include "shell/browser/net/static_url_loader_factory.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/trackable_object.h"
 
@@ -64,6 +67,20 @@ class Protocol : public gin_helper::TrackableObject<Protocol> {
   void UnregisterProtocol(const std::string& scheme, gin::Arguments* args);
   bool IsProtocolRegistered(const std::string& scheme);
 
+  // Registers a protocol that is served without calling into JS.
+  bool RegisterStaticProtocol(gin_helper::ErrorThrower thrower,
+                              const std::string& scheme,
+                              v8::Local<v8::Value> val);
+
+  // Response cache of protocols registered with the register*Protocol APIs.
+  bool EnableResponseCache(gin_helper::ErrorThrower thrower,
+                           const std::string& scheme,
+                           gin::Arguments* args);
+  bool DisableResponseCache(const std::string& scheme);
+  bool InvalidateResponseCache(const std::string& scheme,
+                               gin::Arguments* args);
+  v8::Local<v8::Value> GetResponseCacheInfo(const std::string& scheme);
+
   ProtocolError InterceptProtocol(ProtocolType type,
                                   const std::string& scheme,
                                   const ProtocolHandler& handler);
@@ -93,6 +110,13 @@ class Protocol : public gin_helper::TrackableObject<Protocol> {
 
   HandlersMap handlers_;
   HandlersMap intercept_handlers_;
+
+  // scheme => options of protocols registered with RegisterStaticProtocol.
+  std::map<std::string, StaticProtocolOptions> static_handlers_;
+
+  // scheme => response cache of the protocols registered with a handler,
+  // disabled until EnableResponseCache is called.
+  std::map<std::string, scoped_refptr<ProtocolResponseCache>> caches_;
 };
 
 }  // namespace api
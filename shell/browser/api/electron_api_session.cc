@@ -18,6 +18,7 @@
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/task/post_task.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "chrome/browser/browser_process.h"
 #include "chrome/common/pref_names.h"
 #include "components/download/public/common/download_danger_type.h"
@@ -31,6 +32,8 @@
 #include "content/public/browser/download_item_utils.h"
 #include "content/public/browser/download_manager_delegate.h"
 #include "content/public/browser/network_service_instance.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/render_process_host.h"
 #include "content/public/browser/storage_partition.h"
 #include "mojo/public/cpp/bindings/pending_remote.h"
 #include "mojo/public/cpp/bindings/self_owned_receiver.h"
@@ -46,6 +49,7 @@
 #include "shell/browser/api/electron_api_download_item.h"
 #include "shell/browser/api/electron_api_net_log.h"
 #include "shell/browser/api/electron_api_protocol.h"
+#include "shell/browser/api/electron_api_web_contents.h"
 #include "shell/browser/api/electron_api_web_request.h"
 #include "shell/browser/browser.h"
 #include "shell/browser/electron_browser_context.h"
@@ -747,6 +751,127 @@ static void StartPreconnectOnUI(
   browser_context->GetPreconnectManager()->Start(url, requests);
 }
 
+namespace {
+
+// Returns the preferences that spare renderers are matched by. The keys that
+// only select the session or the initial visibility do not change how the
+// renderer is launched.
+base::DictionaryValue GetSparePreferences(
+    v8::Isolate* isolate,
+    const gin_helper::Dictionary& web_preferences) {
+  base::DictionaryValue dict;
+  gin::ConvertFromV8(isolate, web_preferences.GetHandle(), &dict);
+  dict.RemoveKey("session");
+  dict.RemoveKey("partition");
+  dict.RemoveKey(options::kShow);
+  return dict;
+}
+
+}  // namespace
+
+// static
+gin::Handle<WebContents> Session::TakeSpareWebContents(
+    v8::Isolate* isolate,
+    const gin_helper::Dictionary& web_preferences) {
+  // Find the session the same way WebContents does.
+  gin::Handle<Session> session;
+  if (!web_preferences.Get("session", &session) || session.IsEmpty()) {
+    std::string partition;
+    web_preferences.Get("partition", &partition);
+    session = FromPartition(isolate, partition);
+  }
+  if (session.IsEmpty() || session->spare_web_contents_.empty())
+    return gin::Handle<WebContents>();
+  return session->TakeSpareWebContents(
+      GetSparePreferences(isolate, web_preferences));
+}
+
+gin::Handle<WebContents> Session::TakeSpareWebContents(
+    const base::DictionaryValue& web_preferences) {
+  if (web_preferences != spare_web_preferences_)
+    return gin::Handle<WebContents>();
+
+  gin::Handle<WebContents> web_contents;
+  while (web_contents.IsEmpty() && !spare_web_contents_.empty()) {
+    v8::Local<v8::Value> value = spare_web_contents_.back().Get(isolate());
+    spare_web_contents_.pop_back();
+    gin::Handle<WebContents> spare;
+    if (!gin::ConvertFromV8(isolate(), value, &spare) || !spare->web_contents())
+      continue;
+    // Skip spares whose renderer has crashed.
+    if (spare->web_contents()
+            ->GetMainFrame()
+            ->GetProcess()
+            ->IsInitializedAndNotDead())
+      web_contents = spare;
+    else
+      spare->DestroyWebContents(true /* async */);
+  }
+  if (!web_contents.IsEmpty())
+    SpareWebContentsMarker::CreateForWebContents(web_contents->web_contents());
+
+  // Replace the spare after the window has been created.
+  base::ThreadTaskRunnerHandle::Get()->PostTask(
+      FROM_HERE, base::BindOnce(&Session::FillSpareRendererPool,
+                                weak_ptr_factory_.GetWeakPtr()));
+  return web_contents;
+}
+
+void Session::FillSpareRendererPool() {
+  v8::Isolate* isolate = this->isolate();
+  v8::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+  while (spare_web_contents_.size() < spare_renderer_count_) {
+    gin_helper::Dictionary options;
+    gin::ConvertFromV8(isolate,
+                       gin::ConvertToV8(isolate, spare_web_preferences_),
+                       &options);
+    options.Set("session", GetWrapper());
+    options.Set(options::kShow, false);
+    gin::Handle<WebContents> web_contents =
+        WebContents::Create(isolate, options);
+    web_contents->WarmUpRenderer();
+    spare_web_contents_.emplace_back(isolate, web_contents.ToV8());
+  }
+}
+
+void Session::DestroySpareWebContents(size_t count) {
+  while (spare_web_contents_.size() > count) {
+    gin::Handle<WebContents> spare;
+    if (gin::ConvertFromV8(isolate(), spare_web_contents_.back().Get(isolate()),
+                           &spare))
+      spare->DestroyWebContents(true /* async */);
+    spare_web_contents_.pop_back();
+  }
+}
+
+void Session::SetSpareRendererPool(const gin_helper::Dictionary& options,
+                                   gin_helper::Arguments* args) {
+  int size = 0;
+  if (!options.Get("size", &size) || size < 0) {
+    args->ThrowError("size must be a non-negative integer");
+    return;
+  }
+  gin_helper::Dictionary web_preferences =
+      gin::Dictionary::CreateEmpty(isolate());
+  options.Get(options::kWebPreferences, &web_preferences);
+
+  base::DictionaryValue spare_web_preferences =
+      GetSparePreferences(isolate(), web_preferences);
+  if (spare_web_preferences != spare_web_preferences_) {
+    DestroySpareWebContents(0);
+    spare_web_preferences_ = std::move(spare_web_preferences);
+  }
+  spare_renderer_count_ = size;
+  DestroySpareWebContents(spare_renderer_count_);
+
+  // Launch the renderers once the current task is done, so that setting up
+  // the pool at startup does not delay the first window.
+  base::ThreadTaskRunnerHandle::Get()->PostTask(
+      FROM_HERE, base::BindOnce(&Session::FillSpareRendererPool,
+                                weak_ptr_factory_.GetWeakPtr()));
+}
+
 void Session::Preconnect(const gin_helper::Dictionary& options,
                          gin_helper::Arguments* args) {
   GURL url;
@@ -955,12 +1080,15 @@ void Session::BuildPrototype(v8::Isolate* isolate,
                  &Session::RemoveWordFromSpellCheckerDictionary)
 #endif
       .SetMethod("preconnect", &Session::Preconnect)
+      .SetMethod("setSpareRendererPool", &Session::SetSpareRendererPool)
       .SetProperty("cookies", &Session::Cookies)
       .SetProperty("netLog", &Session::NetLog)
       .SetProperty("protocol", &Session::Protocol)
       .SetProperty("webRequest", &Session::WebRequest);
 }
 
+WEB_CONTENTS_USER_DATA_KEY_IMPL(SpareWebContentsMarker)
+
 }  // namespace api
 
 }  // namespace electron
@@ -984,6 +1112,22 @@ v8::Local<v8::Value> FromPartition(const std::string& partition,
       .ToV8();
 }
 
+// Returns how many requests of |session| went through the webRequest proxy
+// and how many bypassed it, for the specs.
+v8::Local<v8::Value> GetWebRequestStats(v8::Isolate* isolate,
+                                        gin::Handle<Session> session) {
+  auto web_request = electron::api::WebRequest::From(
+      isolate, session->browser_context());
+  if (web_request.IsEmpty())
+    return v8::Null(isolate);
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  dict.Set("proxied",
+           static_cast<double>(web_request->proxied_request_count()));
+  dict.Set("bypassed",
+           static_cast<double>(web_request->bypassed_request_count()));
+  return dict.GetHandle();
+}
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
@@ -1003,6 +1147,7 @@ void Initialize(v8::Local<v8::Object> exports,
       "Protocol",
       Protocol::GetConstructor(isolate)->GetFunction(context).ToLocalChecked());
   dict.SetMethod("fromPartition", &FromPartition);
+  dict.SetMethod("_getWebRequestStats", &GetWebRequestStats);
 }
 
 }  // namespace
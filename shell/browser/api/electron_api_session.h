@@ -8,8 +8,10 @@
 #include <string>
 #include <vector>
 
+#include "base/memory/weak_ptr.h"
 #include "base/values.h"
 #include "content/public/browser/download_manager.h"
+#include "content/public/browser/web_contents_user_data.h"
 #include "electron/buildflags/buildflags.h"
 #include "gin/handle.h"
 #include "shell/browser/net/resolve_proxy_helper.h"
@@ -36,6 +38,8 @@ class ElectronBrowserContext;
 
 namespace api {
 
+class WebContents;
+
 class Session : public gin_helper::TrackableObject<Session>,
                 public content::DownloadManager::Observer {
  public:
@@ -50,6 +54,13 @@ class Session : public gin_helper::TrackableObject<Session>,
       const std::string& partition,
       base::DictionaryValue options = base::DictionaryValue());
 
+  // Takes a spare WebContents with an already launched renderer from the
+  // session used by |web_preferences|, returns an empty handle if the session
+  // has none with the same preferences.
+  static gin::Handle<WebContents> TakeSpareWebContents(
+      v8::Isolate* isolate,
+      const gin_helper::Dictionary& web_preferences);
+
   ElectronBrowserContext* browser_context() const {
     return browser_context_.get();
   }
@@ -91,6 +102,8 @@ class Session : public gin_helper::TrackableObject<Session>,
   v8::Local<v8::Value> NetLog(v8::Isolate* isolate);
   void Preconnect(const gin_helper::Dictionary& options,
                   gin_helper::Arguments* args);
+  void SetSpareRendererPool(const gin_helper::Dictionary& options,
+                            gin_helper::Arguments* args);
 #if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
   base::Value GetSpellCheckerLanguages();
   void SetSpellCheckerLanguages(gin_helper::ErrorThrower thrower,
@@ -116,6 +129,11 @@ class Session : public gin_helper::TrackableObject<Session>,
                          download::DownloadItem* item) override;
 
  private:
+  gin::Handle<WebContents> TakeSpareWebContents(
+      const base::DictionaryValue& web_preferences);
+  void FillSpareRendererPool();
+  void DestroySpareWebContents(size_t count);
+
   // Cached gin_helper::Wrappable objects.
   v8::Global<v8::Value> cookies_;
   v8::Global<v8::Value> protocol_;
@@ -129,9 +147,33 @@ class Session : public gin_helper::TrackableObject<Session>,
 
   scoped_refptr<ElectronBrowserContext> browser_context_;
 
+  // WebContents whose renderers are launched ahead of time, to be used by new
+  // BrowserWindows with the same preferences.
+  std::vector<v8::Global<v8::Value>> spare_web_contents_;
+  base::DictionaryValue spare_web_preferences_;
+  size_t spare_renderer_count_ = 0;
+
+  base::WeakPtrFactory<Session> weak_ptr_factory_{this};
+
   DISALLOW_COPY_AND_ASSIGN(Session);
 };
 
+// Marks the WebContents taken from a spare renderer pool, whose renderer was
+// launched before anything was loaded and is kept for the first navigation.
+class SpareWebContentsMarker
+    : public content::WebContentsUserData<SpareWebContentsMarker> {
+ public:
+  ~SpareWebContentsMarker() override = default;
+
+ private:
+  explicit SpareWebContentsMarker(content::WebContents* contents) {}
+  friend class content::WebContentsUserData<SpareWebContentsMarker>;
+
+  WEB_CONTENTS_USER_DATA_KEY_DECL();
+
+  DISALLOW_COPY_AND_ASSIGN(SpareWebContentsMarker);
+};
+
 }  // namespace api
 
 }  // namespace electron
@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "base/containers/id_map.h"
+#include "base/threading/sequenced_task_runner_handle.h"
 #include "gin/handle.h"
 #include "gin/object_template_builder.h"
 #include "gin/wrappable.h"
@@ -23,6 +24,7 @@
 #include "shell/browser/api/electron_api_session.h"
 #include "shell/browser/electron_browser_context.h"
 #include "shell/common/gin_converters/callback_converter.h"
+#include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_converters/gurl_converter.h"
 #include "shell/common/gin_converters/net_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
@@ -237,6 +239,13 @@ const net::NetworkTrafficAnnotationTag kTrafficAnnotation =
           setting: "This feature cannot be disabled."
         })");
 
+// Size of the ArrayBuffer that small response chunks are carved out of.
+const size_t kSharedBufferSize = 64 * 1024;
+
+// Coalesced chunks start at most this large and grow as they fill, so a large
+// chunkSize doesn't allocate its whole size for a short response.
+const size_t kMaxChunkReservation = 1024 * 1024;
+
 base::IDMap<SimpleURLLoaderWrapper*>& GetAllRequests() {
   static base::NoDestructor<base::IDMap<SimpleURLLoaderWrapper*>>
       s_all_requests;
@@ -247,8 +256,10 @@ base::IDMap<SimpleURLLoaderWrapper*>& GetAllRequests() {
 
 SimpleURLLoaderWrapper::SimpleURLLoaderWrapper(
     std::unique_ptr<network::ResourceRequest> request,
-    network::mojom::URLLoaderFactory* url_loader_factory)
-    : id_(GetAllRequests().Add(this)) {
+    network::mojom::URLLoaderFactory* url_loader_factory,
+    size_t chunk_size,
+    const base::FilePath& download_path)
+    : id_(GetAllRequests().Add(this)), chunk_size_(chunk_size) {
   // We slightly abuse the |render_frame_id| field in ResourceRequest so that
   // we can correlate any authentication events that arrive with this request.
   request->render_frame_id = id_;
@@ -273,7 +284,16 @@ SimpleURLLoaderWrapper::SimpleURLLoaderWrapper(
   loader_->SetOnDownloadProgressCallback(base::BindRepeating(
       &SimpleURLLoaderWrapper::OnDownloadProgress, base::Unretained(this)));
 
-  loader_->DownloadAsStream(url_loader_factory, this);
+  if (download_path.empty()) {
+    loader_->DownloadAsStream(url_loader_factory, this);
+  } else {
+    // The body is written on a background sequence and never enters JS.
+    loader_->DownloadToFile(
+        url_loader_factory,
+        base::BindOnce(&SimpleURLLoaderWrapper::OnDownloadedToFile,
+                       base::Unretained(this)),
+        download_path);
+  }
 }
 
 void SimpleURLLoaderWrapper::Pin() {
@@ -329,6 +349,7 @@ void SimpleURLLoaderWrapper::OnAuthRequired(
 
 void SimpleURLLoaderWrapper::Cancel() {
   loader_.reset();
+  resume_.Reset();
   pinned_wrapper_.Reset();
   pinned_chunk_pipe_getter_.Reset();
   // This ensures that no further callbacks will be called, so there's no need
@@ -361,6 +382,14 @@ gin_helper::WrappableBase* SimpleURLLoaderWrapper::New(gin::Arguments* args) {
   // every header passed.
   request->report_raw_headers = true;
 
+  int chunk_size = 0;
+  if (opts.Get("chunkSize", &chunk_size) && chunk_size < 0) {
+    args->ThrowTypeError("chunkSize must be a non-negative integer");
+    return nullptr;
+  }
+  base::FilePath download_path;
+  opts.Get("downloadPath", &download_path);
+
   v8::Local<v8::Value> body;
   v8::Local<v8::Value> chunk_pipe_getter;
   if (opts.Get("body", &body)) {
@@ -395,8 +424,8 @@ gin_helper::WrappableBase* SimpleURLLoaderWrapper::New(gin::Arguments* args) {
 
   auto url_loader_factory = session->browser_context()->GetURLLoaderFactory();
 
-  auto* ret =
-      new SimpleURLLoaderWrapper(std::move(request), url_loader_factory.get());
+  auto* ret = new SimpleURLLoaderWrapper(
+      std::move(request), url_loader_factory.get(), chunk_size, download_path);
   ret->InitWithArgs(args);
   ret->Pin();
   if (!chunk_pipe_getter.IsEmpty()) {
@@ -408,16 +437,121 @@ gin_helper::WrappableBase* SimpleURLLoaderWrapper::New(gin::Arguments* args) {
 void SimpleURLLoaderWrapper::OnDataReceived(base::StringPiece string_piece,
                                             base::OnceClosure resume) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  // JS may call resume() while the data is being emitted.
+  resume_ = std::move(resume);
+
   v8::HandleScope handle_scope(isolate());
-  auto array_buffer = v8::ArrayBuffer::New(isolate(), string_piece.size());
-  auto backing_store = array_buffer->GetBackingStore();
-  memcpy(backing_store->Data(), string_piece.data(), string_piece.size());
-  Emit("data", array_buffer);
-  std::move(resume).Run();
+  bool emitted = false;
+  while (!string_piece.empty()) {
+    if (chunk_buffer_.IsEmpty()) {
+      ReserveChunk(chunk_size_ ? std::min(chunk_size_, kMaxChunkReservation)
+                               : string_piece.size());
+    } else if (chunk_length_ == chunk_capacity_) {
+      ReserveChunk(std::min(chunk_capacity_ * 2, chunk_size_));
+    } else if (ChunkWasDetached()) {
+      // JS detached the chunk, e.g. by transferring the shared buffer that a
+      // previous chunk is a view of, so the data must go to memory JS doesn't
+      // own.
+      ReserveChunk(chunk_capacity_);
+    }
+    size_t length =
+        std::min(string_piece.size(), chunk_capacity_ - chunk_length_);
+    memcpy(static_cast<char*>(chunk_store_->Data()) + chunk_offset_ +
+               chunk_length_,
+           string_piece.data(), length);
+    chunk_length_ += length;
+    string_piece.remove_prefix(length);
+    if (chunk_length_ == chunk_capacity_ && chunk_capacity_ >= chunk_size_) {
+      FlushChunk();
+      emitted = true;
+      // The request was cancelled by a 'data' listener.
+      if (!loader_)
+        return;
+    }
+  }
+
+  // Keep reading until there is a chunk for JS to consume, and then only once
+  // JS has consumed it.
+  if (!emitted && resume_)
+    std::move(resume_).Run();
+}
+
+void SimpleURLLoaderWrapper::Resume() {
+  // Resuming can synchronously deliver more data, which must not happen while
+  // JS is still handling the 'data' event.
+  if (resume_) {
+    base::SequencedTaskRunnerHandle::Get()->PostTask(FROM_HERE,
+                                                     std::move(resume_));
+  }
+}
+
+void SimpleURLLoaderWrapper::ReserveChunk(size_t capacity) {
+  DCHECK_GE(capacity, chunk_length_);
+  v8::Local<v8::ArrayBuffer> buffer;
+  size_t offset = 0;
+  if (capacity < kSharedBufferSize / 2) {
+    // A detached shared buffer has been taken over by JS and can't be
+    // written to.
+    if (shared_buffer_.IsEmpty() ||
+        shared_buffer_.Get(isolate())->ByteLength() != kSharedBufferSize ||
+        shared_buffer_offset_ + capacity > kSharedBufferSize) {
+      shared_buffer_.Reset(isolate(),
+                           v8::ArrayBuffer::New(isolate(), kSharedBufferSize));
+      shared_buffer_offset_ = 0;
+    }
+    buffer = shared_buffer_.Get(isolate());
+    offset = shared_buffer_offset_;
+  } else {
+    buffer = v8::ArrayBuffer::New(isolate(), capacity);
+  }
+
+  // The backing store is held so its memory stays valid when JS detaches the
+  // buffer, and the data of the chunk being replaced is carried over.
+  std::shared_ptr<v8::BackingStore> store = buffer->GetBackingStore();
+  if (chunk_length_ > 0) {
+    memmove(static_cast<char*>(store->Data()) + offset,
+            static_cast<char*>(chunk_store_->Data()) + chunk_offset_,
+            chunk_length_);
+  }
+  chunk_buffer_.Reset(isolate(), buffer);
+  chunk_store_ = std::move(store);
+  chunk_offset_ = offset;
+  chunk_capacity_ = capacity;
+}
+
+bool SimpleURLLoaderWrapper::ChunkWasDetached() {
+  return chunk_buffer_.Get(isolate())->ByteLength() !=
+         chunk_store_->ByteLength();
+}
+
+void SimpleURLLoaderWrapper::FlushChunk() {
+  if (chunk_buffer_.IsEmpty())
+    return;
+  if (chunk_length_ > 0 && ChunkWasDetached())
+    ReserveChunk(chunk_length_);
+  v8::Local<v8::ArrayBuffer> buffer = chunk_buffer_.Get(isolate());
+  size_t offset = chunk_offset_;
+  size_t length = chunk_length_;
+  if (buffer == shared_buffer_.Get(isolate()))
+    shared_buffer_offset_ = offset + length;
+  chunk_buffer_.Reset();
+  chunk_store_.reset();
+  chunk_length_ = 0;
+  if (length > 0)
+    Emit("data", v8::Uint8Array::New(buffer, offset, length));
+}
+
+void SimpleURLLoaderWrapper::OnDownloadedToFile(base::FilePath path) {
+  OnComplete(!path.empty());
 }
 
 void SimpleURLLoaderWrapper::OnComplete(bool success) {
   if (success) {
+    // Emit the rest of a coalesced chunk.
+    v8::HandleScope handle_scope(isolate());
+    FlushChunk();
+    if (!loader_)
+      return;
     Emit("complete");
   } else {
     Emit("error", net::ErrorToString(loader_->NetError()));
@@ -466,7 +600,8 @@ void SimpleURLLoaderWrapper::BuildPrototype(
     v8::Local<v8::FunctionTemplate> prototype) {
   prototype->SetClassName(gin::StringToV8(isolate, "SimpleURLLoaderWrapper"));
   gin_helper::ObjectTemplateBuilder(isolate, prototype->PrototypeTemplate())
-      .SetMethod("cancel", &SimpleURLLoaderWrapper::Cancel);
+      .SetMethod("cancel", &SimpleURLLoaderWrapper::Cancel)
+      .SetMethod("resume", &SimpleURLLoaderWrapper::Resume);
 }
 
 }  // namespace api
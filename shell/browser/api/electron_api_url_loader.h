@@ -9,6 +9,7 @@
 #include <string>
 #include <vector>
 
+#include "base/files/file_path.h"
 #include "base/memory/weak_ptr.h"
 #include "net/base/auth.h"
 #include "services/network/public/cpp/simple_url_loader_stream_consumer.h"
@@ -55,9 +56,14 @@ class SimpleURLLoaderWrapper
 
   void Cancel();
 
+  // Called by JS once the last emitted chunk has been consumed.
+  void Resume();
+
  private:
   SimpleURLLoaderWrapper(std::unique_ptr<network::ResourceRequest> loader,
-                         network::mojom::URLLoaderFactory* url_loader_factory);
+                         network::mojom::URLLoaderFactory* url_loader_factory,
+                         size_t chunk_size,
+                         const base::FilePath& download_path);
 
   // SimpleURLLoaderStreamConsumer:
   void OnDataReceived(base::StringPiece string_piece,
@@ -65,6 +71,15 @@ class SimpleURLLoaderWrapper
   void OnComplete(bool success) override;
   void OnRetry(base::OnceClosure start_retry) override;
 
+  void OnDownloadedToFile(base::FilePath path);
+
+  // Starts a new chunk of |capacity| bytes that the response body is copied
+  // into, moving the data of the current chunk into it, and emits it once it
+  // is full.
+  void ReserveChunk(size_t capacity);
+  bool ChunkWasDetached();
+  void FlushChunk();
+
   // SimpleURLLoader callbacks
   void OnResponseStarted(const GURL& final_url,
                          const network::mojom::URLResponseHead& response_head);
@@ -83,6 +98,26 @@ class SimpleURLLoaderWrapper
   v8::Global<v8::Value> pinned_wrapper_;
   v8::Global<v8::Value> pinned_chunk_pipe_getter_;
 
+  // Data is emitted in chunks of at least |chunk_size_| bytes, or as received
+  // when it is 0.
+  const size_t chunk_size_;
+
+  // Small chunks are consecutive views into one shared ArrayBuffer, so they
+  // do not each allocate a backing store. Its memory is never reused, a new
+  // one is allocated once it is full.
+  v8::Global<v8::ArrayBuffer> shared_buffer_;
+  size_t shared_buffer_offset_ = 0;
+
+  // The chunk currently being filled.
+  v8::Global<v8::ArrayBuffer> chunk_buffer_;
+  std::shared_ptr<v8::BackingStore> chunk_store_;
+  size_t chunk_offset_ = 0;
+  size_t chunk_capacity_ = 0;
+  size_t chunk_length_ = 0;
+
+  // Resumes reading the body, held until JS has consumed the emitted data.
+  base::OnceClosure resume_;
+
   base::WeakPtrFactory<SimpleURLLoaderWrapper> weak_factory_{this};
 };
 
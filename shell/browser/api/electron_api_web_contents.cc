@@ -45,11 +45,13 @@
 #include "electron/buildflags/buildflags.h"
 #include "electron/shell/common/api/api.mojom.h"
 #include "mojo/public/cpp/bindings/associated_remote.h"
+#include "mojo/public/cpp/bindings/self_owned_receiver.h"
 #include "mojo/public/cpp/system/platform_handle.h"
 #include "ppapi/buildflags/buildflags.h"
 #include "shell/browser/api/electron_api_browser_window.h"
 #include "shell/browser/api/electron_api_debugger.h"
 #include "shell/browser/api/electron_api_session.h"
+#include "shell/browser/api/page_capturer.h"
 #include "shell/browser/browser.h"
 #include "shell/browser/child_web_contents_tracker.h"
 #include "shell/browser/electron_autofill_driver_factory.h"
@@ -60,6 +62,7 @@
 #include "shell/browser/electron_navigation_throttle.h"
 #include "shell/browser/lib/bluetooth_chooser.h"
 #include "shell/browser/native_window.h"
+#include "shell/browser/script_code_cache.h"
 #include "shell/browser/session_preferences.h"
 #include "shell/browser/ui/drag_util.h"
 #include "shell/browser/ui/inspectable_web_contents.h"
@@ -70,6 +73,7 @@
 #include "shell/browser/web_view_guest_delegate.h"
 #include "shell/common/api/electron_api_native_image.h"
 #include "shell/common/color_util.h"
+#include "shell/common/cpu_profile.h"
 #include "shell/common/gin_converters/blink_converter.h"
 #include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_converters/content_converter.h"
@@ -81,6 +85,7 @@
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/object_template_builder.h"
+#include "shell/common/heap_snapshot.h"
 #include "shell/common/mouse_util.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/options_switches.h"
@@ -90,7 +95,6 @@
 #include "third_party/blink/public/mojom/frame/find_in_page.mojom.h"
 #include "third_party/blink/public/mojom/frame/fullscreen.mojom.h"
 #include "third_party/blink/public/platform/web_cursor_info.h"
-#include "ui/display/screen.h"
 #include "ui/events/base_event_utils.h"
 
 #if BUILDFLAG(ENABLE_OSR)
@@ -1361,6 +1365,10 @@ void WebContents::SetBackgroundThrottling(bool allowed) {
   }
 }
 
+bool WebContents::WarmUpRenderer() {
+  return web_contents()->GetMainFrame()->GetProcess()->Init();
+}
+
 int WebContents::GetProcessID() const {
   return web_contents()->GetMainFrame()->GetProcess()->GetID();
 }
@@ -2259,12 +2267,16 @@ void WebContents::StartDrag(const gin_helper::Dictionary& item,
 
 v8::Local<v8::Promise> WebContents::CapturePage(gin_helper::Arguments* args) {
   gfx::Rect rect;
-  gin_helper::Promise<gfx::Image> promise(isolate());
-  v8::Local<v8::Promise> handle = promise.GetHandle();
-
   // get rect arguments if they exist
   args->GetNext(&rect);
 
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options) && options.Has("format"))
+    return CapturePageEncoded(rect, options);
+
+  gin_helper::Promise<gfx::Image> promise(isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
   auto* const view = web_contents()->GetRenderWidgetHostView();
   if (!view) {
     promise.Resolve(gfx::Image());
@@ -2275,22 +2287,55 @@ v8::Local<v8::Promise> WebContents::CapturePage(gin_helper::Arguments* args) {
   const gfx::Size view_size =
       rect.IsEmpty() ? view->GetViewBounds().size() : rect.size();
 
-  // By default, the requested bitmap size is the view size in screen
-  // coordinates.  However, if there's more pixel detail available on the
-  // current system, increase the requested bitmap size to capture it all.
-  gfx::Size bitmap_size = view_size;
-  const gfx::NativeView native_view = view->GetNativeView();
-  const float scale = display::Screen::GetScreen()
-                          ->GetDisplayNearestView(native_view)
-                          .device_scale_factor();
-  if (scale > 1.0f)
-    bitmap_size = gfx::ScaleToCeiledSize(view_size, scale);
-
-  view->CopyFromSurface(gfx::Rect(rect.origin(), view_size), bitmap_size,
+  view->CopyFromSurface(gfx::Rect(rect.origin(), view_size),
+                        PageCapturer::GetBitmapSize(view, view_size),
                         base::BindOnce(&OnCapturePageDone, std::move(promise)));
   return handle;
 }
 
+v8::Local<v8::Promise> WebContents::CapturePageEncoded(
+    const gfx::Rect& rect,
+    const gin_helper::Dictionary& options) {
+  gin_helper::Promise<v8::Local<v8::Value>> promise(isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  PageCapturer::Options capture_options;
+  std::string format;
+  options.Get("format", &format);
+  if (format == "png") {
+    capture_options.format = PageCapturer::Format::kPNG;
+  } else if (format == "jpeg") {
+    capture_options.format = PageCapturer::Format::kJPEG;
+  } else if (format == "webp") {
+    capture_options.format = PageCapturer::Format::kWebP;
+  } else {
+    promise.RejectWithErrorMessage("Invalid format: " + format);
+    return handle;
+  }
+  options.Get("quality", &capture_options.quality);
+  options.Get("tileHeight", &capture_options.tile_height);
+  if (capture_options.quality < 0 || capture_options.quality > 100) {
+    promise.RejectWithErrorMessage("quality must be between 0 and 100");
+    return handle;
+  }
+  if (capture_options.tile_height < 0) {
+    promise.RejectWithErrorMessage("tileHeight must be positive");
+    return handle;
+  }
+
+  // Capture full page if user doesn't specify a |rect|.
+  gfx::Rect area = rect;
+  auto* const view = web_contents()->GetRenderWidgetHostView();
+  if (rect.IsEmpty())
+    area.set_size(view ? view->GetViewBounds().size() : gfx::Size());
+
+  // The capturer deletes itself once the promise is settled.
+  auto* capturer = new PageCapturer(web_contents(), std::move(promise),
+                                    capture_options);
+  capturer->Capture(area);
+  return handle;
+}
+
 void WebContents::IncrementCapturerCount(gin_helper::Arguments* args) {
   gfx::Size size;
   bool stay_hidden = false;
@@ -2434,6 +2479,24 @@ void WebContents::DoGetZoomLevel(DoGetZoomLevelCallback callback) {
   std::move(callback).Run(GetZoomLevel());
 }
 
+void WebContents::GetCodeCache(const std::string& key,
+                               GetCodeCacheCallback callback) {
+  // The entries are partitioned by the site of the frame, which is known to
+  // the browser, rather than by anything the renderer says.
+  const GURL& site =
+      bindings_.dispatch_context()->GetSiteInstance()->GetSiteURL();
+  std::move(callback).Run(
+      mojo_base::BigBuffer(ScriptCodeCache::GetInstance()->Get(site, key)));
+}
+
+void WebContents::SetCodeCache(const std::string& key,
+                               mojo_base::BigBuffer data) {
+  const GURL& site =
+      bindings_.dispatch_context()->GetSiteInstance()->GetSiteURL();
+  ScriptCodeCache::GetInstance()->Put(
+      site, key, std::vector<uint8_t>(data.data(), data.data() + data.size()));
+}
+
 std::vector<base::FilePath::StringType> WebContents::GetPreloadPaths() const {
   auto result = SessionPreferences::GetValidPreloads(GetBrowserContext());
 
@@ -2539,11 +2602,50 @@ void WebContents::GrantOriginAccess(const GURL& url) {
       url::Origin::Create(url));
 }
 
+namespace {
+
+// Reports the progress of a heap snapshot taken by a renderer.
+class HeapSnapshotProgressObserver : public mojom::HeapSnapshotObserver {
+ public:
+  explicit HeapSnapshotProgressObserver(
+      const HeapSnapshotProgressCallback& callback)
+      : callback_(callback) {}
+
+  // mojom::HeapSnapshotObserver:
+  void OnProgress(mojom::HeapSnapshotPhase phase,
+                  uint64_t done,
+                  uint64_t total) override {
+    HeapSnapshotProgress progress;
+    progress.phase = phase == mojom::HeapSnapshotPhase::kSnapshot
+                         ? HeapSnapshotProgress::Phase::kSnapshot
+                         : HeapSnapshotProgress::Phase::kWrite;
+    progress.done = done;
+    progress.total = total;
+    callback_.Run(progress);
+  }
+
+ private:
+  HeapSnapshotProgressCallback callback_;
+
+  DISALLOW_COPY_AND_ASSIGN(HeapSnapshotProgressObserver);
+};
+
+}  // namespace
+
 v8::Local<v8::Promise> WebContents::TakeHeapSnapshot(
-    const base::FilePath& file_path) {
+    const base::FilePath& file_path,
+    gin_helper::Arguments* args) {
   gin_helper::Promise<void> promise(isolate());
   v8::Local<v8::Promise> handle = promise.GetHandle();
 
+  bool compress = false;
+  HeapSnapshotProgressCallback progress;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options)) {
+    options.Get("compress", &compress);
+    options.Get("onProgress", &progress);
+  }
+
   base::ThreadRestrictions::ScopedAllowIO allow_io;
   base::File file(file_path,
                   base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
@@ -2558,6 +2660,14 @@ v8::Local<v8::Promise> WebContents::TakeHeapSnapshot(
     return handle;
   }
 
+  // The observer deletes itself once the renderer is done with it.
+  mojo::PendingRemote<mojom::HeapSnapshotObserver> observer;
+  if (progress) {
+    mojo::MakeSelfOwnedReceiver(
+        std::make_unique<HeapSnapshotProgressObserver>(progress),
+        observer.InitWithNewPipeAndPassReceiver());
+  }
+
   // This dance with `base::Owned` is to ensure that the interface stays alive
   // until the callback is called. Otherwise it would be closed at the end of
   // this function.
@@ -2567,7 +2677,8 @@ v8::Local<v8::Promise> WebContents::TakeHeapSnapshot(
       electron_renderer.get());
   auto* raw_ptr = electron_renderer.get();
   (*raw_ptr)->TakeHeapSnapshot(
-      mojo::WrapPlatformFile(file.TakePlatformFile()),
+      mojo::WrapPlatformFile(file.TakePlatformFile()), compress,
+      std::move(observer),
       base::BindOnce(
           [](mojo::AssociatedRemote<mojom::ElectronRenderer>* ep,
              gin_helper::Promise<void> promise, bool success) {
@@ -2581,6 +2692,91 @@ v8::Local<v8::Promise> WebContents::TakeHeapSnapshot(
   return handle;
 }
 
+v8::Local<v8::Promise> WebContents::StartCpuProfiling(
+    gin_helper::Arguments* args) {
+  gin_helper::Promise<void> promise(isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  int sampling_interval = static_cast<int>(
+      kDefaultCpuProfileSamplingInterval.InMicroseconds());
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options) &&
+      options.Get("samplingInterval", &sampling_interval) &&
+      sampling_interval < 1) {
+    promise.RejectWithErrorMessage(
+        "samplingInterval must be a positive number");
+    return handle;
+  }
+
+  auto* frame_host = web_contents()->GetMainFrame();
+  if (!frame_host) {
+    promise.RejectWithErrorMessage("startCpuProfiling failed");
+    return handle;
+  }
+
+  auto electron_renderer =
+      std::make_unique<mojo::AssociatedRemote<mojom::ElectronRenderer>>();
+  frame_host->GetRemoteAssociatedInterfaces()->GetInterface(
+      electron_renderer.get());
+  auto* raw_ptr = electron_renderer.get();
+  (*raw_ptr)->StartCpuProfiling(
+      sampling_interval,
+      base::BindOnce(
+          [](mojo::AssociatedRemote<mojom::ElectronRenderer>* ep,
+             gin_helper::Promise<void> promise, bool success) {
+            if (success) {
+              promise.Resolve();
+            } else {
+              promise.RejectWithErrorMessage(
+                  "The renderer is already being profiled");
+            }
+          },
+          base::Owned(std::move(electron_renderer)), std::move(promise)));
+  return handle;
+}
+
+v8::Local<v8::Promise> WebContents::StopCpuProfiling(
+    const base::FilePath& file_path) {
+  gin_helper::Promise<void> promise(isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  auto* frame_host = web_contents()->GetMainFrame();
+  if (!frame_host) {
+    promise.RejectWithErrorMessage("stopCpuProfiling failed");
+    return handle;
+  }
+
+  // The file is opened here since sandboxed renderers can't. The profiler is
+  // stopped even when it can't be opened.
+  mojo::ScopedHandle file_handle;
+  {
+    base::ThreadRestrictions::ScopedAllowIO allow_io;
+    base::File file(file_path,
+                    base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+    if (file.IsValid())
+      file_handle = mojo::WrapPlatformFile(file.TakePlatformFile());
+  }
+
+  auto electron_renderer =
+      std::make_unique<mojo::AssociatedRemote<mojom::ElectronRenderer>>();
+  frame_host->GetRemoteAssociatedInterfaces()->GetInterface(
+      electron_renderer.get());
+  auto* raw_ptr = electron_renderer.get();
+  (*raw_ptr)->StopCpuProfiling(
+      std::move(file_handle),
+      base::BindOnce(
+          [](mojo::AssociatedRemote<mojom::ElectronRenderer>* ep,
+             gin_helper::Promise<void> promise, bool success) {
+            if (success) {
+              promise.Resolve();
+            } else {
+              promise.RejectWithErrorMessage("stopCpuProfiling failed");
+            }
+          },
+          base::Owned(std::move(electron_renderer)), std::move(promise)));
+  return handle;
+}
+
 // static
 void WebContents::BuildPrototype(v8::Isolate* isolate,
                                  v8::Local<v8::FunctionTemplate> prototype) {
@@ -2701,6 +2897,8 @@ void WebContents::BuildPrototype(v8::Isolate* isolate,
                  &WebContents::GetWebRTCIPHandlingPolicy)
       .SetMethod("_grantOriginAccess", &WebContents::GrantOriginAccess)
       .SetMethod("takeHeapSnapshot", &WebContents::TakeHeapSnapshot)
+      .SetMethod("startCpuProfiling", &WebContents::StartCpuProfiling)
+      .SetMethod("stopCpuProfiling", &WebContents::StopCpuProfiling)
       .SetProperty("id", &WebContents::ID)
       .SetProperty("session", &WebContents::Session)
       .SetProperty("hostWebContents", &WebContents::HostWebContents)
@@ -2758,6 +2956,16 @@ namespace {
 
 using electron::api::WebContents;
 
+// Returns how many preload code cache lookups hit and how many of the hits
+// were rejected by V8, for the specs.
+v8::Local<v8::Value> GetCodeCacheStats(v8::Isolate* isolate) {
+  auto* cache = electron::ScriptCodeCache::GetInstance();
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  dict.Set("hits", static_cast<double>(cache->hit_count()));
+  dict.Set("rejected", static_cast<double>(cache->replace_count()));
+  return dict.GetHandle();
+}
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
@@ -2770,6 +2978,7 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("create", &WebContents::Create);
   dict.SetMethod("fromId", &WebContents::FromWeakMapID);
   dict.SetMethod("getAllWebContents", &WebContents::GetAll);
+  dict.SetMethod("_getCodeCacheStats", &GetCodeCacheStats);
 }
 
 }  // namespace
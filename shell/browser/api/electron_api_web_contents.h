@@ -149,6 +149,10 @@ class WebContents : public gin_helper::TrackableObject<WebContents>,
   // See https://github.com/electron/electron/issues/15133.
   void DestroyWebContents(bool async);
 
+  // Launches the renderer process of the main frame before anything is loaded,
+  // used by the spare renderer pool of Session.
+  bool WarmUpRenderer();
+
   void SetBackgroundThrottling(bool allowed);
   int GetProcessID() const;
   base::ProcessId GetOSProcessID() const;
@@ -324,7 +328,12 @@ class WebContents : public gin_helper::TrackableObject<WebContents>,
   // the specified URL.
   void GrantOriginAccess(const GURL& url);
 
-  v8::Local<v8::Promise> TakeHeapSnapshot(const base::FilePath& file_path);
+  v8::Local<v8::Promise> TakeHeapSnapshot(const base::FilePath& file_path,
+                                          gin_helper::Arguments* args);
+
+  // Profiles the JavaScript of the main frame's renderer.
+  v8::Local<v8::Promise> StartCpuProfiling(gin_helper::Arguments* args);
+  v8::Local<v8::Promise> StopCpuProfiling(const base::FilePath& file_path);
 
   // Properties.
   int32_t ID() const;
@@ -511,6 +520,11 @@ class WebContents : public gin_helper::TrackableObject<WebContents>,
 
   uint32_t GetNextRequestId() { return ++request_id_; }
 
+  // Captures |rect| into encoded images as described by |options|.
+  v8::Local<v8::Promise> CapturePageEncoded(
+      const gfx::Rect& rect,
+      const gin_helper::Dictionary& options);
+
 #if BUILDFLAG(ENABLE_OSR)
   OffScreenWebContentsView* GetOffScreenWebContentsView() const override;
   OffScreenRenderWidgetHostView* GetOffScreenRenderWidgetHostView() const;
@@ -544,6 +558,9 @@ class WebContents : public gin_helper::TrackableObject<WebContents>,
       std::vector<mojom::DraggableRegionPtr> regions) override;
   void SetTemporaryZoomLevel(double level) override;
   void DoGetZoomLevel(DoGetZoomLevelCallback callback) override;
+  void GetCodeCache(const std::string& key,
+                    GetCodeCacheCallback callback) override;
+  void SetCodeCache(const std::string& key, mojo_base::BigBuffer data) override;
 
   // Called when we receive a CursorChange message from chromium.
   void OnCursorChange(const content::WebCursor& cursor);
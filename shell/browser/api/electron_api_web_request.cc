@@ -4,9 +4,11 @@
 
 #include "shell/browser/api/electron_api_web_request.h"
 
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/stl_util.h"
 #include "base/values.h"
@@ -87,17 +89,9 @@ struct UserData : public base::SupportsUserData::Data {
   WebRequest* data;
 };
 
-// Test whether the URL of |request| matches |patterns|.
-bool MatchesFilterCondition(extensions::WebRequestInfo* info,
-                            const std::set<URLPattern>& patterns) {
-  if (patterns.empty())
-    return true;
-
-  for (const auto& pattern : patterns) {
-    if (pattern.MatchesURL(info->url))
-      return true;
-  }
-  return false;
+// Test whether |url| matches |patterns|.
+bool MatchesFilterCondition(const GURL& url, const URLPatternIndex& patterns) {
+  return patterns.empty() || patterns.MatchesURL(url);
 }
 
 // Convert HttpResponseHeaders to V8.
@@ -105,19 +99,19 @@ bool MatchesFilterCondition(extensions::WebRequestInfo* info,
 // Note that while we already have converters for HttpResponseHeaders, we can
 // not use it because it lowercases the header keys, while the webRequest has
 // to pass the original keys.
+//
+// The headers are collected into plain STL containers instead of a
+// base::DictionaryValue, which would allocate a base::Value for every header
+// line before being converted again.
 v8::Local<v8::Value> HttpResponseHeadersToV8(
     net::HttpResponseHeaders* headers) {
-  base::DictionaryValue response_headers;
+  std::map<std::string, std::vector<std::string>> response_headers;
   if (headers) {
     size_t iter = 0;
     std::string key;
     std::string value;
-    while (headers->EnumerateHeaderLines(&iter, &key, &value)) {
-      base::Value* values = response_headers.FindListKey(key);
-      if (!values)
-        values = response_headers.SetKey(key, base::ListValue());
-      values->Append(value);
-    }
+    while (headers->EnumerateHeaderLines(&iter, &key, &value))
+      response_headers[key].push_back(std::move(value));
   }
   return gin::ConvertToV8(v8::Isolate::GetCurrent(), response_headers);
 }
@@ -217,14 +211,14 @@ gin::WrapperInfo WebRequest::kWrapperInfo = {gin::kEmbedderNativeGin};
 WebRequest::SimpleListenerInfo::SimpleListenerInfo(
     std::set<URLPattern> patterns_,
     SimpleListener listener_)
-    : url_patterns(std::move(patterns_)), listener(listener_) {}
+    : url_patterns(std::move(patterns_)), listener(std::move(listener_)) {}
 WebRequest::SimpleListenerInfo::SimpleListenerInfo() = default;
 WebRequest::SimpleListenerInfo::~SimpleListenerInfo() = default;
 
 WebRequest::ResponseListenerInfo::ResponseListenerInfo(
     std::set<URLPattern> patterns_,
     ResponseListener listener_)
-    : url_patterns(std::move(patterns_)), listener(listener_) {}
+    : url_patterns(std::move(patterns_)), listener(std::move(listener_)) {}
 WebRequest::ResponseListenerInfo::ResponseListenerInfo() = default;
 WebRequest::ResponseListenerInfo::~ResponseListenerInfo() = default;
 
@@ -266,6 +260,25 @@ bool WebRequest::HasListener() const {
   return !(simple_listeners_.empty() && response_listeners_.empty());
 }
 
+bool WebRequest::HasListenerForURL(const GURL& url) const {
+  for (const auto& it : simple_listeners_) {
+    if (MatchesFilterCondition(url, it.second.url_patterns))
+      return true;
+  }
+  for (const auto& it : response_listeners_) {
+    if (MatchesFilterCondition(url, it.second.url_patterns))
+      return true;
+  }
+  return false;
+}
+
+void WebRequest::CountRequest(bool proxied) {
+  if (proxied)
+    ++proxied_request_count_;
+  else
+    ++bypassed_request_count_;
+}
+
 int WebRequest::OnBeforeRequest(extensions::WebRequestInfo* info,
                                 const network::ResourceRequest& request,
                                 net::CompletionOnceCallback callback,
@@ -405,7 +418,7 @@ void WebRequest::HandleSimpleEvent(SimpleEvent event,
     return;
 
   const auto& info = iter->second;
-  if (!MatchesFilterCondition(request_info, info.url_patterns))
+  if (!MatchesFilterCondition(request_info->url, info.url_patterns))
     return;
 
   v8::Isolate* isolate = v8::Isolate::GetCurrent();
@@ -426,7 +439,7 @@ int WebRequest::HandleResponseEvent(ResponseEvent event,
     return net::OK;
 
   const auto& info = iter->second;
-  if (!MatchesFilterCondition(request_info, info.url_patterns))
+  if (!MatchesFilterCondition(request_info->url, info.url_patterns))
     return net::OK;
 
   callbacks_[request_info->id] = std::move(callback);
@@ -13,6 +13,7 @@
 #include "gin/arguments.h"
 #include "gin/handle.h"
 #include "gin/wrappable.h"
+#include "shell/browser/net/url_pattern_index.h"
 #include "shell/browser/net/web_request_api_interface.h"
 
 namespace content {
@@ -49,8 +50,15 @@ class WebRequest : public gin::Wrappable<WebRequest>, public WebRequestAPI {
       v8::Isolate* isolate) override;
   const char* GetTypeName() override;
 
+  // Number of requests that went through the webRequest proxy, and of those
+  // passed straight to the network because no listener's filter matched them.
+  uint64_t proxied_request_count() const { return proxied_request_count_; }
+  uint64_t bypassed_request_count() const { return bypassed_request_count_; }
+
   // WebRequestAPI:
   bool HasListener() const override;
+  bool HasListenerForURL(const GURL& url) const override;
+  void CountRequest(bool proxied) override;
   int OnBeforeRequest(extensions::WebRequestInfo* info,
                       const network::ResourceRequest& request,
                       net::CompletionOnceCallback callback,
@@ -126,7 +134,7 @@ class WebRequest : public gin::Wrappable<WebRequest>, public WebRequestAPI {
   void OnListenerResult(uint64_t id, T out, v8::Local<v8::Value> response);
 
   struct SimpleListenerInfo {
-    std::set<URLPattern> url_patterns;
+    URLPatternIndex url_patterns;
     SimpleListener listener;
 
     SimpleListenerInfo(std::set<URLPattern>, SimpleListener);
@@ -135,7 +143,7 @@ class WebRequest : public gin::Wrappable<WebRequest>, public WebRequestAPI {
   };
 
   struct ResponseListenerInfo {
-    std::set<URLPattern> url_patterns;
+    URLPatternIndex url_patterns;
     ResponseListener listener;
 
     ResponseListenerInfo(std::set<URLPattern>, ResponseListener);
@@ -147,6 +155,9 @@ class WebRequest : public gin::Wrappable<WebRequest>, public WebRequestAPI {
   std::map<ResponseEvent, ResponseListenerInfo> response_listeners_;
   std::map<uint64_t, net::CompletionOnceCallback> callbacks_;
 
+  uint64_t proxied_request_count_ = 0;
+  uint64_t bypassed_request_count_ = 0;
+
   // Weak-ref, it manages us.
   content::BrowserContext* browser_context_;
 };
@@ -0,0 +1,177 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/page_capturer.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/task/post_task.h"
+#include "base/task_runner_util.h"
+#include "content/public/browser/render_widget_host_view.h"
+#include "content/public/browser/web_contents.h"
+#include "shell/common/gin_converters/gfx_converter.h"
+#include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/node_includes.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkPixmap.h"
+#include "third_party/skia/include/core/SkStream.h"
+#include "third_party/skia/include/encode/SkWebpEncoder.h"
+#include "ui/display/display.h"
+#include "ui/display/screen.h"
+#include "ui/gfx/codec/jpeg_codec.h"
+#include "ui/gfx/codec/png_codec.h"
+#include "ui/gfx/geometry/size_conversions.h"
+
+namespace electron {
+
+namespace api {
+
+namespace {
+
+std::vector<unsigned char> EncodeBitmap(const SkBitmap& bitmap,
+                                        PageCapturer::Format format,
+                                        int quality) {
+  std::vector<unsigned char> data;
+  switch (format) {
+    case PageCapturer::Format::kPNG:
+      gfx::PNGCodec::EncodeBGRASkBitmap(bitmap, false, &data);
+      break;
+    case PageCapturer::Format::kJPEG:
+      gfx::JPEGCodec::Encode(bitmap, quality, &data);
+      break;
+    case PageCapturer::Format::kWebP: {
+      SkPixmap pixmap;
+      if (!bitmap.peekPixels(&pixmap))
+        break;
+      SkWebpEncoder::Options options;
+      options.fQuality = quality;
+      SkDynamicMemoryWStream stream;
+      if (SkWebpEncoder::Encode(&stream, pixmap, options)) {
+        data.resize(stream.bytesWritten());
+        stream.copyTo(data.data());
+      }
+      break;
+    }
+  }
+  return data;
+}
+
+void DeleteEncodedData(char*, void* hint) {
+  delete static_cast<std::vector<unsigned char>*>(hint);
+}
+
+// Hands |data| over to a Buffer without copying it.
+v8::Local<v8::Value> ToBuffer(v8::Isolate* isolate,
+                              std::vector<unsigned char> data) {
+  if (data.empty())
+    return node::Buffer::New(isolate, 0).ToLocalChecked();
+  auto* owned = new std::vector<unsigned char>(std::move(data));
+  return node::Buffer::New(isolate, reinterpret_cast<char*>(owned->data()),
+                           owned->size(), &DeleteEncodedData, owned)
+      .ToLocalChecked();
+}
+
+}  // namespace
+
+PageCapturer::PageCapturer(content::WebContents* web_contents,
+                           gin_helper::Promise<v8::Local<v8::Value>> promise,
+                           const Options& options)
+    : content::WebContentsObserver(web_contents),
+      promise_(std::move(promise)),
+      options_(options) {}
+
+PageCapturer::~PageCapturer() = default;
+
+void PageCapturer::Capture(const gfx::Rect& rect) {
+  rect_ = rect;
+  next_y_ = rect.y();
+  if (rect_.IsEmpty())
+    Finish();
+  else
+    CaptureNextTile();
+}
+
+// static
+gfx::Size PageCapturer::GetBitmapSize(content::RenderWidgetHostView* view,
+                                      const gfx::Size& size) {
+  // By default, the requested bitmap size is the view size in screen
+  // coordinates.  However, if there's more pixel detail available on the
+  // current system, increase the requested bitmap size to capture it all.
+  const float scale = display::Screen::GetScreen()
+                          ->GetDisplayNearestView(view->GetNativeView())
+                          .device_scale_factor();
+  if (scale > 1.0f)
+    return gfx::ScaleToCeiledSize(size, scale);
+  return size;
+}
+
+void PageCapturer::CaptureNextTile() {
+  auto* const view = web_contents()->GetRenderWidgetHostView();
+  if (!view) {
+    Finish();
+    return;
+  }
+
+  int height = rect_.bottom() - next_y_;
+  if (options_.tile_height > 0)
+    height = std::min(height, options_.tile_height);
+  gfx::Rect tile(rect_.x(), next_y_, rect_.width(), height);
+  view->CopyFromSurface(tile, GetBitmapSize(view, tile.size()),
+                        base::BindOnce(&PageCapturer::OnTileCaptured,
+                                       weak_factory_.GetWeakPtr(), tile));
+}
+
+void PageCapturer::OnTileCaptured(const gfx::Rect& tile,
+                                  const SkBitmap& bitmap) {
+  base::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::ThreadPool(), base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(&EncodeBitmap, bitmap, options_.format, options_.quality),
+      base::BindOnce(&PageCapturer::OnTileEncoded, weak_factory_.GetWeakPtr(),
+                     tile));
+}
+
+void PageCapturer::OnTileEncoded(const gfx::Rect& tile,
+                                 std::vector<unsigned char> data) {
+  tiles_.emplace_back(tile, std::move(data));
+  next_y_ = tile.bottom();
+  if (next_y_ < rect_.bottom())
+    CaptureNextTile();
+  else
+    Finish();
+}
+
+void PageCapturer::Finish() {
+  v8::Isolate* isolate = promise_.isolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(promise_.GetContext());
+
+  if (options_.tile_height == 0) {
+    std::vector<unsigned char> data;
+    if (!tiles_.empty())
+      data = std::move(tiles_.front().second);
+    promise_.Resolve(ToBuffer(isolate, std::move(data)));
+  } else {
+    std::vector<v8::Local<v8::Value>> tiles;
+    for (auto& tile : tiles_) {
+      gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+      dict.Set("rect", tile.first);
+      dict.Set("data", ToBuffer(isolate, std::move(tile.second)));
+      tiles.push_back(dict.GetHandle());
+    }
+    promise_.Resolve(gin::ConvertToV8(isolate, tiles));
+  }
+  delete this;
+}
+
+void PageCapturer::WebContentsDestroyed() {
+  promise_.RejectWithErrorMessage(
+      "The page was destroyed before it was captured");
+  delete this;
+}
+
+}  // namespace api
+
+}  // namespace electron
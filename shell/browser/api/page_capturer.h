@@ -0,0 +1,81 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_API_PAGE_CAPTURER_H_
+#define SHELL_BROWSER_API_PAGE_CAPTURER_H_
+
+#include <utility>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "content/public/browser/web_contents_observer.h"
+#include "shell/common/gin_helper/promise.h"
+#include "ui/gfx/geometry/rect.h"
+#include "v8/include/v8.h"
+
+class SkBitmap;
+
+namespace content {
+class RenderWidgetHostView;
+}
+
+namespace electron {
+
+namespace api {
+
+// A self-destroyed class capturing an area of a page into encoded images.
+//
+// Encoding happens on the thread pool. In tiled mode the area is captured in
+// strips, and a strip is only captured once the previous one was encoded, so
+// at most one strip is kept decoded however large the area is.
+class PageCapturer : public content::WebContentsObserver {
+ public:
+  enum class Format { kPNG, kJPEG, kWebP };
+
+  struct Options {
+    Format format = Format::kPNG;
+    // Quality of the JPEG and WebP encodings, between 0 and 100.
+    int quality = 90;
+    // Height of the strips in DIP, 0 captures the area at once.
+    int tile_height = 0;
+  };
+
+  PageCapturer(content::WebContents* web_contents,
+               gin_helper::Promise<v8::Local<v8::Value>> promise,
+               const Options& options);
+  ~PageCapturer() override;
+
+  void Capture(const gfx::Rect& rect);
+
+  // Returns the size of the bitmap capturing |size| DIP of |view|, which
+  // includes all the pixel detail available on the current display.
+  static gfx::Size GetBitmapSize(content::RenderWidgetHostView* view,
+                                 const gfx::Size& size);
+
+ private:
+  void CaptureNextTile();
+  void OnTileCaptured(const gfx::Rect& tile, const SkBitmap& bitmap);
+  void OnTileEncoded(const gfx::Rect& tile, std::vector<unsigned char> data);
+  void Finish();
+
+  // content::WebContentsObserver:
+  void WebContentsDestroyed() override;
+
+  gin_helper::Promise<v8::Local<v8::Value>> promise_;
+  Options options_;
+  gfx::Rect rect_;
+  int next_y_ = 0;
+  std::vector<std::pair<gfx::Rect, std::vector<unsigned char>>> tiles_;
+
+  base::WeakPtrFactory<PageCapturer> weak_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(PageCapturer);
+};
+
+}  // namespace api
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_API_PAGE_CAPTURER_H_
@@ -9,6 +9,19 @@
 
 #include "base/optional.h"
 
+#if defined(OS_LINUX)
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_split.h"
+#include "base/threading/thread_restrictions.h"
+#endif
+
 #if defined(OS_WIN)
 #include <windows.h>
 
@@ -48,6 +61,32 @@ base::Optional<mach_task_basic_info_data_t> GetTaskInfo(mach_port_t task) {
 
 #endif  // defined(OS_MACOSX)
 
+#if defined(OS_LINUX)
+
+namespace {
+
+// Parses the "Name:   1234 kB" lines of a /proc file, returns the sizes in
+// bytes keyed by name.
+std::map<std::string, size_t> ParseProcSizes(const std::string& content) {
+  std::map<std::string, size_t> sizes;
+  for (base::StringPiece line : base::SplitStringPiece(
+           content, "\n", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY)) {
+    std::vector<base::StringPiece> tokens = base::SplitStringPiece(
+        line, " \t", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+    size_t size;
+    if (tokens.size() == 3 && tokens[0].ends_with(":") && tokens[2] == "kB" &&
+        base::StringToSizeT(tokens[1], &size)) {
+      tokens[0].remove_suffix(1);
+      sizes[tokens[0].as_string()] = size << 10;
+    }
+  }
+  return sizes;
+}
+
+}  // namespace
+
+#endif  // defined(OS_LINUX)
+
 namespace electron {
 
 ProcessMetric::ProcessMetric(int type,
@@ -68,6 +107,12 @@ ProcessMetric::ProcessMetric(int type,
 
 ProcessMetric::~ProcessMetric() = default;
 
+#if !defined(OS_WIN)
+int ProcessMetric::GetHandleCount() const {
+  return metrics->GetOpenFdCount();
+}
+#endif
+
 #if defined(OS_WIN)
 
 ProcessMemoryInfo ProcessMetric::GetMemoryInfo() const {
@@ -85,6 +130,13 @@ ProcessMemoryInfo ProcessMetric::GetMemoryInfo() const {
   return result;
 }
 
+int ProcessMetric::GetHandleCount() const {
+  DWORD handle_count = 0;
+  if (!::GetProcessHandleCount(process.Handle(), &handle_count))
+    return -1;
+  return static_cast<int>(handle_count);
+}
+
 ProcessIntegrityLevel ProcessMetric::GetIntegrityLevel() const {
   HANDLE token = nullptr;
   if (!::OpenProcessToken(process.Handle(), TOKEN_QUERY, &token)) {
@@ -163,6 +215,37 @@ bool ProcessMetric::IsSandboxed() const {
 #endif
 }
 
-#endif  // defined(OS_MACOSX)
+#elif defined(OS_LINUX)
+
+ProcessMemoryInfo ProcessMetric::GetMemoryInfo() const {
+  ProcessMemoryInfo result;
+
+  // Reading /proc doesn't hit the disk.
+  base::ThreadRestrictions::ScopedAllowIO allow_io;
+  const base::FilePath proc_dir =
+      base::FilePath("/proc").Append(base::NumberToString(process.Pid()));
+
+  std::string content;
+  if (base::ReadFileToString(proc_dir.Append("status"), &content)) {
+    auto sizes = ParseProcSizes(content);
+    result.working_set_size = sizes["VmRSS"];
+    result.peak_working_set_size = sizes["VmHWM"];
+    result.private_bytes = sizes["RssAnon"];
+    result.shared_bytes = sizes["RssFile"] + sizes["RssShmem"];
+  }
+
+  // The kernel sums up the mappings of smaps into smaps_rollup, which is only
+  // readable by processes allowed to ptrace the process.
+  if (base::ReadFileToString(proc_dir.Append("smaps_rollup"), &content)) {
+    auto sizes = ParseProcSizes(content);
+    result.proportional_set_size = sizes["Pss"];
+    result.private_bytes = sizes["Private_Clean"] + sizes["Private_Dirty"];
+    result.shared_bytes = sizes["Shared_Clean"] + sizes["Shared_Dirty"];
+  }
+
+  return result;
+}
+
+#endif  // defined(OS_LINUX)
 
 }  // namespace electron
@@ -13,15 +13,18 @@
 
 namespace electron {
 
-#if !defined(OS_LINUX)
 struct ProcessMemoryInfo {
   size_t working_set_size = 0;
   size_t peak_working_set_size = 0;
-#if defined(OS_WIN)
+#if defined(OS_WIN) || defined(OS_LINUX)
   size_t private_bytes = 0;
 #endif
-};
+#if defined(OS_LINUX)
+  size_t shared_bytes = 0;
+  // Only known when /proc/<pid>/smaps_rollup can be read.
+  size_t proportional_set_size = 0;
 #endif
+};
 
 #if defined(OS_WIN)
 enum class ProcessIntegrityLevel {
@@ -43,9 +46,11 @@ struct ProcessMetric {
                 std::unique_ptr<base::ProcessMetrics> metrics);
   ~ProcessMetric();
 
-#if !defined(OS_LINUX)
   ProcessMemoryInfo GetMemoryInfo() const;
-#endif
+
+  // Returns the number of open file descriptors, or of handles on Windows,
+  // -1 when it is unknown.
+  int GetHandleCount() const;
 
 #if defined(OS_WIN)
   ProcessIntegrityLevel GetIntegrityLevel() const;
@@ -0,0 +1,262 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/process_metrics_sampler.h"
+
+#include "base/bind.h"
+#include "base/process/process_handle.h"
+#include "base/system/sys_info.h"
+#include "base/task/post_task.h"
+#include "base/task_runner_util.h"
+
+#if defined(OS_MACOSX)
+#include "content/public/browser/browser_child_process_host.h"
+#endif
+
+namespace electron {
+
+// Owns the metrics of the sampled processes, lives on the sampler's task
+// runner.
+class ProcessMetricsSampler::Collector {
+ public:
+  Collector() = default;
+  ~Collector() = default;
+
+  void AddProcess(int type, base::Process process) {
+    base::ProcessId pid = process.Pid();
+    std::unique_ptr<base::ProcessMetrics> metrics;
+    if (pid == base::GetCurrentProcId()) {
+      metrics = base::ProcessMetrics::CreateCurrentProcessMetrics();
+    } else {
+#if defined(OS_MACOSX)
+      auto* port_provider = content::BrowserChildProcessHost::GetPortProvider();
+      metrics = base::ProcessMetrics::CreateProcessMetrics(process.Handle(),
+                                                           port_provider);
+#else
+      metrics = base::ProcessMetrics::CreateProcessMetrics(process.Handle());
+#endif
+    }
+    auto metric = std::make_unique<ProcessMetric>(type, process.Handle(),
+                                                  std::move(metrics));
+    // The usages are computed between two calls, so the first sample of the
+    // process already has a meaningful value.
+    metric->metrics->GetPlatformIndependentCPUUsage();
+#if !defined(OS_WIN)
+    metric->metrics->GetIdleWakeupsPerSecond();
+#endif
+    processes_[pid] = std::move(metric);
+  }
+
+  void RemoveProcess(base::ProcessId pid) { processes_.erase(pid); }
+
+  std::vector<ProcessMetricsSample> Collect() {
+    const int processor_count = base::SysInfo::NumberOfProcessors();
+    const base::Time now = base::Time::Now();
+    std::vector<ProcessMetricsSample> samples;
+    samples.reserve(processes_.size());
+    for (const auto& process : processes_) {
+      const ProcessMetric& metric = *process.second;
+      ProcessMetricsSample sample;
+      sample.pid = process.first;
+      sample.type = metric.type;
+      sample.time = now;
+      sample.percent_cpu_usage =
+          metric.metrics->GetPlatformIndependentCPUUsage() / processor_count;
+#if !defined(OS_WIN)
+      // Not implemented on Windows, see App::GetAppMetrics.
+      sample.idle_wakeups_per_second =
+          metric.metrics->GetIdleWakeupsPerSecond();
+#endif
+      sample.memory = metric.GetMemoryInfo();
+      sample.handle_count = metric.GetHandleCount();
+      samples.push_back(sample);
+    }
+    return samples;
+  }
+
+ private:
+  std::map<base::ProcessId, std::unique_ptr<ProcessMetric>> processes_;
+
+  DISALLOW_COPY_AND_ASSIGN(Collector);
+};
+
+ProcessMetricsSampler::History::History(size_t size) : size_(size) {
+  samples_.reserve(size);
+}
+
+ProcessMetricsSampler::History::~History() = default;
+
+void ProcessMetricsSampler::History::Add(const ProcessMetricsSample& sample) {
+  if (samples_.size() < size_)
+    samples_.push_back(sample);
+  else
+    samples_[next_] = sample;
+  next_ = (next_ + 1) % size_;
+}
+
+std::vector<ProcessMetricsSample> ProcessMetricsSampler::History::GetSamples()
+    const {
+  std::vector<ProcessMetricsSample> samples;
+  samples.reserve(samples_.size());
+  // Once the buffer is full, |next_| is the oldest sample.
+  const size_t oldest = samples_.size() < size_ ? 0 : next_;
+  for (size_t i = 0; i < samples_.size(); ++i)
+    samples.push_back(samples_[(oldest + i) % samples_.size()]);
+  return samples;
+}
+
+const ProcessMetricsSample* ProcessMetricsSampler::History::GetLatest() const {
+  if (samples_.empty())
+    return nullptr;
+  return &samples_[(next_ + size_ - 1) % size_];
+}
+
+ProcessMetricsSampler::ProcessMetricsSampler(
+    const Options& options,
+    const ThresholdCallback& threshold_callback)
+    : options_(options),
+      threshold_callback_(threshold_callback),
+      task_runner_(base::CreateSequencedTaskRunner(
+          {base::ThreadPool(), base::MayBlock(),
+           base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})),
+      collector_(new Collector, base::OnTaskRunnerDeleter(task_runner_)) {
+  DCHECK_GT(options_.history_size, 0u);
+  timer_.Start(FROM_HERE, options_.interval,
+               base::BindRepeating(&ProcessMetricsSampler::Sample,
+                                   base::Unretained(this)));
+}
+
+ProcessMetricsSampler::~ProcessMetricsSampler() = default;
+
+void ProcessMetricsSampler::AddProcess(int type, const base::Process& process) {
+  histories_.emplace(process.Pid(), History(options_.history_size));
+  // The collector is deleted on the task runner after the pending tasks, so
+  // it can be referenced unretained.
+  task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(&Collector::AddProcess,
+                     base::Unretained(collector_.get()), type,
+                     process.Duplicate()));
+}
+
+void ProcessMetricsSampler::RemoveProcess(base::ProcessId pid) {
+  histories_.erase(pid);
+  for (auto it = exceeded_.begin(); it != exceeded_.end();) {
+    if (it->first == pid)
+      it = exceeded_.erase(it);
+    else
+      ++it;
+  }
+  task_runner_->PostTask(FROM_HERE,
+                         base::BindOnce(&Collector::RemoveProcess,
+                                        base::Unretained(collector_.get()),
+                                        pid));
+}
+
+std::vector<ProcessMetricsSample> ProcessMetricsSampler::GetHistory(
+    base::ProcessId pid) const {
+  auto it = histories_.find(pid);
+  if (it == histories_.end())
+    return std::vector<ProcessMetricsSample>();
+  return it->second.GetSamples();
+}
+
+std::vector<ProcessMetricsSample> ProcessMetricsSampler::GetLatestSamples()
+    const {
+  std::vector<ProcessMetricsSample> samples;
+  samples.reserve(histories_.size());
+  for (const auto& history : histories_) {
+    if (const auto* sample = history.second.GetLatest())
+      samples.push_back(*sample);
+  }
+  return samples;
+}
+
+// static
+bool ProcessMetricsSampler::GetMetricValue(const ProcessMetricsSample& sample,
+                                           const std::string& metric,
+                                           double* value) {
+  if (metric == "percentCPUUsage") {
+    *value = sample.percent_cpu_usage;
+  } else if (metric == "idleWakeupsPerSecond") {
+    *value = sample.idle_wakeups_per_second;
+  } else if (metric == "workingSetSize") {
+    *value = static_cast<double>(sample.memory.working_set_size >> 10);
+  } else if (metric == "peakWorkingSetSize") {
+    *value = static_cast<double>(sample.memory.peak_working_set_size >> 10);
+#if defined(OS_WIN) || defined(OS_LINUX)
+  } else if (metric == "privateBytes") {
+    *value = static_cast<double>(sample.memory.private_bytes >> 10);
+#endif
+#if defined(OS_LINUX)
+  } else if (metric == "sharedBytes") {
+    *value = static_cast<double>(sample.memory.shared_bytes >> 10);
+  } else if (metric == "proportionalSetSize") {
+    *value = static_cast<double>(sample.memory.proportional_set_size >> 10);
+#endif
+  } else if (metric == "handleCount" && sample.handle_count >= 0) {
+    *value = sample.handle_count;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+void ProcessMetricsSampler::Sample() {
+  // Skip the tick when the previous one hasn't been collected yet.
+  if (sampling_)
+    return;
+  sampling_ = true;
+  base::PostTaskAndReplyWithResult(
+      task_runner_.get(), FROM_HERE,
+      base::BindOnce(&Collector::Collect, base::Unretained(collector_.get())),
+      base::BindOnce(&ProcessMetricsSampler::OnSampled,
+                     weak_factory_.GetWeakPtr()));
+}
+
+void ProcessMetricsSampler::OnSampled(
+    std::vector<ProcessMetricsSample> samples) {
+  sampling_ = false;
+  // Record everything before calling out, the callback may delete |this|.
+  std::vector<ProcessMetricsSample> recorded;
+  for (const auto& sample : samples) {
+    auto it = histories_.find(sample.pid);
+    // The process was removed while it was being sampled.
+    if (it == histories_.end())
+      continue;
+    it->second.Add(sample);
+    recorded.push_back(sample);
+  }
+
+  auto weak_this = weak_factory_.GetWeakPtr();
+  for (const auto& sample : recorded) {
+    CheckThresholds(sample);
+    if (!weak_this)
+      return;
+  }
+}
+
+void ProcessMetricsSampler::CheckThresholds(
+    const ProcessMetricsSample& sample) {
+  auto weak_this = weak_factory_.GetWeakPtr();
+  // Copied since the callback may delete the sampler.
+  const auto thresholds = options_.thresholds;
+  const auto callback = threshold_callback_;
+  for (const auto& threshold : thresholds) {
+    double value;
+    if (!GetMetricValue(sample, threshold.first, &value))
+      continue;
+    auto key = std::make_pair(sample.pid, threshold.first);
+    if (value <= threshold.second) {
+      exceeded_.erase(key);
+    } else if (exceeded_.insert(key).second) {
+      callback.Run(sample, threshold.first, value, threshold.second);
+      if (!weak_this)
+        return;
+    }
+  }
+}
+
+}  // namespace electron
@@ -0,0 +1,125 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_API_PROCESS_METRICS_SAMPLER_H_
+#define SHELL_BROWSER_API_PROCESS_METRICS_SAMPLER_H_
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "base/process/process.h"
+#include "base/sequenced_task_runner.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "shell/browser/api/process_metric.h"
+
+namespace electron {
+
+struct ProcessMetricsSample {
+  base::ProcessId pid = base::kNullProcessId;
+  int type = 0;
+  base::Time time;
+  double percent_cpu_usage = 0;
+  int idle_wakeups_per_second = 0;
+  ProcessMemoryInfo memory;
+  int handle_count = -1;
+};
+
+// Samples the metrics of the app's processes at a fixed interval, keeping the
+// latest samples of each process in a fixed-size ring buffer.
+//
+// The processes are inspected on a background sequence, so reading the
+// history and the sampling itself never block the UI thread on the
+// platform's process APIs.
+class ProcessMetricsSampler {
+ public:
+  struct Options {
+    base::TimeDelta interval = base::TimeDelta::FromSeconds(1);
+    // Number of samples kept for each process.
+    size_t history_size = 60;
+    // Thresholds keyed by metric name, see GetMetricValue().
+    std::map<std::string, double> thresholds;
+  };
+
+  // Called when |metric| of a process goes above its |threshold|. It isn't
+  // called again for the same process and metric until the value went back
+  // below the threshold.
+  using ThresholdCallback =
+      base::RepeatingCallback<void(const ProcessMetricsSample& sample,
+                                   const std::string& metric,
+                                   double value,
+                                   double threshold)>;
+
+  ProcessMetricsSampler(const Options& options,
+                        const ThresholdCallback& threshold_callback);
+  ~ProcessMetricsSampler();
+
+  // Starts or stops sampling |process|.
+  void AddProcess(int type, const base::Process& process);
+  void RemoveProcess(base::ProcessId pid);
+
+  // Returns the samples of |pid| from the oldest to the newest.
+  std::vector<ProcessMetricsSample> GetHistory(base::ProcessId pid) const;
+
+  // Returns the newest sample of every process.
+  std::vector<ProcessMetricsSample> GetLatestSamples() const;
+
+  // Returns the value of the metric named like in the JS API, e.g.
+  // "percentCPUUsage" or "workingSetSize", memory sizes being in kilobytes.
+  // Returns false when there is no such metric on the current platform.
+  static bool GetMetricValue(const ProcessMetricsSample& sample,
+                             const std::string& metric,
+                             double* value);
+
+ private:
+  class Collector;
+
+  // A fixed-size ring buffer of samples.
+  class History {
+   public:
+    explicit History(size_t size);
+    ~History();
+
+    void Add(const ProcessMetricsSample& sample);
+    std::vector<ProcessMetricsSample> GetSamples() const;
+    const ProcessMetricsSample* GetLatest() const;
+
+   private:
+    size_t size_;
+    size_t next_ = 0;
+    std::vector<ProcessMetricsSample> samples_;
+  };
+
+  void Sample();
+  void OnSampled(std::vector<ProcessMetricsSample> samples);
+  void CheckThresholds(const ProcessMetricsSample& sample);
+
+  Options options_;
+  ThresholdCallback threshold_callback_;
+
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+  std::unique_ptr<Collector, base::OnTaskRunnerDeleter> collector_;
+
+  base::RepeatingTimer timer_;
+  bool sampling_ = false;
+
+  std::map<base::ProcessId, History> histories_;
+  // The process and metric pairs currently above their threshold.
+  std::set<std::pair<base::ProcessId, std::string>> exceeded_;
+
+  base::WeakPtrFactory<ProcessMetricsSampler> weak_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(ProcessMetricsSampler);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_API_PROCESS_METRICS_SAMPLER_H_
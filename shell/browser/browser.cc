@@ -23,6 +23,7 @@
 #include "shell/browser/window_list.h"
 #include "shell/common/application_info.h"
 #include "shell/common/gin_helper/arguments.h"
+#include "shell/common/startup_timeline.h"
 
 namespace electron {
 
@@ -167,6 +168,7 @@ void Browser::WillFinishLaunching() {
 }
 
 void Browser::DidFinishLaunching(base::DictionaryValue launch_info) {
+  startup_timeline::AddMark("ready");
   // Make sure the userData directory is created.
   base::ThreadRestrictions::ScopedAllowIO allow_io;
   base::FilePath user_data;
@@ -322,9 +322,17 @@ bool ElectronBrowserClient::ShouldForceNewSiteInstance(
   content::SiteInstance* speculative_instance =
       speculative_rfh ? speculative_rfh->GetSiteInstance() : nullptr;
   int process_id = current_instance->GetProcess()->GetID();
-  if (NavigationWasRedirectedCrossSite(browser_context, current_instance,
-                                       speculative_instance, url,
-                                       has_response_started)) {
+  auto* web_contents = content::WebContents::FromRenderFrameHost(current_rfh);
+  if (api::SpareWebContentsMarker::FromWebContents(web_contents) &&
+      !current_instance->HasSite() &&
+      current_rfh->GetLastCommittedURL().is_empty() &&
+      current_instance->GetProcess()->IsInitializedAndNotDead()) {
+    // The renderer was launched by the spare renderer pool of the session
+    // before anything was loaded, so there is nothing to restart it for.
+    return false;
+  } else if (NavigationWasRedirectedCrossSite(
+                 browser_context, current_instance, speculative_instance, url,
+                 has_response_started)) {
     // Navigation was redirected. We can't force the current, speculative or a
     // new unrelated site instance to be used. Delegate to the content layer.
     return false;
@@ -337,7 +345,6 @@ bool ElectronBrowserClient::ShouldForceNewSiteInstance(
     // a new SiteInstance
     return true;
   } else {
-    auto* web_contents = content::WebContents::FromRenderFrameHost(current_rfh);
     if (!ChildWebContentsTracker::FromWebContents(web_contents)) {
       // Root WebContents should always create new process to make sure
       // native addons are loaded correctly after reload / navigation.
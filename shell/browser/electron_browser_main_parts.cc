@@ -43,13 +43,16 @@
 #include "shell/browser/javascript_environment.h"
 #include "shell/browser/media/media_capture_devices_dispatcher.h"
 #include "shell/browser/node_debugger.h"
+#include "shell/browser/script_code_cache.h"
 #include "shell/browser/ui/devtools_manager_delegate.h"
 #include "shell/common/api/electron_bindings.h"
 #include "shell/common/application_info.h"
 #include "shell/common/asar/asar_util.h"
+#include "shell/common/cpu_profile.h"
 #include "shell/common/gin_helper/trackable_object.h"
 #include "shell/common/node_bindings.h"
 #include "shell/common/node_includes.h"
+#include "shell/common/startup_timeline.h"
 #include "ui/base/idle/idle.h"
 #include "ui/base/material_design/material_design_controller.h"
 #include "ui/base/ui_base_switches.h"
@@ -266,6 +269,7 @@ void ElectronBrowserMainParts::RegisterDestructionCallback(
 }
 
 int ElectronBrowserMainParts::PreEarlyInitialization() {
+  startup_timeline::AddMark("pre-early-initialization");
   field_trial_list_ = std::make_unique<base::FieldTrialList>(nullptr);
 #if defined(USE_X11)
   views::LinuxUI::SetInstance(BuildGtkUi());
@@ -292,12 +296,14 @@ void ElectronBrowserMainParts::PostEarlyInitialization() {
   // The ProxyResolverV8 has setup a complete V8 environment, in order to
   // avoid conflicts we only initialize our V8 environment after that.
   js_env_ = std::make_unique<JavascriptEnvironment>(node_bindings_->uv_loop());
+  startup_timeline::AddMark("javascript-environment-created");
 
   node_bindings_->Initialize();
   // Create the global environment.
   node::Environment* env = node_bindings_->CreateEnvironment(
       js_env_->context(), js_env_->platform(), false);
   node_env_ = std::make_unique<NodeEnvironment>(env);
+  startup_timeline::AddMark("node-environment-created");
 
   /**
    * 🚨  🚨  🚨  🚨  🚨  🚨  🚨  🚨  🚨
@@ -325,6 +331,7 @@ void ElectronBrowserMainParts::PostEarlyInitialization() {
   // TODO(MarshallOfSound): Figured out a better way to init the inspector
   // before bootstrapping
   node::BootstrapEnvironment(env);
+  startup_timeline::AddMark("node-bootstrapped");
 
   /**
    * ✅  ✅  ✅  ✅  ✅  ✅  ✅
@@ -339,6 +346,7 @@ void ElectronBrowserMainParts::PostEarlyInitialization() {
 
   // Load everything.
   node_bindings_->LoadEnvironment(env);
+  startup_timeline::AddMark("main-script-loaded");
 
   // Wrap the uv loop with global env.
   node_bindings_->set_uv_env(env);
@@ -431,6 +439,7 @@ void ElectronBrowserMainParts::ToolkitInitialized() {
 }
 
 void ElectronBrowserMainParts::PreMainMessageLoopRun() {
+  startup_timeline::AddMark("pre-main-message-loop-run");
   // Run user's main script before most things get initialized, so we can have
   // a chance to setup everything.
   node_bindings_->PrepareMessageLoop();
@@ -470,6 +479,10 @@ void ElectronBrowserMainParts::PreMainMessageLoopRun() {
   if (command_line->HasSwitch(switches::kRemoteDebuggingPort))
     DevToolsManagerDelegate::StartHttpHandler();
 
+  // Read the preload code caches while the first renderers are starting, the
+  // main script has already had its chance to change the user data directory.
+  ScriptCodeCache::GetInstance()->Load();
+
 #if !defined(OS_MACOSX)
   // The corresponding call in macOS is in ElectronApplicationDelegate.
   Browser::Get()->WillFinishLaunching();
@@ -515,6 +528,9 @@ void ElectronBrowserMainParts::PostMainMessageLoopRun() {
 #endif
 
   node_debugger_->Stop();
+  // A profile that wasn't stopped is dropped, V8's sampling thread must not
+  // outlive the platform.
+  CancelCpuProfiling(js_env_->isolate());
   js_env_->OnMessageLoopDestroying();
 
 #if defined(OS_MACOSX)
@@ -15,6 +15,7 @@
 #include "content/public/common/content_switches.h"
 #include "gin/array_buffer.h"
 #include "gin/v8_initializer.h"
+#include "shell/browser/main_thread_monitor.h"
 #include "shell/browser/microtasks_runner.h"
 #include "shell/common/node_includes.h"
 #include "tracing/trace_event.h"
@@ -33,7 +34,10 @@ JavascriptEnvironment::JavascriptEnvironment(uv_loop_t* event_loop)
       locker_(isolate_),
       handle_scope_(isolate_),
       context_(isolate_, node::NewContext(isolate_)),
-      context_scope_(v8::Local<v8::Context>::New(isolate_, context_)) {}
+      context_scope_(v8::Local<v8::Context>::New(isolate_, context_)),
+      // Created before any JavaScript runs so the modules loaded at startup
+      // can observe it, it only sees tasks once the message loop exists.
+      main_thread_monitor_(std::make_unique<MainThreadMonitor>()) {}
 
 JavascriptEnvironment::~JavascriptEnvironment() = default;
 
@@ -70,10 +74,19 @@ void JavascriptEnvironment::OnMessageLoopCreated() {
   DCHECK(!microtasks_runner_);
   microtasks_runner_ = std::make_unique<MicrotasksRunner>(isolate());
   base::MessageLoopCurrent::Get()->AddTaskObserver(microtasks_runner_.get());
+  // Added after the microtasks runner so the tasks' durations include their
+  // microtasks checkpoint.
+  base::MessageLoopCurrent::Get()->AddTaskObserver(main_thread_monitor_.get());
+  // The queueing delays of the tasks that aren't delayed are computed from
+  // the time they were posted, which is only recorded on request.
+  base::MessageLoopCurrent::Get()->SetAddQueueTimeToTasks(true);
 }
 
 void JavascriptEnvironment::OnMessageLoopDestroying() {
   DCHECK(microtasks_runner_);
+  base::MessageLoopCurrent::Get()->SetAddQueueTimeToTasks(false);
+  base::MessageLoopCurrent::Get()->RemoveTaskObserver(
+      main_thread_monitor_.get());
   base::MessageLoopCurrent::Get()->RemoveTaskObserver(microtasks_runner_.get());
   platform_->DrainTasks(isolate_);
   platform_->UnregisterIsolate(isolate_);
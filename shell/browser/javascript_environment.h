@@ -18,6 +18,7 @@ class MultiIsolatePlatform;
 
 namespace electron {
 
+class MainThreadMonitor;
 class MicrotasksRunner;
 // Manage the V8 isolate and context automatically.
 class JavascriptEnvironment {
@@ -48,6 +49,7 @@ class JavascriptEnvironment {
   v8::Context::Scope context_scope_;
 
   std::unique_ptr<MicrotasksRunner> microtasks_runner_;
+  std::unique_ptr<MainThreadMonitor> main_thread_monitor_;
 
   DISALLOW_COPY_AND_ASSIGN(JavascriptEnvironment);
 };
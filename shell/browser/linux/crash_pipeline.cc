@@ -0,0 +1,563 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/linux/crash_pipeline.h"
+
+#include <inttypes.h>
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/files/file_enumerator.h"
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/logging.h"
+#include "base/no_destructor.h"
+#include "base/stl_util.h"
+#include "base/synchronization/atomic_flag.h"
+#include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/task/post_task.h"
+#include "base/task_runner_util.h"
+#include "base/values.h"
+#include "net/base/filename_util.h"
+#include "net/base/load_flags.h"
+#include "net/traffic_annotation/network_traffic_annotation.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/cpp/shared_url_loader_factory.h"
+#include "services/network/public/cpp/simple_url_loader.h"
+#include "shell/browser/browser.h"
+#include "shell/browser/electron_browser_main_parts.h"
+#include "shell/browser/net/system_network_context_manager.h"
+#include "shell/common/crash_reporter/crash_reporter.h"
+#include "third_party/zlib/google/compression_utils.h"
+
+namespace electron {
+
+namespace {
+
+const base::FilePath::CharType kPendingDirName[] = FILE_PATH_LITERAL("pending");
+const base::FilePath::CharType kIndexFileName[] =
+    FILE_PATH_LITERAL("crash-signatures.json");
+const base::FilePath::CharType kUploadsLogName[] =
+    FILE_PATH_LITERAL("uploads.log");
+const base::FilePath::CharType kReportPattern[] = FILE_PATH_LITERAL("*.dmp");
+
+// Reports younger than this may still be written by the crashing process.
+constexpr base::TimeDelta kSettleTime = base::TimeDelta::FromSeconds(5);
+
+// Far above the reports of minidumps capped by the crash reporter.
+const int64_t kMaxReportSize = 16 * 1024 * 1024;
+
+constexpr base::TimeDelta kMaxBackoff = base::TimeDelta::FromHours(6);
+constexpr base::TimeDelta kUploadTimeout = base::TimeDelta::FromMinutes(1);
+
+// The server answers with the id of the report.
+const size_t kMaxResponseSize = 1024;
+const size_t kMaxReportIdLength = 64;
+
+const net::NetworkTrafficAnnotationTag kTrafficAnnotation =
+    net::DefineNetworkTrafficAnnotation("electron_crash_pipeline", R"(
+        semantics {
+          sender: "Electron Crash Reporter"
+          description:
+            "Uploads the crash reports kept by the crash reporter of the app."
+          trigger: "The app or one of its processes crashed."
+          data: "Minidumps and the parameters given to the crash reporter."
+          destination: OTHER
+        }
+        policy {
+          cookies_allowed: NO
+          setting: "Set with crashReporter.setUploadToServer()."
+        })");
+
+CrashPipeline* g_crash_pipeline = nullptr;
+
+// The stores of successive pipelines share a sequence, so they never access
+// the crashes directory at the same time. It blocks shutdown so an uploaded
+// report is always deleted, instead of being uploaded again by the next
+// session; the stores skip the sorting once their pipeline is gone.
+scoped_refptr<base::SequencedTaskRunner> GetStoreTaskRunner() {
+  static base::NoDestructor<scoped_refptr<base::SequencedTaskRunner>>
+      task_runner(base::CreateSequencedTaskRunner(
+          {base::ThreadPool(), base::MayBlock(),
+           base::TaskPriority::BEST_EFFORT,
+           base::TaskShutdownBehavior::BLOCK_SHUTDOWN}));
+  return *task_runner;
+}
+
+// Identifies a report in uploads.log when the server doesn't return an id,
+// or when it is exported: the name of the pending report, without extension.
+std::string GetLocalReportId(const base::FilePath& path) {
+  return path.BaseName().RemoveExtension().value();
+}
+
+base::Value SummaryToValue(const CrashSignatureSummary& summary) {
+  base::Value value(base::Value::Type::DICTIONARY);
+  value.SetStringKey("id", summary.id);
+  value.SetStringKey("processType", summary.signature.process_type);
+  value.SetDoubleKey("exceptionCode", summary.signature.exception_code);
+  value.SetStringKey("module", summary.signature.module);
+  value.SetStringKey("debugId", summary.signature.debug_id);
+  value.SetDoubleKey("offset", static_cast<double>(summary.signature.offset));
+  value.SetStringKey("symbol", summary.symbol);
+  value.SetIntKey("count", summary.count);
+  value.SetIntKey("droppedCount", summary.dropped_count);
+  value.SetIntKey("pendingCount", summary.pending_count);
+  value.SetIntKey("uploadedCount", summary.uploaded_count);
+  value.SetDoubleKey("firstSeen", summary.first_seen.ToJsTime());
+  value.SetDoubleKey("lastSeen", summary.last_seen.ToJsTime());
+  base::Value accepted_times(base::Value::Type::LIST);
+  for (const auto& time : summary.accepted_times)
+    accepted_times.GetList().emplace_back(time.ToJsTime());
+  value.SetKey("acceptedTimes", std::move(accepted_times));
+  return value;
+}
+
+bool SummaryFromValue(const base::Value& value,
+                      CrashSignatureSummary* summary) {
+  if (!value.is_dict())
+    return false;
+  const std::string* id = value.FindStringKey("id");
+  const std::string* process_type = value.FindStringKey("processType");
+  const std::string* module = value.FindStringKey("module");
+  const std::string* debug_id = value.FindStringKey("debugId");
+  const std::string* symbol = value.FindStringKey("symbol");
+  if (!id || !process_type || !module || !debug_id || !symbol)
+    return false;
+  summary->id = *id;
+  summary->signature.process_type = *process_type;
+  summary->signature.exception_code =
+      static_cast<uint32_t>(value.FindDoubleKey("exceptionCode").value_or(0));
+  summary->signature.module = *module;
+  summary->signature.debug_id = *debug_id;
+  summary->signature.offset =
+      static_cast<uint64_t>(value.FindDoubleKey("offset").value_or(0));
+  summary->symbol = *symbol;
+  summary->count = value.FindIntKey("count").value_or(0);
+  summary->dropped_count = value.FindIntKey("droppedCount").value_or(0);
+  summary->pending_count = value.FindIntKey("pendingCount").value_or(0);
+  summary->uploaded_count = value.FindIntKey("uploadedCount").value_or(0);
+  summary->first_seen =
+      base::Time::FromJsTime(value.FindDoubleKey("firstSeen").value_or(0));
+  summary->last_seen =
+      base::Time::FromJsTime(value.FindDoubleKey("lastSeen").value_or(0));
+  if (const base::Value* accepted_times = value.FindListKey("acceptedTimes")) {
+    for (const auto& time : accepted_times->GetList()) {
+      if (time.is_double() || time.is_int())
+        summary->accepted_times.push_back(
+            base::Time::FromJsTime(time.GetDouble()));
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+CrashSignatureSummary::CrashSignatureSummary() = default;
+CrashSignatureSummary::CrashSignatureSummary(const CrashSignatureSummary&) =
+    default;
+CrashSignatureSummary::~CrashSignatureSummary() = default;
+
+// Owns the reports of the crashes directory and the index of their
+// signatures, lives on the store's task runner.
+//
+// The reports saved by the crash reporter are sorted into a "pending"
+// subdirectory, named after their signature, or deleted.
+class CrashPipeline::Store {
+ public:
+  Store(const base::FilePath& crashes_dir, const Options& options)
+      : crashes_dir_(crashes_dir),
+        pending_dir_(crashes_dir.Append(kPendingDirName)),
+        options_(options) {}
+  ~Store() = default;
+
+  // Called on the UI thread when the pipeline is destroyed, the tasks still
+  // queued then only record the uploads.
+  void Stop() { stopped_.Set(); }
+
+  // Sorts the new reports, and returns the oldest pending ones up to
+  // |max_uploads|.
+  std::vector<Upload> ProcessReports(size_t max_uploads) {
+    if (stopped_.IsSet())
+      return std::vector<Upload>();
+    Load();
+    const base::Time now = base::Time::Now();
+    bool changed = false;
+    base::FileEnumerator reports(crashes_dir_, false,
+                                 base::FileEnumerator::FILES, kReportPattern);
+    for (base::FilePath path = reports.Next(); !path.empty();
+         path = reports.Next()) {
+      const auto info = reports.GetInfo();
+      if (now - info.GetLastModifiedTime() < kSettleTime)
+        continue;
+      AddReport(path, info.GetSize(), info.GetLastModifiedTime(), now);
+      changed = true;
+    }
+    if (DropExtraReports())
+      changed = true;
+    if (changed)
+      Save();
+    return ReadUploads(max_uploads);
+  }
+
+  std::vector<CrashSignatureSummary> GetSignatures() {
+    ProcessReports(0);
+    std::vector<CrashSignatureSummary> signatures;
+    signatures.reserve(signatures_.size());
+    for (const auto& signature : signatures_)
+      signatures.push_back(signature.second);
+    std::stable_sort(signatures.begin(), signatures.end(),
+                     [](const auto& a, const auto& b) {
+                       return a.count > b.count;
+                     });
+    return signatures;
+  }
+
+  // Copies |upload| into |dir|, for endpoints that are local directories.
+  bool Export(const base::FilePath& dir, const Upload& upload) {
+    // The reply would be dropped, and the report exported again.
+    if (stopped_.IsSet())
+      return false;
+    base::FilePath path = dir.Append(upload.path.BaseName());
+    if (options_.compress)
+      path = path.AddExtension(FILE_PATH_LITERAL("gz"));
+    return base::CreateDirectory(dir) &&
+           base::WriteFile(path, upload.body.data(), upload.body.size()) ==
+               static_cast<int>(upload.body.size());
+  }
+
+  void OnUploaded(const Upload& upload, const std::string& report_id) {
+    base::DeleteFile(upload.path, false);
+    auto it = signatures_.find(upload.signature_id);
+    if (it != signatures_.end()) {
+      it->second.pending_count = std::max(it->second.pending_count - 1, 0);
+      it->second.uploaded_count++;
+      Save();
+    }
+
+    // Keep crashReporter.getUploadedReports() working, like the crash
+    // reporter does when it uploads by itself.
+    const base::FilePath log_path = crashes_dir_.Append(kUploadsLogName);
+    const std::string line = base::StringPrintf(
+        "%" PRId64 ",%s\n", static_cast<int64_t>(base::Time::Now().ToTimeT()),
+        report_id.c_str());
+    if (!base::PathExists(log_path))
+      base::WriteFile(log_path, line.data(), line.size());
+    else
+      base::AppendToFile(log_path, line.data(), line.size());
+  }
+
+ private:
+  void Load() {
+    if (loaded_)
+      return;
+    loaded_ = true;
+    base::CreateDirectory(pending_dir_);
+    std::string json;
+    if (!base::ReadFileToString(crashes_dir_.Append(kIndexFileName), &json))
+      return;
+    base::Optional<base::Value> index = base::JSONReader::Read(json);
+    if (!index || !index->is_list())
+      return;
+    for (const auto& value : index->GetList()) {
+      CrashSignatureSummary summary;
+      if (SummaryFromValue(value, &summary))
+        signatures_[summary.id] = summary;
+    }
+  }
+
+  void Save() {
+    base::Value index(base::Value::Type::LIST);
+    for (const auto& signature : signatures_)
+      index.GetList().push_back(SummaryToValue(signature.second));
+    std::string json;
+    if (base::JSONWriter::Write(index, &json)) {
+      base::ImportantFileWriter::WriteFileAtomically(
+          crashes_dir_.Append(kIndexFileName), json);
+    }
+  }
+
+  void AddReport(const base::FilePath& path,
+                 int64_t size,
+                 base::Time time,
+                 base::Time now) {
+    std::string data;
+    crash_reporter::CrashReportFile report;
+    crash_reporter::CrashSignature signature;
+    if (size > kMaxReportSize || !base::ReadFileToString(path, &data) ||
+        !crash_reporter::ParseCrashReportFile(data, &report) ||
+        !crash_reporter::ComputeCrashSignature(report.minidump, &signature)) {
+      LOG(WARNING) << "Dropping invalid crash report " << path.value();
+      base::DeleteFile(path, false);
+      return;
+    }
+    signature.process_type = report.crash_keys["process_type"];
+
+    const std::string id = signature.GetId();
+    CrashSignatureSummary& summary = signatures_[id];
+    if (summary.id.empty()) {
+      summary.id = id;
+      summary.signature = signature;
+      // Only done once per signature, the symbol files being large.
+      summary.symbol = crash_reporter::SymbolizeCrashSignature(
+          options_.symbols_dir, signature);
+      summary.first_seen = time;
+    }
+    summary.count++;
+    summary.first_seen = std::min(summary.first_seen, time);
+    summary.last_seen = std::max(summary.last_seen, time);
+
+    const base::TimeDelta window = options_.rate_limit_window;
+    base::EraseIf(summary.accepted_times, [&](base::Time accepted) {
+      return now - accepted >= window;
+    });
+    if (summary.accepted_times.size() <
+            static_cast<size_t>(options_.max_reports_per_signature) &&
+        base::Move(path, pending_dir_.Append(id + "-" +
+                                             path.BaseName().value()))) {
+      summary.accepted_times.push_back(time);
+      summary.pending_count++;
+    } else {
+      base::DeleteFile(path, false);
+      summary.dropped_count++;
+    }
+  }
+
+  // Returns the pending reports from the oldest to the newest.
+  std::vector<base::FilePath> GetPendingReports() {
+    std::vector<std::pair<base::Time, base::FilePath>> reports;
+    base::FileEnumerator enumerator(pending_dir_, false,
+                                    base::FileEnumerator::FILES,
+                                    kReportPattern);
+    for (base::FilePath path = enumerator.Next(); !path.empty();
+         path = enumerator.Next()) {
+      reports.emplace_back(enumerator.GetInfo().GetLastModifiedTime(), path);
+    }
+    std::sort(reports.begin(), reports.end());
+    std::vector<base::FilePath> paths;
+    paths.reserve(reports.size());
+    for (auto& report : reports)
+      paths.push_back(std::move(report.second));
+    return paths;
+  }
+
+  // Returns the signature id a pending report is named after.
+  static std::string GetSignatureId(const base::FilePath& path) {
+    const std::string name = path.BaseName().value();
+    return name.substr(0, name.find('-'));
+  }
+
+  // Deletes the oldest pending reports beyond the maximum, which are there
+  // when the endpoint has been failing for a while.
+  bool DropExtraReports() {
+    std::vector<base::FilePath> reports = GetPendingReports();
+    if (reports.size() <= options_.max_pending_reports)
+      return false;
+    const size_t extra = reports.size() - options_.max_pending_reports;
+    for (size_t i = 0; i < extra; ++i) {
+      base::DeleteFile(reports[i], false);
+      auto it = signatures_.find(GetSignatureId(reports[i]));
+      if (it != signatures_.end()) {
+        it->second.pending_count = std::max(it->second.pending_count - 1, 0);
+        it->second.dropped_count++;
+      }
+    }
+    return true;
+  }
+
+  std::vector<Upload> ReadUploads(size_t max_uploads) {
+    std::vector<Upload> uploads;
+    if (max_uploads == 0)
+      return uploads;
+    for (const auto& path : GetPendingReports()) {
+      std::string data;
+      crash_reporter::CrashReportFile report;
+      if (!base::ReadFileToString(path, &data) ||
+          !crash_reporter::ParseCrashReportFile(data, &report))
+        continue;
+      Upload upload;
+      upload.path = path;
+      upload.signature_id = GetSignatureId(path);
+      upload.boundary = report.boundary;
+      if (!options_.compress)
+        upload.body = std::move(data);
+      else if (!compression::GzipCompress(data, &upload.body))
+        continue;
+      uploads.push_back(std::move(upload));
+      if (uploads.size() == max_uploads)
+        break;
+    }
+    return uploads;
+  }
+
+  base::FilePath crashes_dir_;
+  base::FilePath pending_dir_;
+  Options options_;
+
+  bool loaded_ = false;
+  std::map<std::string, CrashSignatureSummary> signatures_;
+
+  base::AtomicFlag stopped_;
+
+  DISALLOW_COPY_AND_ASSIGN(Store);
+};
+
+// static
+void CrashPipeline::Start(const base::FilePath& crashes_dir,
+                          const Options& options) {
+  static bool shutdown_registered = false;
+  if (!shutdown_registered) {
+    shutdown_registered = true;
+    ElectronBrowserMainParts::Get()->RegisterDestructionCallback(
+        base::BindOnce(&CrashPipeline::Shutdown));
+  }
+  delete g_crash_pipeline;
+  g_crash_pipeline = new CrashPipeline(crashes_dir, options);
+}
+
+// static
+CrashPipeline* CrashPipeline::Get() {
+  return g_crash_pipeline;
+}
+
+// static
+void CrashPipeline::Shutdown() {
+  delete g_crash_pipeline;
+  g_crash_pipeline = nullptr;
+}
+
+CrashPipeline::CrashPipeline(const base::FilePath& crashes_dir,
+                             const Options& options)
+    : options_(options),
+      task_runner_(GetStoreTaskRunner()),
+      store_(new Store(crashes_dir, options),
+             base::OnTaskRunnerDeleter(task_runner_)) {
+  // Sort the reports left by the previous sessions right away.
+  timer_.Start(FROM_HERE, base::TimeDelta(),
+               base::BindOnce(&CrashPipeline::Run, base::Unretained(this)));
+}
+
+CrashPipeline::~CrashPipeline() {
+  store_->Stop();
+}
+
+void CrashPipeline::GetSignatures(SignaturesCallback callback) {
+  // The store is deleted on the task runner after the pending tasks, so it
+  // can be referenced unretained.
+  base::PostTaskAndReplyWithResult(
+      task_runner_.get(), FROM_HERE,
+      base::BindOnce(&Store::GetSignatures, base::Unretained(store_.get())),
+      std::move(callback));
+}
+
+void CrashPipeline::ScheduleNextRun() {
+  base::TimeDelta delay = options_.upload_interval;
+  for (int i = 0; i < consecutive_failures_ && delay < kMaxBackoff; ++i)
+    delay = std::min(delay * 2, kMaxBackoff);
+  timer_.Start(FROM_HERE, delay,
+               base::BindOnce(&CrashPipeline::Run, base::Unretained(this)));
+}
+
+void CrashPipeline::Run() {
+  // The reports are still sorted when they can't be uploaded, so the disk
+  // usage stays bounded.
+  const bool can_upload =
+      options_.upload_url.is_valid() && Browser::Get()->is_ready() &&
+      crash_reporter::CrashReporter::GetInstance()->GetUploadToServer();
+  base::PostTaskAndReplyWithResult(
+      task_runner_.get(), FROM_HERE,
+      base::BindOnce(&Store::ProcessReports, base::Unretained(store_.get()),
+                     can_upload ? options_.batch_size : 0),
+      base::BindOnce(&CrashPipeline::OnReportsProcessed,
+                     weak_factory_.GetWeakPtr()));
+}
+
+void CrashPipeline::OnReportsProcessed(std::vector<Upload> uploads) {
+  uploads_ = std::move(uploads);
+  UploadNext();
+}
+
+void CrashPipeline::UploadNext() {
+  if (uploads_.empty()) {
+    ScheduleNextRun();
+    return;
+  }
+  const Upload& upload = uploads_.front();
+
+  base::FilePath export_dir;
+  if (net::FileURLToFilePath(options_.upload_url, &export_dir)) {
+    base::PostTaskAndReplyWithResult(
+        task_runner_.get(), FROM_HERE,
+        base::BindOnce(&Store::Export, base::Unretained(store_.get()),
+                       export_dir, upload),
+        base::BindOnce(&CrashPipeline::OnExported,
+                       weak_factory_.GetWeakPtr()));
+    return;
+  }
+
+  auto request = std::make_unique<network::ResourceRequest>();
+  request->url = options_.upload_url;
+  request->method = "POST";
+  request->load_flags = net::LOAD_DISABLE_CACHE;
+  request->credentials_mode = network::mojom::CredentialsMode::kOmit;
+  if (options_.compress)
+    request->headers.SetHeader("Content-Encoding", "gzip");
+  loader_ = network::SimpleURLLoader::Create(std::move(request),
+                                             kTrafficAnnotation);
+  loader_->AttachStringForUpload(
+      upload.body, "multipart/form-data; boundary=" + upload.boundary);
+  loader_->SetTimeoutDuration(kUploadTimeout);
+  loader_->DownloadToString(
+      SystemNetworkContextManager::GetInstance()
+          ->GetSharedURLLoaderFactory()
+          .get(),
+      base::BindOnce(&CrashPipeline::OnUploadComplete, base::Unretained(this)),
+      kMaxResponseSize);
+}
+
+void CrashPipeline::OnUploadComplete(
+    std::unique_ptr<std::string> response_body) {
+  loader_.reset();
+  if (!response_body) {
+    OnUploadFailed();
+    return;
+  }
+  std::string report_id;
+  base::TrimWhitespaceASCII(*response_body, base::TRIM_ALL, &report_id);
+  if (report_id.empty() || report_id.size() > kMaxReportIdLength)
+    report_id = GetLocalReportId(uploads_.front().path);
+  OnUploadSucceeded(report_id);
+}
+
+void CrashPipeline::OnExported(bool success) {
+  if (success)
+    OnUploadSucceeded(GetLocalReportId(uploads_.front().path));
+  else
+    OnUploadFailed();
+}
+
+void CrashPipeline::OnUploadSucceeded(const std::string& report_id) {
+  consecutive_failures_ = 0;
+  task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(&Store::OnUploaded, base::Unretained(store_.get()),
+                     std::move(uploads_.front()), report_id));
+  uploads_.erase(uploads_.begin());
+  UploadNext();
+}
+
+void CrashPipeline::OnUploadFailed() {
+  // The remaining reports are retried at the next run, after a delay that
+  // doubles with each failure.
+  consecutive_failures_++;
+  uploads_.clear();
+  ScheduleNextRun();
+}
+
+}  // namespace electron
@@ -0,0 +1,133 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_LINUX_CRASH_PIPELINE_H_
+#define SHELL_BROWSER_LINUX_CRASH_PIPELINE_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequenced_task_runner.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "shell/common/crash_reporter/linux/minidump_signature.h"
+#include "url/gurl.h"
+
+namespace network {
+class SimpleURLLoader;
+}
+
+namespace electron {
+
+// What the pipeline knows about the crashes sharing a signature.
+struct CrashSignatureSummary {
+  CrashSignatureSummary();
+  CrashSignatureSummary(const CrashSignatureSummary&);
+  ~CrashSignatureSummary();
+
+  std::string id;
+  crash_reporter::CrashSignature signature;
+  // The function of the crashing instruction, when its symbols were found.
+  std::string symbol;
+  int count = 0;
+  // Reports deleted by the rate limit or to make room for newer ones.
+  int dropped_count = 0;
+  int pending_count = 0;
+  int uploaded_count = 0;
+  base::Time first_seen;
+  base::Time last_seen;
+  // When the reports accepted by the rate limit were seen, within the window.
+  std::vector<base::Time> accepted_times;
+};
+
+// Processes the crash reports that the Linux crash reporter saves in the
+// crashes directory instead of uploading them right away.
+//
+// Reports are grouped by signature, and only the first ones of a signature
+// in the rate limit window are kept, so a crash storm can neither fill the
+// disk nor flood the server. At a fixed interval, up to |batch_size| of the
+// kept reports are uploaded one request each, optionally gzipped, and the
+// interval backs off while the endpoint is failing. The endpoint is an
+// HTTP(S) URL taking the usual multipart upload, or a file: URL of a
+// directory the reports are copied to.
+//
+// The reports are read and written on a background sequence, the uploads
+// happen on the UI thread.
+class CrashPipeline {
+ public:
+  struct Options {
+    GURL upload_url;
+    // The server must accept a Content-Encoding: gzip request body.
+    bool compress = false;
+    int max_reports_per_signature = 5;
+    base::TimeDelta rate_limit_window = base::TimeDelta::FromDays(1);
+    // Maximum number of reports uploaded per interval.
+    size_t batch_size = 10;
+    base::TimeDelta upload_interval = base::TimeDelta::FromMinutes(1);
+    size_t max_pending_reports = 100;
+    // Breakpad symbols to symbolize the signatures with.
+    base::FilePath symbols_dir;
+  };
+
+  using SignaturesCallback =
+      base::OnceCallback<void(std::vector<CrashSignatureSummary>)>;
+
+  // Starts processing the reports of |crashes_dir|, replacing the current
+  // pipeline.
+  static void Start(const base::FilePath& crashes_dir, const Options& options);
+  // Returns the running pipeline, or nullptr.
+  static CrashPipeline* Get();
+
+  // Returns the signatures from the most to the least frequent.
+  void GetSignatures(SignaturesCallback callback);
+
+ private:
+  class Store;
+
+  // A report to upload, read on the background sequence.
+  struct Upload {
+    base::FilePath path;
+    std::string signature_id;
+    std::string boundary;
+    std::string body;
+  };
+
+  CrashPipeline(const base::FilePath& crashes_dir, const Options& options);
+  ~CrashPipeline();
+
+  static void Shutdown();
+
+  void ScheduleNextRun();
+  void Run();
+  void OnReportsProcessed(std::vector<Upload> uploads);
+  void UploadNext();
+  void OnUploadComplete(std::unique_ptr<std::string> response_body);
+  void OnExported(bool success);
+  void OnUploadSucceeded(const std::string& report_id);
+  void OnUploadFailed();
+
+  Options options_;
+
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+  std::unique_ptr<Store, base::OnTaskRunnerDeleter> store_;
+
+  base::OneShotTimer timer_;
+  // The reports to upload this interval, the first one is in flight.
+  std::vector<Upload> uploads_;
+  std::unique_ptr<network::SimpleURLLoader> loader_;
+  int consecutive_failures_ = 0;
+
+  base::WeakPtrFactory<CrashPipeline> weak_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(CrashPipeline);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_LINUX_CRASH_PIPELINE_H_
@@ -0,0 +1,173 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/main_thread_monitor.h"
+
+#include <algorithm>
+
+#include "base/bind.h"
+#include "base/bits.h"
+#include "base/pending_task.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "base/trace_event/trace_event.h"
+
+namespace electron {
+
+namespace {
+
+MainThreadMonitor* g_main_thread_monitor = nullptr;
+
+// The locations only have file and function names in some builds.
+const char* OrEmpty(const char* string) {
+  return string ? string : "";
+}
+
+}  // namespace
+
+DurationHistogram::DurationHistogram() = default;
+
+DurationHistogram::~DurationHistogram() = default;
+
+void DurationHistogram::Add(base::TimeDelta duration) {
+  const int64_t ms = duration.InMilliseconds();
+  size_t index = 0;
+  if (ms >= 1) {
+    const int64_t max_ms = GetBucketMin(kBucketCount - 1);
+    index =
+        base::bits::Log2Floor(static_cast<uint32_t>(std::min(ms, max_ms))) + 1;
+  }
+  ++buckets_[index];
+  ++count_;
+  sum_ += duration;
+  max_ = std::max(max_, duration);
+}
+
+// static
+int64_t DurationHistogram::GetBucketMin(size_t index) {
+  return index == 0 ? 0 : int64_t{1} << (index - 1);
+}
+
+MainThreadMonitor::MainThreadMonitor() {
+  DCHECK(!g_main_thread_monitor);
+  g_main_thread_monitor = this;
+}
+
+MainThreadMonitor::~MainThreadMonitor() {
+  g_main_thread_monitor = nullptr;
+}
+
+// static
+MainThreadMonitor* MainThreadMonitor::Get() {
+  return g_main_thread_monitor;
+}
+
+void MainThreadMonitor::AddObserver(Observer* observer) {
+  observers_.AddObserver(observer);
+}
+
+void MainThreadMonitor::RemoveObserver(Observer* observer) {
+  observers_.RemoveObserver(observer);
+}
+
+void MainThreadMonitor::DidRunMicrotasks(base::TimeDelta duration) {
+  microtask_durations_.Add(duration);
+  if (!running_tasks_.empty())
+    running_tasks_.back().microtask_duration += duration;
+}
+
+void MainThreadMonitor::Reset() {
+  task_durations_ = DurationHistogram();
+  queueing_delays_ = DurationHistogram();
+  microtask_durations_ = DurationHistogram();
+  long_tasks_.clear();
+  next_long_task_ = 0;
+}
+
+std::vector<LongTask> MainThreadMonitor::GetLongTasks() const {
+  std::vector<LongTask> tasks;
+  tasks.reserve(long_tasks_.size());
+  // Once the buffer is full, |next_long_task_| is the oldest task.
+  const size_t oldest =
+      long_tasks_.size() < kMaxLongTasks ? 0 : next_long_task_;
+  for (size_t i = 0; i < long_tasks_.size(); ++i)
+    tasks.push_back(long_tasks_[(oldest + i) % long_tasks_.size()]);
+  return tasks;
+}
+
+void MainThreadMonitor::WillProcessTask(const base::PendingTask& pending_task,
+                                        bool was_blocked_or_low_priority) {
+  if (!running_tasks_.empty())
+    running_tasks_.back().nested = true;
+
+  RunningTask task;
+  task.start = base::TimeTicks::Now();
+  // Delayed tasks are late from their run time, the others from the time they
+  // were posted, which JavascriptEnvironment has the UI thread record.
+  const base::TimeTicks ready_time = !pending_task.delayed_run_time.is_null()
+                                         ? pending_task.delayed_run_time
+                                         : pending_task.queue_time;
+  if (!ready_time.is_null()) {
+    task.queueing_delay =
+        std::max(base::TimeDelta(), task.start - ready_time);
+    queueing_delays_.Add(*task.queueing_delay);
+  }
+  running_tasks_.push_back(task);
+}
+
+void MainThreadMonitor::DidProcessTask(const base::PendingTask& pending_task) {
+  // Tasks that started before the monitor was added aren't tracked.
+  if (running_tasks_.empty())
+    return;
+  const RunningTask task = running_tasks_.back();
+  running_tasks_.pop_back();
+  if (task.nested)
+    return;
+
+  const base::TimeTicks end = base::TimeTicks::Now();
+  const base::TimeDelta duration = end - task.start;
+  task_durations_.Add(duration);
+  if (duration < long_task_threshold_ || task.notified_observers)
+    return;
+
+  TRACE_EVENT_NESTABLE_ASYNC_BEGIN_WITH_TIMESTAMP2(
+      "electron", "LongTask", TRACE_ID_LOCAL(this), task.start, "src_file",
+      OrEmpty(pending_task.posted_from.file_name()), "src_func",
+      OrEmpty(pending_task.posted_from.function_name()));
+  TRACE_EVENT_NESTABLE_ASYNC_END_WITH_TIMESTAMP1(
+      "electron", "LongTask", TRACE_ID_LOCAL(this), end, "microtasks_ms",
+      task.microtask_duration.InMillisecondsF());
+
+  LongTask long_task;
+  long_task.posted_from = pending_task.posted_from;
+  long_task.start_time = base::Time::Now() - duration;
+  long_task.duration = duration;
+  long_task.queueing_delay = task.queueing_delay;
+  long_task.microtask_duration = task.microtask_duration;
+  RecordLongTask(long_task);
+
+  // Observers run JavaScript, which shouldn't happen in the middle of the
+  // observers of this task.
+  if (observers_.might_have_observers()) {
+    base::ThreadTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::BindOnce(&MainThreadMonitor::NotifyLongTask,
+                                  weak_factory_.GetWeakPtr(), long_task));
+  }
+}
+
+void MainThreadMonitor::RecordLongTask(const LongTask& task) {
+  if (long_tasks_.size() < kMaxLongTasks)
+    long_tasks_.push_back(task);
+  else
+    long_tasks_[next_long_task_] = task;
+  next_long_task_ = (next_long_task_ + 1) % kMaxLongTasks;
+}
+
+void MainThreadMonitor::NotifyLongTask(const LongTask& task) {
+  if (!running_tasks_.empty())
+    running_tasks_.back().notified_observers = true;
+  for (Observer& observer : observers_)
+    observer.OnLongTask(task);
+}
+
+}  // namespace electron
@@ -0,0 +1,151 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_MAIN_THREAD_MONITOR_H_
+#define SHELL_BROWSER_MAIN_THREAD_MONITOR_H_
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "base/location.h"
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "base/observer_list.h"
+#include "base/observer_list_types.h"
+#include "base/optional.h"
+#include "base/task/task_observer.h"
+#include "base/time/time.h"
+
+namespace electron {
+
+// Distribution of durations in exponential buckets of milliseconds, the
+// bucket i holding the durations in [2^(i-1), 2^i) and the first one those
+// under 1ms.
+class DurationHistogram {
+ public:
+  static constexpr size_t kBucketCount = 14;
+
+  DurationHistogram();
+  ~DurationHistogram();
+
+  void Add(base::TimeDelta duration);
+
+  // Returns the lower bound of the bucket |index| in milliseconds.
+  static int64_t GetBucketMin(size_t index);
+
+  uint64_t count() const { return count_; }
+  base::TimeDelta sum() const { return sum_; }
+  base::TimeDelta max() const { return max_; }
+  const std::array<uint64_t, kBucketCount>& buckets() const {
+    return buckets_;
+  }
+
+ private:
+  uint64_t count_ = 0;
+  base::TimeDelta sum_;
+  base::TimeDelta max_;
+  std::array<uint64_t, kBucketCount> buckets_ = {};
+};
+
+struct LongTask {
+  base::Location posted_from;
+  base::Time start_time;
+  base::TimeDelta duration;
+  // Unset when the task doesn't know when it was posted.
+  base::Optional<base::TimeDelta> queueing_delay;
+  // Part of |duration| spent in the microtask checkpoint ending the task.
+  base::TimeDelta microtask_duration;
+};
+
+// Observes every task of the browser's UI thread to record how long they run
+// and wait in the queue, which includes the uv loop run by NodeBindings and
+// the microtasks checkpoint run by MicrotasksRunner.
+//
+// Tasks running longer than a threshold are kept with the location that
+// posted them and emitted as trace events. Only a few clock reads are added
+// to each task, so the monitor is always on.
+class MainThreadMonitor : public base::TaskObserver {
+ public:
+  class Observer : public base::CheckedObserver {
+   public:
+    virtual void OnLongTask(const LongTask& task) = 0;
+  };
+
+  // Number of long tasks kept, the oldest ones are dropped.
+  static constexpr size_t kMaxLongTasks = 50;
+
+  MainThreadMonitor();
+  ~MainThreadMonitor() override;
+
+  // Returns the monitor of the UI thread, which exists as long as the
+  // JavascriptEnvironment and observes the tasks while the message loop runs.
+  static MainThreadMonitor* Get();
+
+  void AddObserver(Observer* observer);
+  void RemoveObserver(Observer* observer);
+
+  // Called by MicrotasksRunner once the checkpoint ending the current task
+  // ran, the monitor must observe the tasks after it.
+  void DidRunMicrotasks(base::TimeDelta duration);
+
+  void Reset();
+
+  base::TimeDelta long_task_threshold() const { return long_task_threshold_; }
+  void set_long_task_threshold(base::TimeDelta threshold) {
+    long_task_threshold_ = threshold;
+  }
+
+  const DurationHistogram& task_durations() const { return task_durations_; }
+  const DurationHistogram& queueing_delays() const { return queueing_delays_; }
+  const DurationHistogram& microtask_durations() const {
+    return microtask_durations_;
+  }
+  // Returns the long tasks from the oldest to the newest.
+  std::vector<LongTask> GetLongTasks() const;
+
+  // base::TaskObserver:
+  void WillProcessTask(const base::PendingTask& pending_task,
+                       bool was_blocked_or_low_priority) override;
+  void DidProcessTask(const base::PendingTask& pending_task) override;
+
+ private:
+  struct RunningTask {
+    base::TimeTicks start;
+    base::Optional<base::TimeDelta> queueing_delay;
+    base::TimeDelta microtask_duration;
+    // Set when a nested loop ran tasks inside this one, whose duration then
+    // says nothing about how long the thread was blocked.
+    bool nested = false;
+    // Set when the task notified the observers of a long task, so slow
+    // observers don't report themselves in a loop.
+    bool notified_observers = false;
+  };
+
+  void RecordLongTask(const LongTask& task);
+  void NotifyLongTask(const LongTask& task);
+
+  base::TimeDelta long_task_threshold_ = base::TimeDelta::FromMilliseconds(50);
+
+  // The tasks being run, more than one in nested loops.
+  std::vector<RunningTask> running_tasks_;
+
+  DurationHistogram task_durations_;
+  DurationHistogram queueing_delays_;
+  DurationHistogram microtask_durations_;
+
+  // Ring buffer of the latest long tasks.
+  std::vector<LongTask> long_tasks_;
+  size_t next_long_task_ = 0;
+
+  base::ObserverList<Observer> observers_;
+
+  base::WeakPtrFactory<MainThreadMonitor> weak_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(MainThreadMonitor);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_MAIN_THREAD_MONITOR_H_
@@ -4,6 +4,10 @@
 // found in the LICENSE file.
 
 #include "shell/browser/microtasks_runner.h"
+
+#include "base/time/time.h"
+#include "base/trace_event/trace_event.h"
+#include "shell/browser/main_thread_monitor.h"
 #include "v8/include/v8.h"
 
 namespace electron {
@@ -14,8 +18,12 @@ void MicrotasksRunner::WillProcessTask(const base::PendingTask& pending_task,
                                        bool was_blocked_or_low_priority) {}
 
 void MicrotasksRunner::DidProcessTask(const base::PendingTask& pending_task) {
+  TRACE_EVENT0("electron", "MicrotasksRunner::PerformCheckpoint");
+  const base::TimeTicks start = base::TimeTicks::Now();
   v8::Isolate::Scope scope(isolate_);
   v8::MicrotasksScope::PerformCheckpoint(isolate_);
+  if (auto* monitor = MainThreadMonitor::Get())
+    monitor->DidRunMicrotasks(base::TimeTicks::Now() - start);
 }
 
 }  // namespace electron
@@ -4,11 +4,17 @@
 
 #include "shell/browser/net/electron_url_loader_factory.h"
 
+#include <cstring>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
+#include "base/files/file.h"
 #include "base/guid.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/strings/string_util.h"
+#include "base/task/post_task.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/storage_partition.h"
 #include "mojo/public/cpp/bindings/binding.h"
@@ -23,6 +29,8 @@
 #include "shell/browser/net/asar/asar_url_loader.h"
 #include "shell/browser/net/node_stream_loader.h"
 #include "shell/browser/net/url_pipe_loader.h"
+#include "shell/common/asar/archive.h"
+#include "shell/common/asar/asar_util.h"
 #include "shell/common/electron_constants.h"
 #include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_converters/gurl_converter.h"
@@ -139,32 +147,235 @@ network::mojom::URLResponseHeadPtr ToResponseHead(
   return head;
 }
 
-// Helper to write string to pipe.
-struct WriteData {
-  mojo::Remote<network::mojom::URLLoaderClient> client;
-  std::string data;
-  std::unique_ptr<mojo::DataPipeProducer> producer;
+// Writes the response body into a data pipe chunk by chunk.
+//
+// Chunks backed by a node::Buffer or an external V8 string are written straight
+// from the memory of the JS value, which is kept alive until all writes have
+// finished, so large bodies are never copied on the UI thread. The backing
+// store of a Buffer is held rather than the Buffer, so its memory stays valid
+// on the thread pool even if JS detaches or transfers the ArrayBuffer.
+//
+// This class manages its own lifetime and deletes itself once the body has
+// been written or the pipe was closed.
+class ResponseBodyWriter {
+ public:
+  // |isolate| may be null when only chunks that are not backed by JS values
+  // are added.
+  explicit ResponseBodyWriter(v8::Isolate* isolate) : isolate_(isolate) {}
+
+  // Adds a chunk whose memory is owned by |owner|.
+  void AddChunk(v8::Local<v8::Value> owner, base::StringPiece data) {
+    auto chunk = std::make_unique<Chunk>();
+    chunk->owner.Reset(isolate_, owner);
+    chunk->data = data;
+    total_size_ += data.size();
+    chunks_.push_back(std::move(chunk));
+  }
+
+  // Adds |length| bytes at |offset| of |store|, which is shared with the
+  // ArrayBuffer of a node::Buffer.
+  void AddChunk(std::shared_ptr<v8::BackingStore> store,
+                size_t offset,
+                size_t length) {
+    auto chunk = std::make_unique<Chunk>();
+    chunk->data = base::StringPiece(
+        static_cast<const char*>(store->Data()) + offset, length);
+    chunk->store = std::move(store);
+    total_size_ += length;
+    chunks_.push_back(std::move(chunk));
+  }
+
+  // Adds a chunk that has to be copied out of V8.
+  void AddChunk(std::string data) {
+    auto chunk = std::make_unique<Chunk>();
+    chunk->owned = std::move(data);
+    chunk->data = base::StringPiece(chunk->owned);
+    total_size_ += chunk->data.size();
+    chunks_.push_back(std::move(chunk));
+  }
+
+  // Adds a chunk that shares ownership of |memory|.
+  void AddChunk(scoped_refptr<base::RefCountedMemory> memory) {
+    auto chunk = std::make_unique<Chunk>();
+    chunk->data = base::StringPiece(memory->front_as<char>(), memory->size());
+    chunk->memory = std::move(memory);
+    total_size_ += chunk->data.size();
+    chunks_.push_back(std::move(chunk));
+  }
+
+  // Returns the whole body as memory that outlives the JS values, shared
+  // with this writer instead of copied for it. A body backed by JS is copied
+  // once, since JS can still modify the Buffers, and small Buffers share
+  // their memory with unrelated ones. The writer then sends that copy and
+  // releases the JS values.
+  scoped_refptr<base::RefCountedMemory> ShareBody() {
+    if (chunks_.size() == 1 && chunks_[0]->owner.IsEmpty() &&
+        !chunks_[0]->store) {
+      Chunk* chunk = chunks_[0].get();
+      if (!chunk->memory) {
+        chunk->memory = base::RefCountedString::TakeString(&chunk->owned);
+        chunk->data = base::StringPiece(chunk->memory->front_as<char>(),
+                                        chunk->memory->size());
+      }
+      return chunk->memory;
+    }
+
+    auto body = base::MakeRefCounted<base::RefCountedBytes>(total_size_);
+    size_t offset = 0;
+    for (const auto& chunk : chunks_) {
+      if (chunk->data.empty())
+        continue;
+      memcpy(body->data().data() + offset, chunk->data.data(),
+             chunk->data.size());
+      offset += chunk->data.size();
+    }
+    chunks_.clear();
+    total_size_ = 0;
+    AddChunk(body);
+    return body;
+  }
+
+  void Start(mojo::PendingRemote<network::mojom::URLLoaderClient> client,
+             network::mojom::URLResponseHeadPtr head) {
+    client_.Bind(std::move(client));
+    head->headers->AddHeader(kCORSHeader);
+    client_->OnReceiveResponse(std::move(head));
+
+    // Code bellow follows the pattern of data_url_loader_factory.cc.
+    mojo::ScopedDataPipeProducerHandle producer;
+    mojo::ScopedDataPipeConsumerHandle consumer;
+    if (mojo::CreateDataPipe(nullptr, &producer, &consumer) !=
+        MOJO_RESULT_OK) {
+      Complete(net::ERR_INSUFFICIENT_RESOURCES);
+      return;
+    }
+
+    client_->OnStartLoadingResponseBody(std::move(consumer));
+    producer_ = std::make_unique<mojo::DataPipeProducer>(std::move(producer));
+    WriteNext();
+  }
+
+ private:
+  struct Chunk {
+    v8::Global<v8::Value> owner;
+    std::shared_ptr<v8::BackingStore> store;
+    std::string owned;
+    scoped_refptr<base::RefCountedMemory> memory;
+    base::StringPiece data;
+  };
+
+  ~ResponseBodyWriter() = default;
+
+  void WriteNext() {
+    // Skip empty chunks, writing them would never complete.
+    while (next_chunk_ < chunks_.size() && chunks_[next_chunk_]->data.empty())
+      ++next_chunk_;
+
+    if (next_chunk_ == chunks_.size()) {
+      Complete(net::OK);
+      return;
+    }
+
+    producer_->Write(
+        std::make_unique<mojo::StringDataSource>(
+            chunks_[next_chunk_]->data,
+            mojo::StringDataSource::AsyncWritingMode::
+                STRING_STAYS_VALID_UNTIL_COMPLETION),
+        base::BindOnce(&ResponseBodyWriter::OnWrite, base::Unretained(this)));
+  }
+
+  void OnWrite(MojoResult result) {
+    if (result != MOJO_RESULT_OK) {
+      Complete(net::ERR_FAILED);
+      return;
+    }
+
+    // Release the chunk as soon as it has been written.
+    chunks_[next_chunk_++].reset();
+    WriteNext();
+  }
+
+  void Complete(int result) {
+    network::URLLoaderCompletionStatus status(result);
+    if (result == net::OK) {
+      status.encoded_data_length = total_size_;
+      status.encoded_body_length = total_size_;
+      status.decoded_body_length = total_size_;
+    }
+    client_->OnComplete(status);
+    delete this;
+  }
+
+  v8::Isolate* isolate_;
+  mojo::Remote<network::mojom::URLLoaderClient> client_;
+  std::unique_ptr<mojo::DataPipeProducer> producer_;
+  std::vector<std::unique_ptr<Chunk>> chunks_;
+  size_t next_chunk_ = 0;
+  size_t total_size_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(ResponseBodyWriter);
 };
 
-void OnWrite(std::unique_ptr<WriteData> write_data, MojoResult result) {
-  if (result != MOJO_RESULT_OK) {
-    network::URLLoaderCompletionStatus status(net::ERR_FAILED);
-    return;
+// Adds |value| to |writer| if it is a Buffer, returns false otherwise.
+bool AddBufferChunk(ResponseBodyWriter* writer, v8::Local<v8::Value> value) {
+  if (!node::Buffer::HasInstance(value))
+    return false;
+  auto view = value.As<v8::ArrayBufferView>();
+  // A detached Buffer has no memory left to send.
+  if (view->ByteLength() > 0) {
+    writer->AddChunk(view->Buffer()->GetBackingStore(), view->ByteOffset(),
+                     view->ByteLength());
+  }
+  return true;
+}
+
+// Adds the UTF-8 contents of |value| to |writer|.
+void AddStringChunk(ResponseBodyWriter* writer,
+                    v8::Isolate* isolate,
+                    v8::Local<v8::String> value) {
+  // External one-byte strings (e.g. what Node returns for large
+  // |buffer.toString('latin1')|) can be sent without conversion as long as
+  // they are valid UTF-8, which is the case when they are pure ASCII.
+  if (value->IsExternalOneByte()) {
+    const auto* resource = value->GetExternalOneByteStringResource();
+    base::StringPiece data(resource->data(), resource->length());
+    if (base::IsStringASCII(data)) {
+      writer->AddChunk(value, data);
+      return;
+    }
+  }
+  writer->AddChunk(gin::V8ToString(isolate, value));
+}
+
+// Whether the file at |path|, which may be in an asar archive, can be opened.
+bool CanOpenFile(const base::FilePath& path) {
+  base::FilePath asar_path, relative_path;
+  if (asar::GetAsarArchivePath(path, &asar_path, &relative_path)) {
+    std::shared_ptr<asar::Archive> archive =
+        asar::GetOrCreateAsarArchive(asar_path);
+    asar::Archive::FileInfo info;
+    return archive && archive->GetFileInfo(relative_path, &info);
   }
+  return base::File(path, base::File::FLAG_OPEN | base::File::FLAG_READ)
+      .IsValid();
+}
 
-  network::URLLoaderCompletionStatus status(net::OK);
-  status.encoded_data_length = write_data->data.size();
-  status.encoded_body_length = write_data->data.size();
-  status.decoded_body_length = write_data->data.size();
-  write_data->client->OnComplete(status);
+void StoreFileResponse(scoped_refptr<ProtocolResponseCache> cache,
+                       const network::ResourceRequest& request,
+                       network::mojom::URLResponseHeadPtr head,
+                       const base::FilePath& path,
+                       bool can_open) {
+  if (can_open)
+    cache->Put(request, *head, nullptr, path);
 }
 
 }  // namespace
 
 ElectronURLLoaderFactory::ElectronURLLoaderFactory(
     ProtocolType type,
-    const ProtocolHandler& handler)
-    : type_(type), handler_(handler) {}
+    const ProtocolHandler& handler,
+    scoped_refptr<ProtocolResponseCache> cache)
+    : type_(type), handler_(handler), cache_(std::move(cache)) {}
 
 ElectronURLLoaderFactory::~ElectronURLLoaderFactory() = default;
 
@@ -177,11 +388,21 @@ void ElectronURLLoaderFactory::CreateLoaderAndStart(
     mojo::PendingRemote<network::mojom::URLLoaderClient> client,
     const net::MutableNetworkTrafficAnnotationTag& traffic_annotation) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (cache_) {
+    const ProtocolResponseCache::Entry* entry = cache_->Lookup(request);
+    if (entry) {
+      StartLoadingFromCache(*entry, std::move(loader), request,
+                            std::move(client));
+      return;
+    }
+  }
+
   handler_.Run(
       request,
       base::BindOnce(&ElectronURLLoaderFactory::StartLoading, std::move(loader),
                      routing_id, request_id, options, request,
-                     std::move(client), traffic_annotation, nullptr, type_));
+                     std::move(client), traffic_annotation, nullptr, type_,
+                     cache_));
 }
 
 void ElectronURLLoaderFactory::Clone(
@@ -200,6 +421,7 @@ void ElectronURLLoaderFactory::StartLoading(
     const net::MutableNetworkTrafficAnnotationTag& traffic_annotation,
     network::mojom::URLLoaderFactory* proxy_factory,
     ProtocolType type,
+    scoped_refptr<ProtocolResponseCache> cache,
     gin::Arguments* args) {
   // Send network error when there is no argument passed.
   //
@@ -274,15 +496,17 @@ void ElectronURLLoaderFactory::StartLoading(
 
   switch (type) {
     case ProtocolType::kBuffer:
-      StartLoadingBuffer(std::move(client), std::move(head), dict);
+      StartLoadingBuffer(request, std::move(client), std::move(head), dict,
+                         cache.get());
       break;
     case ProtocolType::kString:
-      StartLoadingString(std::move(client), std::move(head), dict,
-                         args->isolate(), response);
+      StartLoadingString(request, std::move(client), std::move(head), dict,
+                         args->isolate(), response, cache.get());
       break;
     case ProtocolType::kFile:
       StartLoadingFile(std::move(loader), request, std::move(client),
-                       std::move(head), dict, args->isolate(), response);
+                       std::move(head), dict, args->isolate(), response,
+                       cache.get());
       break;
     case ProtocolType::kHttp:
       StartLoadingHttp(std::move(loader), request, std::move(client),
@@ -303,19 +527,58 @@ void ElectronURLLoaderFactory::StartLoading(
       }
       StartLoading(std::move(loader), routing_id, request_id, options, request,
                    std::move(client), traffic_annotation, proxy_factory, type,
-                   args);
+                   std::move(cache), args);
       break;
   }
 }
 
+// static
+void ElectronURLLoaderFactory::StartLoadingFromCache(
+    const ProtocolResponseCache::Entry& entry,
+    mojo::PendingReceiver<network::mojom::URLLoader> loader,
+    const network::ResourceRequest& request,
+    mojo::PendingRemote<network::mojom::URLLoaderClient> client) {
+  network::mojom::URLResponseHeadPtr head = entry.CreateResponseHead();
+  if (entry.body) {
+    auto* writer = new ResponseBodyWriter(nullptr);
+    writer->AddChunk(entry.body);
+    writer->Start(std::move(client), std::move(head));
+    return;
+  }
+
+  network::ResourceRequest file_request = request;
+  file_request.url = net::FilePathToFileURL(entry.path);
+  head->headers->AddHeader(kCORSHeader);
+  asar::CreateAsarURLLoader(file_request, std::move(loader), std::move(client),
+                            head->headers);
+}
+
 // static
 void ElectronURLLoaderFactory::StartLoadingBuffer(
+    const network::ResourceRequest& request,
     mojo::PendingRemote<network::mojom::URLLoaderClient> client,
     network::mojom::URLResponseHeadPtr head,
-    const gin_helper::Dictionary& dict) {
-  v8::Local<v8::Value> buffer = dict.GetHandle();
-  dict.Get("data", &buffer);
-  if (!node::Buffer::HasInstance(buffer)) {
+    const gin_helper::Dictionary& dict,
+    ProtocolResponseCache* cache) {
+  v8::Local<v8::Value> data = dict.GetHandle();
+  dict.Get("data", &data);
+
+  auto* writer = new ResponseBodyWriter(dict.isolate());
+  bool valid = AddBufferChunk(writer, data);
+  if (!valid && data->IsArray()) {
+    // An array of Buffers is sent as consecutive chunks of the body.
+    auto chunks = data.As<v8::Array>();
+    auto context = dict.isolate()->GetCurrentContext();
+    valid = true;
+    for (uint32_t i = 0; valid && i < chunks->Length(); ++i) {
+      v8::Local<v8::Value> chunk;
+      valid = chunks->Get(context, i).ToLocal(&chunk) &&
+              AddBufferChunk(writer, chunk);
+    }
+  }
+
+  if (!valid) {
+    delete writer;
     mojo::Remote<network::mojom::URLLoaderClient> client_remote(
         std::move(client));
     client_remote->OnComplete(
@@ -323,24 +586,21 @@ void ElectronURLLoaderFactory::StartLoadingBuffer(
     return;
   }
 
-  SendContents(
-      std::move(client), std::move(head),
-      std::string(node::Buffer::Data(buffer), node::Buffer::Length(buffer)));
+  if (cache && cache->ShouldStore(request, *head))
+    cache->Put(request, *head, writer->ShareBody(), base::FilePath());
+  writer->Start(std::move(client), std::move(head));
 }
 
 // static
 void ElectronURLLoaderFactory::StartLoadingString(
+    const network::ResourceRequest& request,
     mojo::PendingRemote<network::mojom::URLLoaderClient> client,
     network::mojom::URLResponseHeadPtr head,
     const gin_helper::Dictionary& dict,
     v8::Isolate* isolate,
-    v8::Local<v8::Value> response) {
-  std::string contents;
-  if (response->IsString()) {
-    contents = gin::V8ToString(isolate, response);
-  } else if (!dict.IsEmpty()) {
-    dict.Get("data", &contents);
-  } else {
+    v8::Local<v8::Value> response,
+    ProtocolResponseCache* cache) {
+  if (!response->IsString() && dict.IsEmpty()) {
     mojo::Remote<network::mojom::URLLoaderClient> client_remote(
         std::move(client));
     client_remote->OnComplete(
@@ -348,7 +608,13 @@ void ElectronURLLoaderFactory::StartLoadingString(
     return;
   }
 
-  SendContents(std::move(client), std::move(head), std::move(contents));
+  auto* writer = new ResponseBodyWriter(isolate);
+  v8::Local<v8::Value> data = response;
+  if (response->IsString() || (dict.Get("data", &data) && data->IsString()))
+    AddStringChunk(writer, isolate, data.As<v8::String>());
+  if (cache && cache->ShouldStore(request, *head))
+    cache->Put(request, *head, writer->ShareBody(), base::FilePath());
+  writer->Start(std::move(client), std::move(head));
 }
 
 // static
@@ -359,21 +625,37 @@ void ElectronURLLoaderFactory::StartLoadingFile(
     network::mojom::URLResponseHeadPtr head,
     const gin_helper::Dictionary& dict,
     v8::Isolate* isolate,
-    v8::Local<v8::Value> response) {
+    v8::Local<v8::Value> response,
+    ProtocolResponseCache* cache) {
   base::FilePath path;
-  if (gin::ConvertFromV8(isolate, response, &path)) {
-    request.url = net::FilePathToFileURL(path);
-  } else if (!dict.IsEmpty()) {
+  if (!gin::ConvertFromV8(isolate, response, &path)) {
+    if (dict.IsEmpty()) {
+      mojo::Remote<network::mojom::URLLoaderClient> client_remote(
+          std::move(client));
+      client_remote->OnComplete(
+          network::URLLoaderCompletionStatus(net::ERR_FAILED));
+      return;
+    }
     dict.Get("referrer", &request.referrer);
     dict.Get("method", &request.method);
-    if (dict.Get("path", &path))
-      request.url = net::FilePathToFileURL(path);
-  } else {
-    mojo::Remote<network::mojom::URLLoaderClient> client_remote(
-        std::move(client));
-    client_remote->OnComplete(
-        network::URLLoaderCompletionStatus(net::ERR_FAILED));
-    return;
+    dict.Get("path", &path);
+  }
+
+  if (!path.empty()) {
+    // Only the resolved path is cached, the file is read again on every hit.
+    // It is stored once the file could be opened, so that a handler returning
+    // a missing file is asked again.
+    if (cache && cache->ShouldStore(request, *head)) {
+      base::PostTaskAndReplyWithResult(
+          FROM_HERE,
+          {base::ThreadPool(), base::MayBlock(),
+           base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+          base::BindOnce(&CanOpenFile, path),
+          base::BindOnce(&StoreFileResponse, base::WrapRefCounted(cache),
+                         request, head->Clone(), path));
+    }
+    request.url = net::FilePathToFileURL(path);
   }
 
   head->headers->AddHeader(kCORSHeader);
@@ -477,39 +759,4 @@ void ElectronURLLoaderFactory::StartLoadingStream(
                        data.isolate(), data.GetHandle());
 }
 
-// static
-void ElectronURLLoaderFactory::SendContents(
-    mojo::PendingRemote<network::mojom::URLLoaderClient> client,
-    network::mojom::URLResponseHeadPtr head,
-    std::string data) {
-  mojo::Remote<network::mojom::URLLoaderClient> client_remote(
-      std::move(client));
-  head->headers->AddHeader(kCORSHeader);
-  client_remote->OnReceiveResponse(std::move(head));
-
-  // Code bellow follows the pattern of data_url_loader_factory.cc.
-  mojo::ScopedDataPipeProducerHandle producer;
-  mojo::ScopedDataPipeConsumerHandle consumer;
-  if (mojo::CreateDataPipe(nullptr, &producer, &consumer) != MOJO_RESULT_OK) {
-    client_remote->OnComplete(
-        network::URLLoaderCompletionStatus(net::ERR_INSUFFICIENT_RESOURCES));
-    return;
-  }
-
-  client_remote->OnStartLoadingResponseBody(std::move(consumer));
-
-  auto write_data = std::make_unique<WriteData>();
-  write_data->client = std::move(client_remote);
-  write_data->data = std::move(data);
-  write_data->producer =
-      std::make_unique<mojo::DataPipeProducer>(std::move(producer));
-
-  base::StringPiece string_piece(write_data->data);
-  write_data->producer->Write(
-      std::make_unique<mojo::StringDataSource>(
-          string_piece, mojo::StringDataSource::AsyncWritingMode::
-                            STRING_STAYS_VALID_UNTIL_COMPLETION),
-      base::BindOnce(OnWrite, std::move(write_data)));
-}
-
 }  // namespace electron
@@ -16,6 +16,7 @@
 #include "net/url_request/url_request_job_factory.h"
 #include "services/network/public/mojom/url_loader_factory.mojom.h"
 #include "services/network/public/mojom/url_response_head.mojom.h"
+#include "shell/browser/net/protocol_response_cache.h"
 #include "shell/common/gin_helper/dictionary.h"
 
 namespace electron {
@@ -41,7 +42,10 @@ using HandlersMap =
 // Implementation of URLLoaderFactory.
 class ElectronURLLoaderFactory : public network::mojom::URLLoaderFactory {
  public:
-  ElectronURLLoaderFactory(ProtocolType type, const ProtocolHandler& handler);
+  // Responses are served from and stored into |cache| when it is not null.
+  ElectronURLLoaderFactory(ProtocolType type,
+                           const ProtocolHandler& handler,
+                           scoped_refptr<ProtocolResponseCache> cache);
   ~ElectronURLLoaderFactory() override;
 
   // network::mojom::URLLoaderFactory:
@@ -67,19 +71,29 @@ class ElectronURLLoaderFactory : public network::mojom::URLLoaderFactory {
       const net::MutableNetworkTrafficAnnotationTag& traffic_annotation,
       network::mojom::URLLoaderFactory* proxy_factory,
       ProtocolType type,
+      scoped_refptr<ProtocolResponseCache> cache,
       gin::Arguments* args);
 
  private:
+  static void StartLoadingFromCache(
+      const ProtocolResponseCache::Entry& entry,
+      mojo::PendingReceiver<network::mojom::URLLoader> loader,
+      const network::ResourceRequest& request,
+      mojo::PendingRemote<network::mojom::URLLoaderClient> client);
   static void StartLoadingBuffer(
+      const network::ResourceRequest& request,
       mojo::PendingRemote<network::mojom::URLLoaderClient> client,
       network::mojom::URLResponseHeadPtr head,
-      const gin_helper::Dictionary& dict);
+      const gin_helper::Dictionary& dict,
+      ProtocolResponseCache* cache);
   static void StartLoadingString(
+      const network::ResourceRequest& request,
       mojo::PendingRemote<network::mojom::URLLoaderClient> client,
       network::mojom::URLResponseHeadPtr head,
       const gin_helper::Dictionary& dict,
       v8::Isolate* isolate,
-      v8::Local<v8::Value> response);
+      v8::Local<v8::Value> response,
+      ProtocolResponseCache* cache);
   static void StartLoadingFile(
       mojo::PendingReceiver<network::mojom::URLLoader> loader,
       network::ResourceRequest request,
@@ -87,7 +101,8 @@ class ElectronURLLoaderFactory : public network::mojom::URLLoaderFactory {
       network::mojom::URLResponseHeadPtr head,
       const gin_helper::Dictionary& dict,
       v8::Isolate* isolate,
-      v8::Local<v8::Value> response);
+      v8::Local<v8::Value> response,
+      ProtocolResponseCache* cache);
   static void StartLoadingHttp(
       mojo::PendingReceiver<network::mojom::URLLoader> loader,
       const network::ResourceRequest& original_request,
@@ -100,12 +115,6 @@ class ElectronURLLoaderFactory : public network::mojom::URLLoaderFactory {
       network::mojom::URLResponseHeadPtr head,
       const gin_helper::Dictionary& dict);
 
-  // Helper to send string as response.
-  static void SendContents(
-      mojo::PendingRemote<network::mojom::URLLoaderClient> client,
-      network::mojom::URLResponseHeadPtr head,
-      std::string data);
-
   // TODO(zcbenz): This comes from extensions/browser/extension_protocols.cc
   // but I don't know what it actually does, find out the meanings of |Clone|
   // and |bindings_| and add comments for them.
@@ -113,6 +122,7 @@ class ElectronURLLoaderFactory : public network::mojom::URLLoaderFactory {
 
   ProtocolType type_;
   ProtocolHandler handler_;
+  scoped_refptr<ProtocolResponseCache> cache_;
 
   DISALLOW_COPY_AND_ASSIGN(ElectronURLLoaderFactory);
 };
@@ -0,0 +1,188 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/net/protocol_response_cache.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/strings/string_util.h"
+#include "net/base/load_flags.h"
+#include "net/http/http_response_headers.h"
+
+namespace electron {
+
+ProtocolResponseCache::Options::Options() = default;
+ProtocolResponseCache::Options::Options(const Options&) = default;
+ProtocolResponseCache::Options::~Options() = default;
+
+ProtocolResponseCache::Entry::Entry() = default;
+ProtocolResponseCache::Entry::Entry(const Entry&) = default;
+ProtocolResponseCache::Entry::~Entry() = default;
+
+network::mojom::URLResponseHeadPtr
+ProtocolResponseCache::Entry::CreateResponseHead() const {
+  auto head = network::mojom::URLResponseHead::New();
+  head->headers = base::MakeRefCounted<net::HttpResponseHeaders>(raw_headers);
+  head->mime_type = mime_type;
+  head->charset = charset;
+  return head;
+}
+
+size_t ProtocolResponseCache::Entry::size() const {
+  return raw_headers.size() + (body ? body->size() : 0) +
+         path.value().size() * sizeof(base::FilePath::CharType);
+}
+
+ProtocolResponseCache::ProtocolResponseCache()
+    : entries_(EntryMap::NO_AUTO_EVICT) {}
+
+ProtocolResponseCache::~ProtocolResponseCache() = default;
+
+const ProtocolResponseCache::Entry* ProtocolResponseCache::Lookup(
+    const network::ResourceRequest& request) {
+  if (disabled_)
+    return nullptr;
+  std::string key = GetKey(request);
+  if (key.empty() ||
+      (request.load_flags &
+       (net::LOAD_BYPASS_CACHE | net::LOAD_DISABLE_CACHE))) {
+    return nullptr;
+  }
+
+  auto it = entries_.Get(key);
+  if (it != entries_.end() && !it->second.expires.is_null() &&
+      it->second.expires <= base::TimeTicks::Now()) {
+    Erase(it);
+    it = entries_.end();
+  }
+  if (it == entries_.end()) {
+    ++misses_;
+    return nullptr;
+  }
+  ++hits_;
+  return &it->second;
+}
+
+bool ProtocolResponseCache::ShouldStore(
+    const network::ResourceRequest& request,
+    const network::mojom::URLResponseHead& head) const {
+  if (disabled_ || GetKey(request).empty() ||
+      (request.load_flags & net::LOAD_DISABLE_CACHE))
+    return false;
+  const net::HttpResponseHeaders* headers = head.headers.get();
+  if (!headers || headers->response_code() != 200)
+    return false;
+  if (headers->HasHeaderValue("cache-control", "no-store") ||
+      headers->HasHeaderValue("cache-control", "no-cache"))
+    return false;
+
+  // The response can only be reused when the cache key already includes
+  // every request header it varies on.
+  size_t iter = 0;
+  std::string name;
+  while (headers->EnumerateHeader(&iter, "vary", &name)) {
+    auto matches = [&name](const std::string& vary_header) {
+      return base::EqualsCaseInsensitiveASCII(vary_header, name);
+    };
+    if (std::none_of(options_.vary_headers.begin(),
+                     options_.vary_headers.end(), matches))
+      return false;
+  }
+
+  base::TimeDelta max_age;
+  if (headers->GetMaxAgeValue(&max_age) && max_age <= base::TimeDelta())
+    return false;
+  return true;
+}
+
+void ProtocolResponseCache::Put(const network::ResourceRequest& request,
+                                const network::mojom::URLResponseHead& head,
+                                scoped_refptr<base::RefCountedMemory> body,
+                                const base::FilePath& path) {
+  if (!ShouldStore(request, head))
+    return;
+
+  Entry entry;
+  entry.raw_headers = head.headers->raw_headers();
+  entry.mime_type = head.mime_type;
+  entry.charset = head.charset;
+  entry.body = std::move(body);
+  entry.path = path;
+
+  base::TimeDelta max_age;
+  if (head.headers->GetMaxAgeValue(&max_age))
+    entry.expires = base::TimeTicks::Now() + max_age;
+  else if (options_.max_age)
+    entry.expires = base::TimeTicks::Now() + *options_.max_age;
+
+  // Responses larger than the whole budget would evict everything else.
+  if (entry.size() > options_.max_size)
+    return;
+
+  std::string key = GetKey(request);
+  auto existing = entries_.Peek(key);
+  if (existing != entries_.end())
+    Erase(existing);
+
+  size_ += entry.size();
+  entries_.Put(key, std::move(entry));
+  while (size_ > options_.max_size && !entries_.empty()) {
+    auto oldest = entries_.rbegin();
+    size_ -= oldest->second.size();
+    entries_.Erase(oldest);
+  }
+}
+
+void ProtocolResponseCache::Invalidate(const GURL& url) {
+  const std::string prefix = url.spec() + '\n';
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (base::StartsWith(it->first, prefix, base::CompareCase::SENSITIVE))
+      it = Erase(it);
+    else
+      ++it;
+  }
+}
+
+void ProtocolResponseCache::Clear() {
+  entries_.Clear();
+  size_ = 0;
+}
+
+void ProtocolResponseCache::Enable(const Options& options) {
+  Clear();
+  options_ = options;
+  hits_ = 0;
+  misses_ = 0;
+  disabled_ = false;
+}
+
+void ProtocolResponseCache::Disable() {
+  Clear();
+  disabled_ = true;
+}
+
+std::string ProtocolResponseCache::GetKey(
+    const network::ResourceRequest& request) const {
+  if (request.method != "GET")
+    return std::string();
+
+  // The URL is separated from the vary header values so that Invalidate() can
+  // find all variants of a URL.
+  std::string key = request.url.spec() + '\n';
+  for (const auto& name : options_.vary_headers) {
+    std::string value;
+    request.headers.GetHeader(name, &value);
+    key += name + ':' + value + '\n';
+  }
+  return key;
+}
+
+ProtocolResponseCache::EntryMap::iterator ProtocolResponseCache::Erase(
+    EntryMap::iterator it) {
+  size_ -= it->second.size();
+  return entries_.Erase(it);
+}
+
+}  // namespace electron
@@ -0,0 +1,124 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_NET_PROTOCOL_RESPONSE_CACHE_H_
+#define SHELL_BROWSER_NET_PROTOCOL_RESPONSE_CACHE_H_
+
+#include <string>
+#include <vector>
+
+#include "base/containers/mru_cache.h"
+#include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/optional.h"
+#include "base/time/time.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/mojom/url_response_head.mojom.h"
+#include "url/gurl.h"
+
+namespace electron {
+
+// In-memory cache of the responses of a custom protocol handler.
+//
+// Buffer and string responses are cached with their body, file responses with
+// the resolved path, so a hit is served by ElectronURLLoaderFactory without
+// calling the JS handler again. Entries are evicted in LRU order once the
+// total size exceeds the budget, and expire according to the Cache-Control
+// header of the handler's response.
+//
+// The cache is created disabled when a scheme is registered and shared by all
+// factories created for it, so enabling or disabling it also applies to pages
+// that are already loaded. It must only be used on the UI thread.
+class ProtocolResponseCache
+    : public base::RefCountedThreadSafe<ProtocolResponseCache> {
+ public:
+  struct Options {
+    Options();
+    Options(const Options&);
+    ~Options();
+
+    // Maximum total size of the cached responses in bytes.
+    size_t max_size = 64 * 1024 * 1024;
+    // Lifetime of responses that do not specify a max-age, unlimited if unset.
+    base::Optional<base::TimeDelta> max_age;
+    // Request headers whose values are part of the cache key. Responses that
+    // vary on any other header are not stored.
+    std::vector<std::string> vary_headers;
+  };
+
+  struct Entry {
+    Entry();
+    Entry(const Entry&);
+    ~Entry();
+
+    // Returns a new response head, the cached headers are never handed out so
+    // they can't be modified by the loaders.
+    network::mojom::URLResponseHeadPtr CreateResponseHead() const;
+    size_t size() const;
+
+    std::string raw_headers;
+    std::string mime_type;
+    std::string charset;
+    // Body of buffer and string responses.
+    scoped_refptr<base::RefCountedMemory> body;
+    // Path of file responses.
+    base::FilePath path;
+    // Null if the entry does not expire.
+    base::TimeTicks expires;
+  };
+
+  ProtocolResponseCache();
+
+  // Returns the fresh entry for |request|, or nullptr on a miss.
+  const Entry* Lookup(const network::ResourceRequest& request);
+
+  // Whether |head| as the response to |request| may be stored.
+  bool ShouldStore(const network::ResourceRequest& request,
+                   const network::mojom::URLResponseHead& head) const;
+
+  // Stores the response to |request|. Exactly one of |body| and |path| should
+  // be set.
+  void Put(const network::ResourceRequest& request,
+           const network::mojom::URLResponseHead& head,
+           scoped_refptr<base::RefCountedMemory> body,
+           const base::FilePath& path);
+
+  // Removes all entries of |url|, regardless of the vary headers.
+  void Invalidate(const GURL& url);
+  void Clear();
+
+  // Empties the cache and starts storing responses according to |options|.
+  void Enable(const Options& options);
+  // Empties the cache and turns all further lookups and stores into no-ops.
+  void Disable();
+  bool enabled() const { return !disabled_; }
+
+  size_t size() const { return size_; }
+  size_t entry_count() const { return entries_.size(); }
+  size_t hits() const { return hits_; }
+  size_t misses() const { return misses_; }
+
+ private:
+  friend class base::RefCountedThreadSafe<ProtocolResponseCache>;
+  ~ProtocolResponseCache();
+
+  using EntryMap = base::MRUCache<std::string, Entry>;
+
+  std::string GetKey(const network::ResourceRequest& request) const;
+  EntryMap::iterator Erase(EntryMap::iterator it);
+
+  Options options_;
+  EntryMap entries_;
+  bool disabled_ = true;
+  size_t size_ = 0;
+  size_t hits_ = 0;
+  size_t misses_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(ProtocolResponseCache);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_NET_PROTOCOL_RESPONSE_CACHE_H_
@@ -15,6 +15,7 @@
 #include "net/base/completion_repeating_callback.h"
 #include "net/base/load_flags.h"
 #include "net/http/http_util.h"
+#include "net/url_request/redirect_util.h"
 #include "services/network/public/cpp/features.h"
 #include "shell/browser/net/asar/asar_url_loader.h"
 #include "shell/common/options_switches.h"
@@ -665,6 +666,149 @@ void ProxyingURLLoaderFactory::InProgressRequest::OnRequestError(
   factory_->RemoveRequest(network_service_request_id_, request_id_);
 }
 
+ProxyingURLLoaderFactory::PassThroughRequest::PassThroughRequest(
+    ProxyingURLLoaderFactory* factory,
+    int32_t routing_id,
+    int32_t network_service_request_id,
+    uint32_t options,
+    const network::ResourceRequest& request,
+    const net::MutableNetworkTrafficAnnotationTag& traffic_annotation,
+    mojo::PendingReceiver<network::mojom::URLLoader> loader_receiver,
+    mojo::PendingRemote<network::mojom::URLLoaderClient> client)
+    : factory_(factory),
+      request_(request),
+      routing_id_(routing_id),
+      network_service_request_id_(network_service_request_id),
+      options_(options),
+      traffic_annotation_(traffic_annotation),
+      proxied_loader_receiver_(this, std::move(loader_receiver)),
+      target_client_(std::move(client)) {
+  // Cancelling the request on either side ends it, which deletes |this|.
+  proxied_loader_receiver_.set_disconnect_handler(
+      base::BindOnce(&ProxyingURLLoaderFactory::RemovePassThroughRequest,
+                     base::Unretained(factory_), base::Unretained(this)));
+  target_client_.set_disconnect_handler(
+      base::BindOnce(&ProxyingURLLoaderFactory::RemovePassThroughRequest,
+                     base::Unretained(factory_), base::Unretained(this)));
+
+  factory_->target_factory_->CreateLoaderAndStart(
+      target_loader_.BindNewPipeAndPassReceiver(), routing_id_,
+      network_service_request_id_, options_, request_,
+      proxied_client_receiver_.BindNewPipeAndPassRemote(), traffic_annotation_);
+  proxied_client_receiver_.set_disconnect_handler(
+      base::BindOnce(&PassThroughRequest::OnTargetDisconnected,
+                     base::Unretained(this)));
+}
+
+ProxyingURLLoaderFactory::PassThroughRequest::~PassThroughRequest() = default;
+
+void ProxyingURLLoaderFactory::PassThroughRequest::FollowRedirect(
+    const std::vector<std::string>& removed_headers,
+    const net::HttpRequestHeaders& modified_headers,
+    const base::Optional<GURL>& new_url) {
+  if (!pending_redirect_) {
+    target_loader_->FollowRedirect(removed_headers, modified_headers, new_url);
+    return;
+  }
+
+  // Keep |request_| in sync with the request the network is making, so that
+  // it can be handed over.
+  net::RedirectInfo redirect_info = std::move(*pending_redirect_);
+  pending_redirect_.reset();
+  if (new_url)
+    redirect_info.new_url = *new_url;
+  bool should_clear_upload = false;
+  net::RedirectUtil::UpdateHttpRequest(
+      request_.url, request_.method, redirect_info, removed_headers,
+      modified_headers, &request_.headers, &should_clear_upload);
+  request_.url = redirect_info.new_url;
+  request_.method = redirect_info.new_method;
+  request_.site_for_cookies = redirect_info.new_site_for_cookies;
+  request_.referrer = GURL(redirect_info.new_referrer);
+  request_.referrer_policy = redirect_info.new_referrer_policy;
+  if (should_clear_upload)
+    request_.request_body = nullptr;
+
+  if (!factory_->web_request_api()->HasListenerForURL(request_.url)) {
+    target_loader_->FollowRedirect(removed_headers, modified_headers, new_url);
+    return;
+  }
+
+  // Abandon the redirected network request, and make the request to the new
+  // URL through the proxy, which runs the listeners from onBeforeRequest on.
+  target_loader_.reset();
+  proxied_client_receiver_.reset();
+  factory_->StartProxiedRequest(
+      routing_id_, network_service_request_id_, options_, request_,
+      traffic_annotation_, proxied_loader_receiver_.Unbind(),
+      target_client_.Unbind());
+  // Deletes |this|.
+  factory_->RemovePassThroughRequest(this);
+}
+
+void ProxyingURLLoaderFactory::PassThroughRequest::SetPriority(
+    net::RequestPriority priority,
+    int32_t intra_priority_value) {
+  target_loader_->SetPriority(priority, intra_priority_value);
+}
+
+void ProxyingURLLoaderFactory::PassThroughRequest::PauseReadingBodyFromNet() {
+  target_loader_->PauseReadingBodyFromNet();
+}
+
+void ProxyingURLLoaderFactory::PassThroughRequest::ResumeReadingBodyFromNet() {
+  target_loader_->ResumeReadingBodyFromNet();
+}
+
+void ProxyingURLLoaderFactory::PassThroughRequest::OnReceiveResponse(
+    network::mojom::URLResponseHeadPtr head) {
+  target_client_->OnReceiveResponse(std::move(head));
+}
+
+void ProxyingURLLoaderFactory::PassThroughRequest::OnReceiveRedirect(
+    const net::RedirectInfo& redirect_info,
+    network::mojom::URLResponseHeadPtr head) {
+  pending_redirect_ = redirect_info;
+  target_client_->OnReceiveRedirect(redirect_info, std::move(head));
+}
+
+void ProxyingURLLoaderFactory::PassThroughRequest::OnUploadProgress(
+    int64_t current_position,
+    int64_t total_size,
+    OnUploadProgressCallback callback) {
+  target_client_->OnUploadProgress(current_position, total_size,
+                                   std::move(callback));
+}
+
+void ProxyingURLLoaderFactory::PassThroughRequest::OnReceiveCachedMetadata(
+    mojo_base::BigBuffer data) {
+  target_client_->OnReceiveCachedMetadata(std::move(data));
+}
+
+void ProxyingURLLoaderFactory::PassThroughRequest::OnTransferSizeUpdated(
+    int32_t transfer_size_diff) {
+  target_client_->OnTransferSizeUpdated(transfer_size_diff);
+}
+
+void ProxyingURLLoaderFactory::PassThroughRequest::OnStartLoadingResponseBody(
+    mojo::ScopedDataPipeConsumerHandle body) {
+  target_client_->OnStartLoadingResponseBody(std::move(body));
+}
+
+void ProxyingURLLoaderFactory::PassThroughRequest::OnComplete(
+    const network::URLLoaderCompletionStatus& status) {
+  target_client_->OnComplete(status);
+  // Deletes |this|.
+  factory_->RemovePassThroughRequest(this);
+}
+
+void ProxyingURLLoaderFactory::PassThroughRequest::OnTargetDisconnected() {
+  target_client_->OnComplete(
+      network::URLLoaderCompletionStatus(net::ERR_ABORTED));
+  // Deletes |this|.
+  factory_->RemovePassThroughRequest(this);
+}
+
 ProxyingURLLoaderFactory::ProxyingURLLoaderFactory(
     WebRequestAPI* web_request_api,
     const HandlersMap& intercepted_handlers,
@@ -737,7 +881,8 @@ void ProxyingURLLoaderFactory::CreateLoaderAndStart(
         request, base::BindOnce(&ElectronURLLoaderFactory::StartLoading,
                                 std::move(loader), routing_id, request_id,
                                 options, request, std::move(client),
-                                traffic_annotation, this, it->second.first));
+                                traffic_annotation, this, it->second.first,
+                                nullptr /* cache */));
     return;
   }
 
@@ -748,14 +893,37 @@ void ProxyingURLLoaderFactory::CreateLoaderAndStart(
     return;
   }
 
+  // Pass-through to the original factory when there are no listeners.
   if (!web_request_api()->HasListener()) {
-    // Pass-through to the original factory.
     target_factory_->CreateLoaderAndStart(
         std::move(loader), routing_id, request_id, options, request,
         std::move(client), traffic_annotation);
     return;
   }
 
+  // Requests that no listener's filter matches skip the webRequest stages and
+  // their UI thread round trips, but their redirects are still followed.
+  if (!web_request_api()->HasListenerForURL(request.url)) {
+    web_request_api()->CountRequest(false);
+    pass_through_requests_.insert(std::make_unique<PassThroughRequest>(
+        this, routing_id, request_id, options, request, traffic_annotation,
+        std::move(loader), std::move(client)));
+    return;
+  }
+
+  web_request_api()->CountRequest(true);
+  StartProxiedRequest(routing_id, request_id, options, request,
+                      traffic_annotation, std::move(loader), std::move(client));
+}
+
+void ProxyingURLLoaderFactory::StartProxiedRequest(
+    int32_t routing_id,
+    int32_t request_id,
+    uint32_t options,
+    const network::ResourceRequest& request,
+    const net::MutableNetworkTrafficAnnotationTag& traffic_annotation,
+    mojo::PendingReceiver<network::mojom::URLLoader> loader,
+    mojo::PendingRemote<network::mojom::URLLoaderClient> client) {
   // The request ID doesn't really matter. It just needs to be unique
   // per-BrowserContext so extensions can make sense of it.  Note that
   // |network_service_request_id_| by contrast is not necessarily unique, so we
@@ -821,10 +989,20 @@ void ProxyingURLLoaderFactory::RemoveRequest(int32_t network_service_request_id,
   MaybeDeleteThis();
 }
 
+void ProxyingURLLoaderFactory::RemovePassThroughRequest(
+    PassThroughRequest* request) {
+  auto it = pass_through_requests_.find(request);
+  DCHECK(it != pass_through_requests_.end());
+  pass_through_requests_.erase(it);
+
+  MaybeDeleteThis();
+}
+
 void ProxyingURLLoaderFactory::MaybeDeleteThis() {
   // Even if all URLLoaderFactory pipes connected to this object have been
   // closed it has to stay alive until all active requests have completed.
-  if (target_factory_.is_bound() || !requests_.empty())
+  if (target_factory_.is_bound() || !requests_.empty() ||
+      !pass_through_requests_.empty())
     return;
 
   delete this;
@@ -11,6 +11,7 @@
 #include <string>
 #include <vector>
 
+#include "base/containers/unique_ptr_adapters.h"
 #include "base/optional.h"
 #include "content/public/browser/content_browser_client.h"
 #include "extensions/browser/api/web_request/web_request_info.h"
@@ -164,6 +165,69 @@ class ProxyingURLLoaderFactory
     DISALLOW_COPY_AND_ASSIGN(InProgressRequest);
   };
 
+  // A request that no listener's filter matches, which goes to the network
+  // without the webRequest stages of an InProgressRequest. It only follows
+  // the redirects, and hands the request over to an InProgressRequest when a
+  // redirect to a URL that a filter matches is followed, so that loading an
+  // unmatched URL can't be used to escape the listeners.
+  class PassThroughRequest : public network::mojom::URLLoader,
+                             public network::mojom::URLLoaderClient {
+   public:
+    PassThroughRequest(
+        ProxyingURLLoaderFactory* factory,
+        int32_t routing_id,
+        int32_t network_service_request_id,
+        uint32_t options,
+        const network::ResourceRequest& request,
+        const net::MutableNetworkTrafficAnnotationTag& traffic_annotation,
+        mojo::PendingReceiver<network::mojom::URLLoader> loader_receiver,
+        mojo::PendingRemote<network::mojom::URLLoaderClient> client);
+    ~PassThroughRequest() override;
+
+    // network::mojom::URLLoader:
+    void FollowRedirect(const std::vector<std::string>& removed_headers,
+                        const net::HttpRequestHeaders& modified_headers,
+                        const base::Optional<GURL>& new_url) override;
+    void SetPriority(net::RequestPriority priority,
+                     int32_t intra_priority_value) override;
+    void PauseReadingBodyFromNet() override;
+    void ResumeReadingBodyFromNet() override;
+
+    // network::mojom::URLLoaderClient:
+    void OnReceiveResponse(network::mojom::URLResponseHeadPtr head) override;
+    void OnReceiveRedirect(const net::RedirectInfo& redirect_info,
+                           network::mojom::URLResponseHeadPtr head) override;
+    void OnUploadProgress(int64_t current_position,
+                          int64_t total_size,
+                          OnUploadProgressCallback callback) override;
+    void OnReceiveCachedMetadata(mojo_base::BigBuffer data) override;
+    void OnTransferSizeUpdated(int32_t transfer_size_diff) override;
+    void OnStartLoadingResponseBody(
+        mojo::ScopedDataPipeConsumerHandle body) override;
+    void OnComplete(const network::URLLoaderCompletionStatus& status) override;
+
+   private:
+    void OnTargetDisconnected();
+
+    ProxyingURLLoaderFactory* factory_;
+    network::ResourceRequest request_;
+    const int32_t routing_id_;
+    const int32_t network_service_request_id_;
+    const uint32_t options_;
+    const net::MutableNetworkTrafficAnnotationTag traffic_annotation_;
+    mojo::Receiver<network::mojom::URLLoader> proxied_loader_receiver_;
+    mojo::Remote<network::mojom::URLLoaderClient> target_client_;
+    mojo::Receiver<network::mojom::URLLoaderClient> proxied_client_receiver_{
+        this};
+    mojo::Remote<network::mojom::URLLoader> target_loader_;
+
+    // The redirect the client was told about, applied to |request_| once the
+    // client follows it.
+    base::Optional<net::RedirectInfo> pending_redirect_;
+
+    DISALLOW_COPY_AND_ASSIGN(PassThroughRequest);
+  };
+
   ProxyingURLLoaderFactory(
       WebRequestAPI* web_request_api,
       const HandlersMap& intercepted_handlers,
@@ -215,6 +279,17 @@ class ProxyingURLLoaderFactory
 
   bool ShouldIgnoreConnectionsLimit(const network::ResourceRequest& request);
 
+  // Starts |request| as an InProgressRequest, which reports it to webRequest.
+  void StartProxiedRequest(
+      int32_t routing_id,
+      int32_t request_id,
+      uint32_t options,
+      const network::ResourceRequest& request,
+      const net::MutableNetworkTrafficAnnotationTag& traffic_annotation,
+      mojo::PendingReceiver<network::mojom::URLLoader> loader,
+      mojo::PendingRemote<network::mojom::URLLoaderClient> client);
+  void RemovePassThroughRequest(PassThroughRequest* request);
+
   // Passed from api::WebRequest.
   WebRequestAPI* web_request_api_;
 
@@ -247,6 +322,9 @@ class ProxyingURLLoaderFactory
   // internally generated request ID for the same request.
   std::map<int32_t, uint64_t> network_request_id_to_web_request_id_;
 
+  std::set<std::unique_ptr<PassThroughRequest>, base::UniquePtrComparator>
+      pass_through_requests_;
+
   std::vector<std::string> ignore_connections_limit_domains_;
 
   DISALLOW_COPY_AND_ASSIGN(ProxyingURLLoaderFactory);
@@ -0,0 +1,101 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/net/static_url_loader_factory.h"
+
+#include <utility>
+
+#include "base/strings/string_util.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "net/base/escape.h"
+#include "net/base/filename_util.h"
+#include "net/http/http_response_headers.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/cpp/url_loader_completion_status.h"
+#include "shell/browser/net/asar/asar_url_loader.h"
+#include "shell/common/electron_constants.h"
+
+namespace electron {
+
+namespace {
+
+const char kIndexFile[] = "index.html";
+
+}  // namespace
+
+StaticProtocolOptions::StaticProtocolOptions() = default;
+StaticProtocolOptions::StaticProtocolOptions(const StaticProtocolOptions&) =
+    default;
+StaticProtocolOptions::~StaticProtocolOptions() = default;
+
+StaticURLLoaderFactory::StaticURLLoaderFactory(
+    const StaticProtocolOptions& options)
+    : options_(options) {}
+
+StaticURLLoaderFactory::~StaticURLLoaderFactory() = default;
+
+void StaticURLLoaderFactory::CreateLoaderAndStart(
+    mojo::PendingReceiver<network::mojom::URLLoader> loader,
+    int32_t routing_id,
+    int32_t request_id,
+    uint32_t options,
+    const network::ResourceRequest& request,
+    mojo::PendingRemote<network::mojom::URLLoaderClient> client,
+    const net::MutableNetworkTrafficAnnotationTag& traffic_annotation) {
+  base::FilePath path;
+  if (!ResolvePath(options_, request.url, &path)) {
+    mojo::Remote<network::mojom::URLLoaderClient> client_remote(
+        std::move(client));
+    client_remote->OnComplete(
+        network::URLLoaderCompletionStatus(net::ERR_ACCESS_DENIED));
+    return;
+  }
+
+  auto headers =
+      base::MakeRefCounted<net::HttpResponseHeaders>("HTTP/1.1 200 OK");
+  headers->AddHeader(kCORSHeader);
+  for (const auto& header : options_.headers)
+    headers->AddHeader(header.first + ": " + header.second);
+
+  network::ResourceRequest file_request = request;
+  file_request.url = net::FilePathToFileURL(path);
+  asar::CreateAsarURLLoader(file_request, std::move(loader), std::move(client),
+                            std::move(headers));
+}
+
+void StaticURLLoaderFactory::Clone(
+    mojo::PendingReceiver<network::mojom::URLLoaderFactory> receiver) {
+  receivers_.Add(this, std::move(receiver));
+}
+
+// static
+bool StaticURLLoaderFactory::ResolvePath(const StaticProtocolOptions& options,
+                                         const GURL& url,
+                                         base::FilePath* out) {
+  // For non-standard schemes the host is part of the path, e.g. the path of
+  // "app://bundle/index.html" is "//bundle/index.html".
+  std::string url_path = url.path();
+  auto rewrite = options.rewrites.find(url_path);
+  if (rewrite != options.rewrites.end())
+    url_path = rewrite->second;
+
+  std::string unescaped = net::UnescapeBinaryURLComponent(url_path);
+  if (unescaped.find('\0') != std::string::npos)
+    return false;
+  std::string relative;
+  base::TrimString(unescaped, "/", &relative);
+  if (relative.empty() || base::EndsWith(url_path, "/",
+                                         base::CompareCase::SENSITIVE)) {
+    relative = relative.empty() ? kIndexFile : relative + "/" + kIndexFile;
+  }
+
+  base::FilePath relative_path = base::FilePath::FromUTF8Unsafe(relative);
+  if (relative_path.IsAbsolute() || relative_path.ReferencesParent())
+    return false;
+
+  *out = options.root.Append(relative_path);
+  return true;
+}
+
+}  // namespace electron
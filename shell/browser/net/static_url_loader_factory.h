@@ -0,0 +1,76 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_NET_STATIC_URL_LOADER_FACTORY_H_
+#define SHELL_BROWSER_NET_STATIC_URL_LOADER_FACTORY_H_
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "mojo/public/cpp/bindings/pending_receiver.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "mojo/public/cpp/bindings/receiver_set.h"
+#include "services/network/public/mojom/url_loader_factory.mojom.h"
+#include "url/gurl.h"
+
+namespace electron {
+
+// Options of a protocol registered with |protocol.registerStaticProtocol|.
+struct StaticProtocolOptions {
+  StaticProtocolOptions();
+  StaticProtocolOptions(const StaticProtocolOptions&);
+  ~StaticProtocolOptions();
+
+  // Directory or asar archive the URL paths are resolved against.
+  base::FilePath root;
+  // URL path => URL path, applied before resolving against |root|.
+  std::map<std::string, std::string> rewrites;
+  // Extra headers added to every response.
+  std::vector<std::pair<std::string, std::string>> headers;
+};
+
+// URLLoaderFactory that serves the files below a directory or inside an asar
+// archive.
+//
+// Unlike ElectronURLLoaderFactory, requests are resolved without calling into
+// JavaScript, and the files are read on a thread-pool sequence by the asar
+// URLLoader, so subresources never queue behind the main process's JS.
+class StaticURLLoaderFactory : public network::mojom::URLLoaderFactory {
+ public:
+  explicit StaticURLLoaderFactory(const StaticProtocolOptions& options);
+  ~StaticURLLoaderFactory() override;
+
+  // network::mojom::URLLoaderFactory:
+  void CreateLoaderAndStart(
+      mojo::PendingReceiver<network::mojom::URLLoader> loader,
+      int32_t routing_id,
+      int32_t request_id,
+      uint32_t options,
+      const network::ResourceRequest& request,
+      mojo::PendingRemote<network::mojom::URLLoaderClient> client,
+      const net::MutableNetworkTrafficAnnotationTag& traffic_annotation)
+      override;
+  void Clone(mojo::PendingReceiver<network::mojom::URLLoaderFactory> receiver)
+      override;
+
+  // Maps |url| to a file below |options.root|. Returns false when the URL
+  // would resolve to a file outside of it.
+  static bool ResolvePath(const StaticProtocolOptions& options,
+                          const GURL& url,
+                          base::FilePath* out);
+
+ private:
+  mojo::ReceiverSet<network::mojom::URLLoaderFactory> receivers_;
+
+  const StaticProtocolOptions options_;
+
+  DISALLOW_COPY_AND_ASSIGN(StaticURLLoaderFactory);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_NET_STATIC_URL_LOADER_FACTORY_H_
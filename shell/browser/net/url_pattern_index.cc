@@ -0,0 +1,98 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/net/url_pattern_index.h"
+
+#include <utility>
+
+#include "url/url_constants.h"
+
+namespace electron {
+
+namespace {
+
+// Hosts are compared without the trailing dot of fully qualified names, which
+// URLPattern ignores as well.
+base::StringPiece NormalizeHost(base::StringPiece host) {
+  if (!host.empty() && host.back() == '.')
+    host.remove_suffix(1);
+  return host;
+}
+
+}  // namespace
+
+URLPatternIndex::URLPatternIndex() = default;
+
+URLPatternIndex::URLPatternIndex(std::set<URLPattern> patterns)
+    : patterns_(std::move(patterns)) {
+  BuildHostMaps();
+}
+
+URLPatternIndex::URLPatternIndex(const URLPatternIndex& other)
+    : patterns_(other.patterns_) {
+  BuildHostMaps();
+}
+
+URLPatternIndex& URLPatternIndex::operator=(const URLPatternIndex& other) {
+  if (this != &other)
+    *this = URLPatternIndex(other);
+  return *this;
+}
+
+URLPatternIndex::URLPatternIndex(URLPatternIndex&&) = default;
+URLPatternIndex& URLPatternIndex::operator=(URLPatternIndex&&) = default;
+URLPatternIndex::~URLPatternIndex() = default;
+
+bool URLPatternIndex::MatchesURL(const GURL& url) const {
+  // URLPattern matches filesystem: URLs against their inner URL.
+  const GURL& host_url = url.SchemeIs(url::kFileSystemScheme) && url.inner_url()
+                             ? *url.inner_url()
+                             : url;
+  base::StringPiece host = NormalizeHost(host_url.host_piece());
+
+  if (MatchesAny(exact_hosts_, host, url))
+    return true;
+
+  // Walk up the domain, e.g. "a.b.com", "b.com", "com" and finally "".
+  for (;;) {
+    if (MatchesAny(subdomain_hosts_, host, url))
+      return true;
+    if (host.empty())
+      return false;
+    size_t dot = host.find('.');
+    host = dot == base::StringPiece::npos ? base::StringPiece()
+                                          : host.substr(dot + 1);
+  }
+}
+
+bool URLPatternIndex::MatchesAny(const HostMap& map,
+                                 base::StringPiece host,
+                                 const GURL& url) const {
+  if (map.empty())
+    return false;
+  auto it = map.find(host);
+  if (it == map.end())
+    return false;
+  for (const URLPattern* pattern : it->second) {
+    if (pattern->MatchesURL(url))
+      return true;
+  }
+  return false;
+}
+
+void URLPatternIndex::BuildHostMaps() {
+  for (const URLPattern& pattern : patterns_) {
+    if (pattern.match_all_urls()) {
+      subdomain_hosts_[std::string()].push_back(&pattern);
+      continue;
+    }
+    std::string host = NormalizeHost(pattern.host()).as_string();
+    if (pattern.match_subdomains())
+      subdomain_hosts_[host].push_back(&pattern);
+    else
+      exact_hosts_[host].push_back(&pattern);
+  }
+}
+
+}  // namespace electron
@@ -0,0 +1,64 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_NET_URL_PATTERN_INDEX_H_
+#define SHELL_BROWSER_NET_URL_PATTERN_INDEX_H_
+
+#include <functional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "base/containers/flat_map.h"
+#include "base/strings/string_piece.h"
+#include "extensions/common/url_pattern.h"
+#include "url/gurl.h"
+
+namespace electron {
+
+// Matches URLs against a set of URLPatterns by host.
+//
+// Patterns are bucketed by the host they match, and those matching subdomains
+// by their host suffix, so a lookup only runs URLPattern::MatchesURL on the
+// patterns whose host could match the URL instead of on every pattern. The
+// scheme, port and path are still checked by URLPattern.
+class URLPatternIndex {
+ public:
+  URLPatternIndex();
+  explicit URLPatternIndex(std::set<URLPattern> patterns);
+  URLPatternIndex(const URLPatternIndex&);
+  URLPatternIndex& operator=(const URLPatternIndex&);
+  URLPatternIndex(URLPatternIndex&&);
+  URLPatternIndex& operator=(URLPatternIndex&&);
+  ~URLPatternIndex();
+
+  bool empty() const { return patterns_.empty(); }
+
+  // Whether any of the patterns matches |url|.
+  bool MatchesURL(const GURL& url) const;
+
+ private:
+  // Looked up by StringPiece, so matching a URL doesn't allocate the hosts
+  // it walks up.
+  using HostMap =
+      base::flat_map<std::string, std::vector<const URLPattern*>, std::less<>>;
+
+  void BuildHostMaps();
+
+  bool MatchesAny(const HostMap& map,
+                  base::StringPiece host,
+                  const GURL& url) const;
+
+  // The maps point into the nodes of |patterns_|, which moving the set keeps.
+  std::set<URLPattern> patterns_;
+  // host => patterns matching exactly that host.
+  HostMap exact_hosts_;
+  // host => patterns matching the host and its subdomains, the empty host
+  // holds the patterns matching every host.
+  HostMap subdomain_hosts_;
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_NET_URL_PATTERN_INDEX_H_
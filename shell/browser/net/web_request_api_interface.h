@@ -24,6 +24,12 @@ class WebRequestAPI {
                               int error_code)>;
 
   virtual bool HasListener() const = 0;
+  // Whether the filter of any listener matches |url|. Requests that match no
+  // filter are passed to the network until they are redirected to a URL that
+  // does.
+  virtual bool HasListenerForURL(const GURL& url) const = 0;
+  // Records whether a request went through the proxy or bypassed it.
+  virtual void CountRequest(bool proxied) = 0;
   virtual int OnBeforeRequest(extensions::WebRequestInfo* info,
                               const network::ResourceRequest& request,
                               net::CompletionOnceCallback callback,
@@ -0,0 +1,79 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/osr/osr_begin_frame_clock.h"
+
+#include <map>
+
+#include "base/memory/ptr_util.h"
+#include "base/no_destructor.h"
+#include "base/single_thread_task_runner.h"
+#include "base/task/post_task.h"
+#include "base/time/time.h"
+#include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
+
+namespace electron {
+
+namespace {
+
+using ClockMap = std::map<int, std::unique_ptr<OffScreenBeginFrameClock>>;
+
+ClockMap& GetClocks() {
+  static base::NoDestructor<ClockMap> clocks;
+  return *clocks;
+}
+
+}  // namespace
+
+// static
+OffScreenBeginFrameClock* OffScreenBeginFrameClock::GetForInterval(
+    int interval_us) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  DCHECK_GT(interval_us, 0);
+
+  auto& clocks = GetClocks();
+  auto it = clocks.find(interval_us);
+  if (it != clocks.end())
+    return it->second.get();
+
+  auto* clock = new OffScreenBeginFrameClock(interval_us);
+  clocks.emplace(interval_us, base::WrapUnique(clock));
+  return clock;
+}
+
+OffScreenBeginFrameClock::OffScreenBeginFrameClock(int interval_us)
+    : interval_us_(interval_us) {
+  time_source_ = std::make_unique<viz::DelayBasedTimeSource>(
+      base::CreateSingleThreadTaskRunner({content::BrowserThread::UI}).get());
+  // All views sharing this clock tick on the same timebase, so their frames
+  // are produced in lockstep rather than at arbitrary phase offsets.
+  time_source_->SetTimebaseAndInterval(
+      base::TimeTicks(), base::TimeDelta::FromMicroseconds(interval_us));
+  time_source_->SetClient(this);
+}
+
+OffScreenBeginFrameClock::~OffScreenBeginFrameClock() = default;
+
+void OffScreenBeginFrameClock::AddObserver(Observer* observer) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  observers_.AddObserver(observer);
+  if (observer_count_++ == 0)
+    time_source_->SetActive(true);
+}
+
+void OffScreenBeginFrameClock::RemoveObserver(Observer* observer) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  DCHECK_GT(observer_count_, 0u);
+  observers_.RemoveObserver(observer);
+  if (--observer_count_ == 0)
+    time_source_->SetActive(false);
+}
+
+void OffScreenBeginFrameClock::OnTimerTick() {
+  for (auto& observer : observers_)
+    observer.OnBeginFrameClockTick();
+}
+
+}  // namespace electron
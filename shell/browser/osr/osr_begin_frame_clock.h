@@ -0,0 +1,57 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_OSR_OSR_BEGIN_FRAME_CLOCK_H_
+#define SHELL_BROWSER_OSR_OSR_BEGIN_FRAME_CLOCK_H_
+
+#include <memory>
+
+#include "base/macros.h"
+#include "base/observer_list.h"
+#include "base/observer_list_types.h"
+#include "components/viz/common/frame_sinks/delay_based_time_source.h"
+
+namespace electron {
+
+// A begin-frame clock that is shared by every offscreen view rendering at the
+// same frame interval. Instead of each OffScreenRenderWidgetHostView owning a
+// DelayBasedTimeSource, views subscribe to the clock for their interval and
+// are ticked together, so N offscreen WebContents cost one timer per distinct
+// frame rate. The clock only runs while it has at least one observer.
+class OffScreenBeginFrameClock : public viz::DelayBasedTimeSourceClient {
+ public:
+  class Observer : public base::CheckedObserver {
+   public:
+    virtual void OnBeginFrameClockTick() = 0;
+  };
+
+  // Returns the clock for |interval_us|, creating it on first use. Clocks are
+  // owned by a process-wide registry and live until shutdown.
+  static OffScreenBeginFrameClock* GetForInterval(int interval_us);
+
+  ~OffScreenBeginFrameClock() override;
+
+  void AddObserver(Observer* observer);
+  void RemoveObserver(Observer* observer);
+
+  int interval_us() const { return interval_us_; }
+  size_t observer_count() const { return observer_count_; }
+
+ private:
+  explicit OffScreenBeginFrameClock(int interval_us);
+
+  // viz::DelayBasedTimeSourceClient:
+  void OnTimerTick() override;
+
+  const int interval_us_;
+  size_t observer_count_ = 0;
+  std::unique_ptr<viz::DelayBasedTimeSource> time_source_;
+  base::ObserverList<Observer> observers_;
+
+  DISALLOW_COPY_AND_ASSIGN(OffScreenBeginFrameClock);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_OSR_OSR_BEGIN_FRAME_CLOCK_H_
@@ -18,7 +18,6 @@
 #include "base/time/time.h"
 #include "components/viz/common/features.h"
 #include "components/viz/common/frame_sinks/copy_output_request.h"
-#include "components/viz/common/frame_sinks/delay_based_time_source.h"
 #include "components/viz/common/gl_helper.h"
 #include "components/viz/common/quads/render_pass.h"
 #include "content/browser/renderer_host/cursor_manager.h"  // nogncheck
@@ -32,6 +31,7 @@
 #include "content/public/browser/gpu_data_manager.h"
 #include "content/public/browser/render_process_host.h"
 #include "media/base/video_frame.h"
+#include "shell/browser/osr/osr_begin_frame_clock.h"
 #include "third_party/blink/public/common/input/web_input_event.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "ui/compositor/compositor.h"
@@ -121,34 +121,44 @@ ui::MouseWheelEvent UiMouseWheelEventFromWebMouseEvent(
 
 }  // namespace
 
-class ElectronBeginFrameTimer : public viz::DelayBasedTimeSourceClient {
+class ElectronBeginFrameTimer : public OffScreenBeginFrameClock::Observer {
  public:
   ElectronBeginFrameTimer(int frame_rate_threshold_us,
                           const base::Closure& callback)
-      : callback_(callback) {
-    time_source_ = std::make_unique<viz::DelayBasedTimeSource>(
-        base::CreateSingleThreadTaskRunner({content::BrowserThread::UI}).get());
-    time_source_->SetTimebaseAndInterval(
-        base::TimeTicks(),
-        base::TimeDelta::FromMicroseconds(frame_rate_threshold_us));
-    time_source_->SetClient(this);
-  }
+      : callback_(callback),
+        clock_(OffScreenBeginFrameClock::GetForInterval(
+            frame_rate_threshold_us)) {}
 
-  void SetActive(bool active) { time_source_->SetActive(active); }
+  ~ElectronBeginFrameTimer() override { SetActive(false); }
 
-  bool IsActive() const { return time_source_->Active(); }
+  void SetActive(bool active) {
+    if (active_ == active)
+      return;
+    active_ = active;
+    if (active_)
+      clock_->AddObserver(this);
+    else
+      clock_->RemoveObserver(this);
+  }
+
+  bool IsActive() const { return active_; }
 
   void SetFrameRateThresholdUs(int frame_rate_threshold_us) {
-    time_source_->SetTimebaseAndInterval(
-        base::TimeTicks::Now(),
-        base::TimeDelta::FromMicroseconds(frame_rate_threshold_us));
+    if (clock_->interval_us() == frame_rate_threshold_us)
+      return;
+    bool active = active_;
+    SetActive(false);
+    clock_ = OffScreenBeginFrameClock::GetForInterval(frame_rate_threshold_us);
+    SetActive(active);
   }
 
  private:
-  void OnTimerTick() override { callback_.Run(); }
+  // OffScreenBeginFrameClock::Observer:
+  void OnBeginFrameClockTick() override { callback_.Run(); }
 
   const base::Closure callback_;
-  std::unique_ptr<viz::DelayBasedTimeSource> time_source_;
+  OffScreenBeginFrameClock* clock_;
+  bool active_ = false;
 
   DISALLOW_COPY_AND_ASSIGN(ElectronBeginFrameTimer);
 };
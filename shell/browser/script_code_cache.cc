@@ -0,0 +1,203 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/script_code_cache.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/files/file_enumerator.h"
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
+#include "base/hash/sha1.h"
+#include "base/path_service.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_util.h"
+#include "base/task/post_task.h"
+#include "base/task_runner_util.h"
+#include "shell/browser/electron_paths.h"
+#include "url/gurl.h"
+
+namespace electron {
+
+namespace {
+
+// Total size of the entries kept in memory and on disk.
+const size_t kMaxSize = 32 * 1024 * 1024;
+// Preloads producing more data than this are not worth caching.
+const size_t kMaxEntrySize = 4 * 1024 * 1024;
+// Length of a hex encoded SHA-1.
+const size_t kKeyLength = 40;
+
+ScriptCodeCache* g_instance = nullptr;
+
+// Reads the newest entries that fit in the budget. The others are deleted since
+// they were most likely written by an older app or V8 and would never hit.
+std::vector<std::pair<std::string, std::vector<uint8_t>>> ReadEntries(
+    const base::FilePath& dir) {
+  struct FileInfo {
+    base::FilePath path;
+    std::string key;
+    base::Time last_modified;
+    int64_t size;
+  };
+  std::vector<FileInfo> files;
+  base::FileEnumerator enumerator(dir, false, base::FileEnumerator::FILES);
+  for (base::FilePath path = enumerator.Next(); !path.empty();
+       path = enumerator.Next()) {
+    auto info = enumerator.GetInfo();
+    std::string key = path.BaseName().MaybeAsASCII();
+    if (!ScriptCodeCache::IsValidKey(key)) {
+      base::DeleteFile(path, false);
+      continue;
+    }
+    files.push_back({path, key, info.GetLastModifiedTime(), info.GetSize()});
+  }
+  std::sort(files.begin(), files.end(),
+            [](const FileInfo& a, const FileInfo& b) {
+              return a.last_modified > b.last_modified;
+            });
+
+  std::vector<std::pair<std::string, std::vector<uint8_t>>> entries;
+  size_t size = 0;
+  for (const auto& file : files) {
+    std::string data;
+    if (file.size <= 0 || static_cast<size_t>(file.size) > kMaxEntrySize ||
+        size + static_cast<size_t>(file.size) > kMaxSize ||
+        !base::ReadFileToStringWithMaxSize(file.path, &data, kMaxEntrySize)) {
+      base::DeleteFile(file.path, false);
+      continue;
+    }
+    size += data.size();
+    entries.emplace_back(file.key,
+                         std::vector<uint8_t>(data.begin(), data.end()));
+  }
+  std::reverse(entries.begin(), entries.end());
+  return entries;
+}
+
+void WriteEntry(const base::FilePath& path, const std::vector<uint8_t>& data) {
+  if (!base::CreateDirectory(path.DirName()))
+    return;
+  base::ImportantFileWriter::WriteFileAtomically(
+      path, base::StringPiece(reinterpret_cast<const char*>(data.data()),
+                              data.size()));
+}
+
+}  // namespace
+
+// static
+ScriptCodeCache* ScriptCodeCache::GetInstance() {
+  if (!g_instance)
+    g_instance = new ScriptCodeCache;
+  return g_instance;
+}
+
+// static
+bool ScriptCodeCache::IsValidKey(const std::string& key) {
+  return key.size() == kKeyLength &&
+         std::all_of(key.begin(), key.end(), [](char c) {
+           return base::IsAsciiDigit(c) || (c >= 'a' && c <= 'f');
+         });
+}
+
+// static
+std::string ScriptCodeCache::GetEntryKey(const GURL& site,
+                                         const std::string& script_key) {
+  if (!IsValidKey(script_key))
+    return std::string();
+  const std::string data = site.spec() + '\0' + script_key;
+  return base::ToLowerASCII(base::HexEncode(base::SHA1HashString(data).data(),
+                                            base::kSHA1Length));
+}
+
+ScriptCodeCache::ScriptCodeCache()
+    : file_task_runner_(base::CreateSequencedTaskRunner(
+          {base::ThreadPool(), base::MayBlock(),
+           base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})),
+      entries_(EntryMap::NO_AUTO_EVICT) {}
+
+ScriptCodeCache::~ScriptCodeCache() = default;
+
+void ScriptCodeCache::Load() {
+  if (load_started_)
+    return;
+  load_started_ = true;
+
+  base::FilePath user_data;
+  if (!base::PathService::Get(DIR_USER_DATA, &user_data))
+    return;
+  cache_dir_ = user_data.Append(FILE_PATH_LITERAL("Code Cache"))
+                   .Append(FILE_PATH_LITERAL("electron"));
+  base::PostTaskAndReplyWithResult(
+      file_task_runner_.get(), FROM_HERE,
+      base::BindOnce(&ReadEntries, cache_dir_),
+      base::BindOnce(&ScriptCodeCache::OnLoaded,
+                     weak_ptr_factory_.GetWeakPtr()));
+}
+
+std::vector<uint8_t> ScriptCodeCache::Get(const GURL& site,
+                                          const std::string& script_key) {
+  Load();
+  auto it = entries_.Get(GetEntryKey(site, script_key));
+  if (it == entries_.end())
+    return std::vector<uint8_t>();
+  ++hit_count_;
+  return it->second;
+}
+
+void ScriptCodeCache::Put(const GURL& site,
+                          const std::string& script_key,
+                          std::vector<uint8_t> data) {
+  Load();
+  const std::string key = GetEntryKey(site, script_key);
+  if (key.empty() || data.empty() || data.size() > kMaxEntrySize)
+    return;
+
+  auto existing = entries_.Peek(key);
+  if (existing != entries_.end()) {
+    ++replace_count_;
+    size_ -= existing->second.size();
+    entries_.Erase(existing);
+  }
+
+  if (!cache_dir_.empty()) {
+    file_task_runner_->PostTask(
+        FROM_HERE, base::BindOnce(&WriteEntry,
+                                  cache_dir_.AppendASCII(key), data));
+  }
+  size_ += data.size();
+  entries_.Put(key, std::move(data));
+  Evict();
+}
+
+void ScriptCodeCache::OnLoaded(LoadedEntries entries) {
+  // Entries written since the load started replace their copies on disk.
+  for (auto& entry : entries) {
+    if (entries_.Peek(entry.first) != entries_.end())
+      continue;
+    size_ += entry.second.size();
+    entries_.Put(entry.first, std::move(entry.second));
+  }
+  Evict();
+}
+
+void ScriptCodeCache::Evict() {
+  while (size_ > kMaxSize && !entries_.empty()) {
+    auto oldest = entries_.rbegin();
+    size_ -= oldest->second.size();
+    if (!cache_dir_.empty()) {
+      file_task_runner_->PostTask(
+          FROM_HERE,
+          base::BindOnce(base::IgnoreResult(&base::DeleteFile),
+                         cache_dir_.AppendASCII(oldest->first), false));
+    }
+    entries_.Erase(oldest);
+  }
+}
+
+}  // namespace electron
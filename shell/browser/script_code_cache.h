@@ -0,0 +1,94 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_SCRIPT_CODE_CACHE_H_
+#define SHELL_BROWSER_SCRIPT_CODE_CACHE_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/containers/mru_cache.h"
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequenced_task_runner.h"
+
+class GURL;
+
+namespace electron {
+
+// Persistent cache of the V8 code caches produced by renderers for preload
+// scripts.
+//
+// Renderers key each script by a hash of the V8 version and the script source,
+// so an entry can never be used for a different script or V8 build; V8 also
+// rejects data it can't consume. The entries are partitioned by the site of
+// the renderer that produced them, so a compromised renderer can't get its
+// data run by the renderers of other sites. Entries live in memory for
+// synchronous lookups and are mirrored to "<userData>/Code Cache/electron",
+// which is read on a background sequence when the app starts. Until it has
+// been read every lookup is a miss, which only costs a regular compile.
+//
+// Must only be used on the UI thread.
+class ScriptCodeCache {
+ public:
+  static ScriptCodeCache* GetInstance();
+
+  // Starts reading the entries stored in the user data directory, does
+  // nothing when already started.
+  void Load();
+
+  // Returns the data cached for the script hashed into |script_key| by a
+  // renderer of |site|, or an empty vector on a miss.
+  std::vector<uint8_t> Get(const GURL& site, const std::string& script_key);
+  void Put(const GURL& site,
+           const std::string& script_key,
+           std::vector<uint8_t> data);
+
+  // Lookups that returned data, and stored entries that replaced existing
+  // ones. Renderers only produce data on a miss or when V8 rejected the data
+  // they got, so replacements count the hits that could not be consumed.
+  size_t hit_count() const { return hit_count_; }
+  size_t replace_count() const { return replace_count_; }
+
+  // Script keys and entry keys are hex encoded SHA-1s, anything else is
+  // rejected so the entry keys can be used as file names.
+  static bool IsValidKey(const std::string& key);
+
+ private:
+  using EntryMap = base::MRUCache<std::string, std::vector<uint8_t>>;
+  // Entries read from disk, least recently written first.
+  using LoadedEntries =
+      std::vector<std::pair<std::string, std::vector<uint8_t>>>;
+
+  ScriptCodeCache();
+  ~ScriptCodeCache();
+
+  // Returns the key of the entry of |script_key| in the partition of |site|,
+  // or an empty string when |script_key| isn't valid.
+  static std::string GetEntryKey(const GURL& site,
+                                 const std::string& script_key);
+
+  void OnLoaded(LoadedEntries entries);
+  void Evict();
+
+  scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
+  base::FilePath cache_dir_;
+  bool load_started_ = false;
+
+  EntryMap entries_;
+  size_t size_ = 0;
+  size_t hit_count_ = 0;
+  size_t replace_count_ = 0;
+
+  base::WeakPtrFactory<ScriptCodeCache> weak_ptr_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(ScriptCodeCache);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_SCRIPT_CODE_CACHE_H_
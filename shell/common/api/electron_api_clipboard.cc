@@ -4,20 +4,140 @@
 
 #include "shell/common/api/electron_api_clipboard.h"
 
+#include <utility>
+
+#include "base/bind.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/post_task.h"
 #include "shell/common/gin_converters/image_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/promise.h"
 #include "shell/common/node_includes.h"
+#include "shell/common/skia_util.h"
 #include "third_party/skia/include/core/SkBitmap.h"
-#include "third_party/skia/include/core/SkImageInfo.h"
-#include "third_party/skia/include/core/SkPixmap.h"
 #include "ui/base/clipboard/clipboard_format_type.h"
 #include "ui/base/clipboard/scoped_clipboard_writer.h"
+#include "ui/gfx/codec/png_codec.h"
 
 namespace electron {
 
 namespace api {
 
+namespace {
+
+// The format other applications exchange PNG images with.
+ui::ClipboardFormatType GetPNGFormatType() {
+#if defined(OS_MACOSX)
+  return ui::ClipboardFormatType::GetType("public.png");
+#elif defined(OS_WIN)
+  return ui::ClipboardFormatType::GetType("PNG");
+#else
+  return ui::ClipboardFormatType::GetType("image/png");
+#endif
+}
+
+// Reads the PNG data of the clipboard when it has some, so that it doesn't
+// have to be decoded and encoded again, otherwise reads its image into
+// |bitmap|.
+std::string ReadPNGOrBitmap(ui::ClipboardBuffer buffer, SkBitmap* bitmap) {
+  ui::Clipboard* clipboard = ui::Clipboard::GetForCurrentThread();
+  const ui::ClipboardFormatType format = GetPNGFormatType();
+  std::string png;
+  gfx::Size pixel_size;
+  if (buffer == ui::ClipboardBuffer::kCopyPaste &&
+      clipboard->IsFormatAvailable(format, buffer)) {
+    clipboard->ReadData(format, &png);
+    if (!util::GetPNGSize(reinterpret_cast<const unsigned char*>(png.data()),
+                          png.size(), &pixel_size))
+      png.clear();
+  }
+  if (png.empty())
+    *bitmap = clipboard->ReadImage(buffer);
+  return png;
+}
+
+std::vector<unsigned char> EncodePNG(const SkBitmap& bitmap) {
+  std::vector<unsigned char> png;
+  if (!bitmap.drawsNothing())
+    gfx::PNGCodec::EncodeBGRASkBitmap(bitmap, false, &png);
+  return png;
+}
+
+// Decodes the bitmap written along with PNG |data| for the applications that
+// don't read the PNG format, returns false when |data| isn't a PNG image.
+// X11 applications exchange images as PNG data only, so no bitmap is needed
+// there.
+bool DecodePNGForWrite(const unsigned char* data,
+                       size_t size,
+                       SkBitmap* bitmap) {
+#if defined(OS_LINUX)
+  gfx::Size pixel_size;
+  return util::GetPNGSize(data, size, &pixel_size);
+#else
+  return gfx::PNGCodec::Decode(data, size, bitmap);
+#endif
+}
+
+void WritePNGToClipboard(ui::ClipboardBuffer buffer,
+                         base::span<const uint8_t> png,
+                         const SkBitmap& bitmap) {
+  ui::ScopedClipboardWriter writer(buffer);
+  if (!bitmap.drawsNothing())
+    writer.WriteImage(bitmap);
+  writer.WriteData(base::UTF8ToUTF16(GetPNGFormatType().Serialize()),
+                   mojo_base::BigBuffer(png));
+}
+
+template <typename T>
+void DeleteData(char*, void* hint) {
+  delete static_cast<T*>(hint);
+}
+
+// Hands |data| over to a Buffer without copying it.
+template <typename T>
+v8::Local<v8::Value> ToBuffer(v8::Isolate* isolate, T data) {
+  if (data.empty())
+    return node::Buffer::New(isolate, 0).ToLocalChecked();
+  auto* owned = new T(std::move(data));
+  return node::Buffer::New(isolate, reinterpret_cast<char*>(&(*owned)[0]),
+                           owned->size(), &DeleteData<T>, owned)
+      .ToLocalChecked();
+}
+
+void ResolveEncodedPNG(gin_helper::Promise<v8::Local<v8::Value>> promise,
+                       std::vector<unsigned char> png) {
+  v8::Isolate* isolate = promise.isolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(promise.GetContext());
+  promise.Resolve(ToBuffer(isolate, std::move(png)));
+}
+
+struct DecodedPNG {
+  std::vector<unsigned char> png;
+  SkBitmap bitmap;
+  bool success = false;
+};
+
+DecodedPNG DecodePNGOnWorker(std::vector<unsigned char> png) {
+  DecodedPNG result;
+  result.success = DecodePNGForWrite(png.data(), png.size(), &result.bitmap);
+  result.png = std::move(png);
+  return result;
+}
+
+void WriteDecodedPNG(gin_helper::Promise<void> promise,
+                     ui::ClipboardBuffer buffer,
+                     DecodedPNG decoded) {
+  if (!decoded.success) {
+    promise.RejectWithErrorMessage("buffer must be a PNG image");
+    return;
+  }
+  WritePNGToClipboard(buffer, decoded.png, decoded.bitmap);
+  promise.Resolve();
+}
+
+}  // namespace
+
 ui::ClipboardBuffer Clipboard::GetClipboardBuffer(gin_helper::Arguments* args) {
   std::string type;
   if (args->GetNext(&type) && type == "selection")
@@ -56,9 +176,7 @@ std::string Clipboard::Read(const std::string& format_string) {
 
 v8::Local<v8::Value> Clipboard::ReadBuffer(const std::string& format_string,
                                            gin_helper::Arguments* args) {
-  std::string data = Read(format_string);
-  return node::Buffer::Copy(args->isolate(), data.data(), data.length())
-      .ToLocalChecked();
+  return ToBuffer(args->isolate(), Read(format_string));
 }
 
 void Clipboard::WriteBuffer(const std::string& format,
@@ -187,13 +305,77 @@ gfx::Image Clipboard::ReadImage(gin_helper::Arguments* args) {
 void Clipboard::WriteImage(const gfx::Image& image,
                            gin_helper::Arguments* args) {
   ui::ScopedClipboardWriter writer(GetClipboardBuffer(args));
-  SkBitmap orig = image.AsBitmap();
-  SkBitmap bmp;
+  // The clipboard converts the pixels into its own format, so the bitmap is
+  // written as is instead of being copied first.
+  SkBitmap bitmap = image.AsBitmap();
+  if (!bitmap.drawsNothing())
+    writer.WriteImage(bitmap);
+}
 
-  if (bmp.tryAllocPixels(orig.info()) &&
-      orig.readPixels(bmp.info(), bmp.getPixels(), bmp.rowBytes(), 0, 0)) {
-    writer.WriteImage(bmp);
+v8::Local<v8::Value> Clipboard::ReadPNG(gin_helper::Arguments* args) {
+  SkBitmap bitmap;
+  std::string png = ReadPNGOrBitmap(GetClipboardBuffer(args), &bitmap);
+  if (!png.empty())
+    return ToBuffer(args->isolate(), std::move(png));
+  return ToBuffer(args->isolate(), EncodePNG(bitmap));
+}
+
+void Clipboard::WritePNG(const v8::Local<v8::Value> buffer,
+                         gin_helper::Arguments* args) {
+  if (!node::Buffer::HasInstance(buffer)) {
+    args->ThrowError("buffer must be a node Buffer");
+    return;
   }
+
+  base::span<const uint8_t> png(
+      reinterpret_cast<const uint8_t*>(node::Buffer::Data(buffer)),
+      node::Buffer::Length(buffer));
+  SkBitmap bitmap;
+  if (!DecodePNGForWrite(png.data(), png.size(), &bitmap)) {
+    args->ThrowError("buffer must be a PNG image");
+    return;
+  }
+  WritePNGToClipboard(GetClipboardBuffer(args), png, bitmap);
+}
+
+v8::Local<v8::Promise> Clipboard::ReadPNGAsync(gin_helper::Arguments* args) {
+  v8::Isolate* isolate = args->isolate();
+  SkBitmap bitmap;
+  std::string png = ReadPNGOrBitmap(GetClipboardBuffer(args), &bitmap);
+  if (!png.empty()) {
+    return gin_helper::Promise<v8::Local<v8::Value>>::ResolvedPromise(
+        isolate, ToBuffer(isolate, std::move(png)));
+  }
+
+  gin_helper::Promise<v8::Local<v8::Value>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  base::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::ThreadPool(), base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(&EncodePNG, std::move(bitmap)),
+      base::BindOnce(&ResolveEncodedPNG, std::move(promise)));
+  return handle;
+}
+
+v8::Local<v8::Promise> Clipboard::WritePNGAsync(
+    const v8::Local<v8::Value> buffer,
+    gin_helper::Arguments* args) {
+  gin_helper::Promise<void> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  if (!node::Buffer::HasInstance(buffer)) {
+    promise.RejectWithErrorMessage("buffer must be a node Buffer");
+    return handle;
+  }
+
+  // The Buffer may change before the worker runs, so its data is copied.
+  const auto* data =
+      reinterpret_cast<const unsigned char*>(node::Buffer::Data(buffer));
+  std::vector<unsigned char> png(data, data + node::Buffer::Length(buffer));
+  base::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::ThreadPool(), base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(&DecodePNGOnWorker, std::move(png)),
+      base::BindOnce(&WriteDecodedPNG, std::move(promise),
+                     GetClipboardBuffer(args)));
+  return handle;
 }
 
 #if !defined(OS_MACOSX)
@@ -233,6 +415,10 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("writeBookmark", &electron::api::Clipboard::WriteBookmark);
   dict.SetMethod("readImage", &electron::api::Clipboard::ReadImage);
   dict.SetMethod("writeImage", &electron::api::Clipboard::WriteImage);
+  dict.SetMethod("readPNG", &electron::api::Clipboard::ReadPNG);
+  dict.SetMethod("writePNG", &electron::api::Clipboard::WritePNG);
+  dict.SetMethod("readPNGAsync", &electron::api::Clipboard::ReadPNGAsync);
+  dict.SetMethod("writePNGAsync", &electron::api::Clipboard::WritePNGAsync);
   dict.SetMethod("readFindText", &electron::api::Clipboard::ReadFindText);
   dict.SetMethod("writeFindText", &electron::api::Clipboard::WriteFindText);
   dict.SetMethod("readBuffer", &electron::api::Clipboard::ReadBuffer);
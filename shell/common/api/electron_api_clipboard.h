@@ -53,6 +53,17 @@ class Clipboard {
   static gfx::Image ReadImage(gin_helper::Arguments* args);
   static void WriteImage(const gfx::Image& image, gin_helper::Arguments* args);
 
+  // PNG data is read and written as is when the clipboard supports it.
+  static v8::Local<v8::Value> ReadPNG(gin_helper::Arguments* args);
+  static void WritePNG(const v8::Local<v8::Value> buffer,
+                       gin_helper::Arguments* args);
+
+  // The clipboard is only accessed on the current thread, PNG data is encoded
+  // and decoded on the thread pool.
+  static v8::Local<v8::Promise> ReadPNGAsync(gin_helper::Arguments* args);
+  static v8::Local<v8::Promise> WritePNGAsync(const v8::Local<v8::Value> buffer,
+                                              gin_helper::Arguments* args);
+
   static base::string16 ReadFindText();
   static void WriteFindText(const base::string16& text);
 
@@ -2,8 +2,11 @@
 // Use of this source code is governed by the MIT license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
 #include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "base/bind.h"
 #include "gin/data_object_builder.h"
@@ -12,6 +15,14 @@
 #include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 
+#if defined(OS_LINUX)
+#include "shell/browser/linux/crash_pipeline.h"
+#include "shell/common/gin_converters/std_converter.h"
+#include "shell/common/gin_helper/locker.h"
+#include "shell/common/gin_helper/promise.h"
+#include "url/gurl.h"
+#endif
+
 #include "shell/common/node_includes.h"
 
 using crash_reporter::CrashReporter;
@@ -32,10 +43,87 @@ struct Converter<CrashReporter::UploadReportResult> {
   }
 };
 
+#if defined(OS_LINUX)
+template <>
+struct Converter<electron::CrashSignatureSummary> {
+  static v8::Local<v8::Value> ToV8(
+      v8::Isolate* isolate,
+      const electron::CrashSignatureSummary& summary) {
+    auto context = isolate->GetCurrentContext();
+    return gin::DataObjectBuilder(isolate)
+        .Set("id", summary.id)
+        .Set("processType", summary.signature.process_type)
+        .Set("reason", summary.signature.GetReason())
+        .Set("module", summary.signature.module)
+        .Set("offset", static_cast<double>(summary.signature.offset))
+        .Set("symbol", summary.symbol)
+        .Set("count", summary.count)
+        .Set("droppedCount", summary.dropped_count)
+        .Set("pendingCount", summary.pending_count)
+        .Set("uploadedCount", summary.uploaded_count)
+        .Set("firstSeen",
+             v8::Date::New(context, summary.first_seen.ToJsTime())
+                 .ToLocalChecked())
+        .Set("lastSeen", v8::Date::New(context, summary.last_seen.ToJsTime())
+                             .ToLocalChecked())
+        .Build();
+  }
+};
+#endif
+
 }  // namespace gin
 
 namespace {
 
+#if defined(OS_LINUX)
+void StartCrashPipeline(const base::FilePath& crashes_dir,
+                        const gin_helper::Dictionary& options) {
+  // The options are validated in JS, they are only clamped here so a bad
+  // value can't make the pipeline spin or disable its limits.
+  electron::CrashPipeline::Options pipeline_options;
+  std::string upload_url;
+  if (options.Get("uploadURL", &upload_url))
+    pipeline_options.upload_url = GURL(upload_url);
+  options.Get("compress", &pipeline_options.compress);
+  int count;
+  if (options.Get("maxReportsPerSignature", &count))
+    pipeline_options.max_reports_per_signature = std::max(count, 0);
+  if (options.Get("batchSize", &count))
+    pipeline_options.batch_size = std::max(count, 1);
+  if (options.Get("maxPendingReports", &count))
+    pipeline_options.max_pending_reports = std::max(count, 1);
+  double seconds;
+  if (options.Get("rateLimitWindow", &seconds))
+    pipeline_options.rate_limit_window =
+        base::TimeDelta::FromSecondsD(std::max(seconds, 1.0));
+  if (options.Get("uploadInterval", &seconds))
+    pipeline_options.upload_interval =
+        base::TimeDelta::FromSecondsD(std::max(seconds, 1.0));
+  options.Get("symbolsDirectory", &pipeline_options.symbols_dir);
+  electron::CrashPipeline::Start(crashes_dir, pipeline_options);
+}
+
+v8::Local<v8::Promise> GetCrashSignatures(v8::Isolate* isolate) {
+  gin_helper::Promise<std::vector<electron::CrashSignatureSummary>> promise(
+      isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  auto* pipeline = electron::CrashPipeline::Get();
+  if (!pipeline) {
+    promise.RejectWithErrorMessage("The crash pipeline has not been started");
+    return handle;
+  }
+  pipeline->GetSignatures(base::BindOnce(
+      [](gin_helper::Promise<std::vector<electron::CrashSignatureSummary>>
+             promise,
+         std::vector<electron::CrashSignatureSummary> signatures) {
+        promise.Resolve(signatures);
+      },
+      std::move(promise)));
+  return handle;
+}
+#endif
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
@@ -60,6 +148,15 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod(
       "getUploadToServer",
       base::BindRepeating(&CrashReporter::GetUploadToServer, reporter));
+  dict.SetMethod(
+      "setUploadsDeferred",
+      base::BindRepeating(&CrashReporter::SetUploadsDeferred, reporter));
+#if defined(OS_LINUX)
+  if (gin_helper::Locker::IsBrowserProcess()) {
+    dict.SetMethod("startCrashPipeline", &StartCrashPipeline);
+    dict.SetMethod("getCrashSignatures", &GetCrashSignatures);
+  }
+#endif
 }
 
 }  // namespace
@@ -10,9 +10,13 @@
 #include <vector>
 
 #include "base/files/file_util.h"
+#include "base/logging.h"
+#include "base/memory/ref_counted.h"
+#include "base/optional.h"
 #include "base/strings/pattern.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/post_task.h"
 #include "base/threading/thread_restrictions.h"
 #include "net/base/data_url.h"
 #include "shell/common/asar/asar_util.h"
@@ -22,8 +26,10 @@
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/object_template_builder.h"
+#include "shell/common/gin_helper/promise.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/skia_util.h"
+#include "skia/ext/image_operations.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
 #include "third_party/skia/include/core/SkPixelRef.h"
@@ -100,39 +106,444 @@ base::win::ScopedHICON ReadICOFromPath(int size, const base::FilePath& path) {
 
 void Noop(char*, void*) {}
 
+// Number of encodings kept by each image.
+const size_t kMaxEncodedCacheEntries = 8;
+
+// The options of image.resize().
+struct ResizeOptions {
+  base::Optional<int> width;
+  base::Optional<int> height;
+  skia::ImageOperations::ResizeMethod method =
+      skia::ImageOperations::ResizeMethod::RESIZE_BEST;
+};
+
+ResizeOptions ParseResizeOptions(const base::DictionaryValue& options) {
+  ResizeOptions result;
+  int value;
+  if (options.GetInteger("width", &value))
+    result.width = value;
+  if (options.GetInteger("height", &value))
+    result.height = value;
+
+  std::string quality;
+  options.GetString("quality", &quality);
+  if (quality == "good")
+    result.method = skia::ImageOperations::ResizeMethod::RESIZE_GOOD;
+  else if (quality == "better")
+    result.method = skia::ImageOperations::ResizeMethod::RESIZE_BETTER;
+  return result;
+}
+
+// Returns the size an image of |size| is resized to, preserving the aspect
+// ratio when only one dimension is given.
+gfx::Size GetResizedSize(const gfx::Size& size, const ResizeOptions& options) {
+  float aspect_ratio = 1.f;
+  if (!size.IsEmpty())
+    aspect_ratio =
+        static_cast<float>(size.width()) / static_cast<float>(size.height());
+
+  if (options.width && !options.height) {
+    // Scale height to preserve original aspect ratio
+    gfx::Size resized(*options.width, *options.width);
+    return gfx::ScaleToRoundedSize(resized, 1.f, 1.f / aspect_ratio);
+  } else if (options.height && !options.width) {
+    // Scale width to preserve original aspect ratio
+    gfx::Size resized(*options.height, *options.height);
+    return gfx::ScaleToRoundedSize(resized, aspect_ratio, 1.f);
+  }
+  return gfx::Size(options.width.value_or(size.width()),
+                   options.height.value_or(size.height()));
+}
+
+// Returns the size of an image made of |png_reps| from the PNG headers, where
+// gfx::Image would decode the whole image.
+gfx::Size GetPNGRepsSize(const std::vector<gfx::ImagePNGRep>& png_reps) {
+  gfx::Size pixel_size;
+  if (png_reps.empty() ||
+      !electron::util::GetPNGSize(png_reps.front().raw_data->front(),
+                                  png_reps.front().raw_data->size(),
+                                  &pixel_size))
+    return gfx::Size();
+  return gfx::ScaleToFlooredSize(pixel_size, 1.f / png_reps.front().scale);
+}
+
+// Work done on the thread pool by the asynchronous methods. Images cross
+// threads as their representations, since gfx::ImageSkia is bound to the
+// sequence that created it.
+struct ImageTask {
+  enum class Output { kImage, kPNG, kJPEG, kDataURL };
+
+  // The source, the first one that is set is used.
+  scoped_refptr<base::RefCountedMemory> png;
+  std::vector<gfx::ImageSkiaRep> reps;
+  std::vector<gfx::ImagePNGRep> png_reps;
+  base::FilePath path;
+  std::vector<unsigned char> buffer;
+  double buffer_scale_factor = 1.;
+
+  base::Optional<ResizeOptions> resize;
+
+  Output output = Output::kImage;
+  float scale_factor = 1.f;
+  int quality = 90;
+};
+
+struct ImageTaskResult {
+  ImageTask::Output output = ImageTask::Output::kImage;
+  base::FilePath path;
+  std::vector<gfx::ImageSkiaRep> reps;
+  // Set instead of |reps| for PNG images that don't need to be decoded.
+  std::vector<gfx::ImagePNGRep> png_reps;
+  std::vector<unsigned char> encoded;
+  std::string data_url;
+};
+
+ImageTask CreateImageTask(const gfx::Image& image,
+                          const std::vector<gfx::ImagePNGRep>& png_reps,
+                          float scale_factor) {
+  ImageTask task;
+  task.scale_factor = scale_factor;
+  if (!png_reps.empty()) {
+    task.png_reps = png_reps;
+    return task;
+  }
+  if (image.IsEmpty())
+    return task;
+
+  // Images created from PNG data are decoded on the thread pool as well.
+  if (image.HasRepresentation(gfx::Image::kImageRepPNG) &&
+      !image.HasRepresentation(gfx::Image::kImageRepSkia)) {
+    task.png = image.As1xPNGBytes();
+    if (task.png->size() > 0)
+      return task;
+    task.png = nullptr;
+  }
+
+  gfx::ImageSkia image_skia = image.AsImageSkia();
+  task.reps = image_skia.image_reps();
+  if (task.reps.empty())
+    task.reps.push_back(image_skia.GetRepresentation(scale_factor));
+  return task;
+}
+
+ImageTaskResult RunImageTask(ImageTask task) {
+  ImageTaskResult result;
+  result.output = task.output;
+
+  gfx::ImageSkia image;
+  if (task.png) {
+    if (!task.resize && task.scale_factor == 1.0f) {
+      // Use raw 1x PNG bytes when available
+      if (task.output == ImageTask::Output::kPNG) {
+        result.encoded.assign(task.png->front(),
+                              task.png->front() + task.png->size());
+        return result;
+      } else if (task.output == ImageTask::Output::kDataURL) {
+        result.data_url =
+            webui::GetPngDataUrl(task.png->front(), task.png->size());
+        return result;
+      }
+    }
+    electron::util::AddImageSkiaRepFromPNG(&image, task.png->front(),
+                                           task.png->size(), 1.0);
+  } else if (!task.reps.empty()) {
+    for (const auto& rep : task.reps)
+      image.AddRepresentation(rep);
+  } else if (!task.png_reps.empty()) {
+    for (const auto& rep : task.png_reps) {
+      electron::util::AddImageSkiaRepFromPNG(&image, rep.raw_data->front(),
+                                             rep.raw_data->size(), rep.scale);
+    }
+  } else if (!task.path.empty()) {
+    result.path = NormalizePath(task.path);
+    // Images that are only passed through are decoded when first needed.
+    if (task.output == ImageTask::Output::kImage && !task.resize &&
+        electron::util::ReadPNGRepsFromPath(&result.png_reps, result.path))
+      return result;
+    result.png_reps.clear();
+#if defined(OS_WIN)
+    if (result.path.MatchesExtension(FILE_PATH_LITERAL(".ico"))) {
+      electron::util::ReadImageSkiaFromICO(
+          &image, ReadICOFromPath(256, result.path).get());
+    } else {
+      electron::util::PopulateImageSkiaRepsFromPath(&image, result.path);
+    }
+#else
+    electron::util::PopulateImageSkiaRepsFromPath(&image, result.path);
+#endif
+  } else if (!task.buffer.empty()) {
+    gfx::Size pixel_size;
+    if (task.output == ImageTask::Output::kImage && !task.resize &&
+        electron::util::GetPNGSize(task.buffer.data(), task.buffer.size(),
+                                   &pixel_size)) {
+      result.png_reps.emplace_back(
+          base::RefCountedBytes::TakeVector(&task.buffer),
+          task.buffer_scale_factor);
+      return result;
+    }
+    electron::util::AddImageSkiaRepFromBuffer(&image, task.buffer.data(),
+                                              task.buffer.size(), 0, 0,
+                                              task.buffer_scale_factor);
+  }
+
+  if (task.resize && !image.isNull()) {
+    gfx::Size size = GetResizedSize(image.size(), *task.resize);
+    gfx::ImageSkia resized;
+    if (!size.IsEmpty()) {
+      for (const auto& rep : image.image_reps()) {
+        gfx::Size pixel_size = gfx::ScaleToCeiledSize(size, rep.scale());
+        resized.AddRepresentation(gfx::ImageSkiaRep(
+            skia::ImageOperations::Resize(rep.GetBitmap(), task.resize->method,
+                                          pixel_size.width(),
+                                          pixel_size.height()),
+            rep.scale()));
+      }
+    }
+    image = resized;
+  }
+
+  switch (task.output) {
+    case ImageTask::Output::kImage:
+      if (!image.isNull())
+        result.reps = image.image_reps();
+      break;
+    case ImageTask::Output::kPNG:
+      gfx::PNGCodec::EncodeBGRASkBitmap(
+          image.GetRepresentation(task.scale_factor).GetBitmap(), false,
+          &result.encoded);
+      break;
+    case ImageTask::Output::kJPEG:
+      gfx::JPEGCodec::Encode(image.GetRepresentation(1.f).GetBitmap(),
+                             task.quality, &result.encoded);
+      break;
+    case ImageTask::Output::kDataURL:
+      result.data_url = webui::GetBitmapDataUrl(
+          image.GetRepresentation(task.scale_factor).GetBitmap());
+      break;
+  }
+  return result;
+}
+
+void DeleteEncodedData(char*, void* hint) {
+  delete static_cast<std::vector<unsigned char>*>(hint);
+}
+
+v8::Local<v8::Value> ImageTaskResultToV8(v8::Isolate* isolate,
+                                         ImageTaskResult result) {
+  switch (result.output) {
+    case ImageTask::Output::kImage: {
+      gin::Handle<NativeImage> image;
+      if (!result.png_reps.empty()) {
+        image = NativeImage::CreateFromPNGReps(isolate,
+                                               std::move(result.png_reps));
+      } else {
+        gfx::ImageSkia image_skia;
+        for (const auto& rep : result.reps)
+          image_skia.AddRepresentation(rep);
+        image = NativeImage::Create(isolate, gfx::Image(image_skia));
+      }
+      image->ApplyPathNamingConventions(result.path);
+      return image.ToV8();
+    }
+    case ImageTask::Output::kPNG:
+    case ImageTask::Output::kJPEG: {
+      if (result.encoded.empty())
+        return node::Buffer::New(isolate, 0).ToLocalChecked();
+      // The buffer takes ownership of the encoded data.
+      auto* encoded = new std::vector<unsigned char>(std::move(result.encoded));
+      return node::Buffer::New(isolate,
+                               reinterpret_cast<char*>(encoded->data()),
+                               encoded->size(), &DeleteEncodedData, encoded)
+          .ToLocalChecked();
+    }
+    case ImageTask::Output::kDataURL:
+      return gin::StringToV8(isolate, result.data_url);
+  }
+  NOTREACHED();
+  return v8::Undefined(isolate);
+}
+
+base::TaskTraits GetImageTaskTraits() {
+  return {base::ThreadPool(), base::MayBlock(),
+          base::TaskPriority::USER_VISIBLE};
+}
+
+void ResolveImageTask(gin_helper::Promise<v8::Local<v8::Value>> promise,
+                      ImageTaskResult result) {
+  v8::Isolate* isolate = promise.isolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(promise.GetContext());
+  promise.Resolve(ImageTaskResultToV8(isolate, std::move(result)));
+}
+
+// Runs |task| on the thread pool and resolves the returned promise with its
+// result.
+v8::Local<v8::Promise> PostImageTask(v8::Isolate* isolate, ImageTask task) {
+  gin_helper::Promise<v8::Local<v8::Value>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  base::PostTaskAndReplyWithResult(
+      FROM_HERE, GetImageTaskTraits(),
+      base::BindOnce(&RunImageTask, std::move(task)),
+      base::BindOnce(&ResolveImageTask, std::move(promise)));
+  return handle;
+}
+
+// Collects the results of nativeImage.processBatch(), whose images are
+// processed in parallel.
+class ImageBatch : public base::RefCounted<ImageBatch> {
+ public:
+  ImageBatch(gin_helper::Promise<v8::Local<v8::Value>> promise, size_t size)
+      : promise_(std::move(promise)), results_(size), pending_(size) {}
+
+  void Post(size_t index, ImageTask task) {
+    base::PostTaskAndReplyWithResult(
+        FROM_HERE, GetImageTaskTraits(),
+        base::BindOnce(&RunImageTask, std::move(task)),
+        base::BindOnce(&ImageBatch::OnTaskDone, base::WrapRefCounted(this),
+                       index));
+  }
+
+ private:
+  friend class base::RefCounted<ImageBatch>;
+  ~ImageBatch() = default;
+
+  void OnTaskDone(size_t index, ImageTaskResult result) {
+    results_[index] = std::move(result);
+    if (--pending_ > 0)
+      return;
+
+    v8::Isolate* isolate = promise_.isolate();
+    v8::HandleScope handle_scope(isolate);
+    v8::Local<v8::Context> context = promise_.GetContext();
+    v8::Context::Scope context_scope(context);
+    v8::Local<v8::Array> array =
+        v8::Array::New(isolate, static_cast<int>(results_.size()));
+    for (size_t i = 0; i < results_.size(); ++i) {
+      array
+          ->Set(context, static_cast<uint32_t>(i),
+                ImageTaskResultToV8(isolate, std::move(results_[i])))
+          .Check();
+    }
+    results_.clear();
+    promise_.Resolve(array);
+  }
+
+  gin_helper::Promise<v8::Local<v8::Value>> promise_;
+  std::vector<ImageTaskResult> results_;
+  size_t pending_;
+
+  DISALLOW_COPY_AND_ASSIGN(ImageBatch);
+};
+
 }  // namespace
 
 NativeImage::NativeImage(v8::Isolate* isolate, const gfx::Image& image)
-    : image_(image) {
+    : image_(image), encoded_cache_(kMaxEncodedCacheEntries) {
   Init(isolate);
-  if (image_.HasRepresentation(gfx::Image::kImageRepSkia)) {
-    isolate->AdjustAmountOfExternalAllocatedMemory(
-        image_.ToImageSkia()->bitmap()->computeByteSize());
-  }
+  UpdateExternalAllocatedMemory();
+}
+
+NativeImage::NativeImage(v8::Isolate* isolate,
+                         std::vector<gfx::ImagePNGRep> png_reps)
+    : image_(png_reps),
+      png_reps_(std::move(png_reps)),
+      png_size_(GetPNGRepsSize(png_reps_)),
+      encoded_cache_(kMaxEncodedCacheEntries) {
+  Init(isolate);
+  UpdateExternalAllocatedMemory();
 }
 
 #if defined(OS_WIN)
 NativeImage::NativeImage(v8::Isolate* isolate, const base::FilePath& hicon_path)
-    : hicon_path_(hicon_path) {
+    : hicon_path_(hicon_path), encoded_cache_(kMaxEncodedCacheEntries) {
   // Use the 256x256 icon as fallback icon.
   gfx::ImageSkia image_skia;
   electron::util::ReadImageSkiaFromICO(&image_skia, GetHICON(256));
   image_ = gfx::Image(image_skia);
   Init(isolate);
-  if (image_.HasRepresentation(gfx::Image::kImageRepSkia)) {
-    isolate->AdjustAmountOfExternalAllocatedMemory(
-        image_.ToImageSkia()->bitmap()->computeByteSize());
-  }
+  UpdateExternalAllocatedMemory();
 }
 #endif
 
 NativeImage::~NativeImage() {
+  isolate()->AdjustAmountOfExternalAllocatedMemory(-external_memory_);
+}
+
+const gfx::Image& NativeImage::image() {
+  return image_;
+}
+
+void NativeImage::UpdateExternalAllocatedMemory() {
+  int64_t size = 0;
   if (image_.HasRepresentation(gfx::Image::kImageRepSkia)) {
-    isolate()->AdjustAmountOfExternalAllocatedMemory(-static_cast<int64_t>(
-        image_.ToImageSkia()->bitmap()->computeByteSize()));
+    for (const auto& rep : image_.ToImageSkia()->image_reps())
+      size += rep.GetBitmap().computeByteSize();
+  }
+  for (const auto& rep : png_reps_)
+    size += rep.raw_data->size();
+  for (const auto& entry : encoded_cache_)
+    size += entry.second->size();
+
+  if (size != external_memory_) {
+    isolate()->AdjustAmountOfExternalAllocatedMemory(size - external_memory_);
+    external_memory_ = size;
   }
 }
 
+scoped_refptr<base::RefCountedMemory> NativeImage::GetCachedEncoding(
+    const EncodedKey& key) {
+  auto it = encoded_cache_.Get(key);
+  if (it == encoded_cache_.end())
+    return nullptr;
+  return it->second;
+}
+
+void NativeImage::CacheEncoding(const EncodedKey& key,
+                                scoped_refptr<base::RefCountedMemory> data) {
+  if (data->size() > 0)
+    encoded_cache_.Put(key, std::move(data));
+  UpdateExternalAllocatedMemory();
+}
+
+scoped_refptr<base::RefCountedMemory> NativeImage::GetPNG(float scale_factor) {
+  EncodedKey key(EncodedFormat::kPNG, scale_factor, 0);
+  scoped_refptr<base::RefCountedMemory> png = GetCachedEncoding(key);
+  if (png)
+    return png;
+
+  // The PNG data the image was created from is returned as is.
+  for (const auto& rep : png_reps_) {
+    if (rep.scale == scale_factor)
+      png = rep.raw_data;
+  }
+  if (!png && scale_factor == 1.0f) {
+    // Use raw 1x PNG bytes when available
+    png = image_.As1xPNGBytes();
+  }
+  if (!png || png->size() == 0) {
+    const SkBitmap bitmap =
+        image_.AsImageSkia().GetRepresentation(scale_factor).GetBitmap();
+    std::vector<unsigned char> encoded;
+    gfx::PNGCodec::EncodeBGRASkBitmap(bitmap, false, &encoded);
+    png = base::RefCountedBytes::TakeVector(&encoded);
+  }
+  CacheEncoding(key, png);
+  return png;
+}
+
+scoped_refptr<base::RefCountedMemory> NativeImage::GetJPEG(int quality) {
+  EncodedKey key(EncodedFormat::kJPEG, 1.0f, quality);
+  scoped_refptr<base::RefCountedMemory> jpeg = GetCachedEncoding(key);
+  if (jpeg)
+    return jpeg;
+
+  std::vector<unsigned char> output;
+  gfx::JPEG1xEncodedDataFromImage(image_, quality, &output);
+  jpeg = base::RefCountedBytes::TakeVector(&output);
+  CacheEncoding(key, jpeg);
+  return jpeg;
+}
+
 #if defined(OS_WIN)
 HICON NativeImage::GetHICON(int size) {
   auto iter = hicons_.find(size);
@@ -149,29 +560,16 @@ HICON NativeImage::GetHICON(int size) {
   if (image_.IsEmpty())
     return NULL;
   hicons_[size] = IconUtil::CreateHICONFromSkBitmap(image_.AsBitmap());
+  UpdateExternalAllocatedMemory();
   return hicons_[size].get();
 }
 #endif
 
 v8::Local<v8::Value> NativeImage::ToPNG(gin::Arguments* args) {
-  float scale_factor = GetScaleFactorFromOptions(args);
-
-  if (scale_factor == 1.0f) {
-    // Use raw 1x PNG bytes when available
-    scoped_refptr<base::RefCountedMemory> png = image_.As1xPNGBytes();
-    if (png->size() > 0) {
-      const char* data = reinterpret_cast<const char*>(png->front());
-      size_t size = png->size();
-      return node::Buffer::Copy(args->isolate(), data, size).ToLocalChecked();
-    }
-  }
-
-  const SkBitmap bitmap =
-      image_.AsImageSkia().GetRepresentation(scale_factor).GetBitmap();
-  std::vector<unsigned char> encoded;
-  gfx::PNGCodec::EncodeBGRASkBitmap(bitmap, false, &encoded);
-  const char* data = reinterpret_cast<char*>(encoded.data());
-  size_t size = encoded.size();
+  scoped_refptr<base::RefCountedMemory> png =
+      GetPNG(GetScaleFactorFromOptions(args));
+  const char* data = reinterpret_cast<const char*>(png->front());
+  size_t size = png->size();
   return node::Buffer::Copy(args->isolate(), data, size).ToLocalChecked();
 }
 
@@ -180,6 +578,7 @@ v8::Local<v8::Value> NativeImage::ToBitmap(gin::Arguments* args) {
 
   const SkBitmap bitmap =
       image_.AsImageSkia().GetRepresentation(scale_factor).GetBitmap();
+  UpdateExternalAllocatedMemory();
   SkPixelRef* ref = bitmap.pixelRef();
   if (!ref)
     return node::Buffer::New(args->isolate(), 0).ToLocalChecked();
@@ -190,28 +589,72 @@ v8::Local<v8::Value> NativeImage::ToBitmap(gin::Arguments* args) {
 }
 
 v8::Local<v8::Value> NativeImage::ToJPEG(v8::Isolate* isolate, int quality) {
-  std::vector<unsigned char> output;
-  gfx::JPEG1xEncodedDataFromImage(image_, quality, &output);
-  if (output.empty())
+  scoped_refptr<base::RefCountedMemory> jpeg = GetJPEG(quality);
+  if (jpeg->size() == 0)
     return node::Buffer::New(isolate, 0).ToLocalChecked();
   return node::Buffer::Copy(isolate,
-                            reinterpret_cast<const char*>(&output.front()),
-                            output.size())
+                            reinterpret_cast<const char*>(jpeg->front()),
+                            jpeg->size())
       .ToLocalChecked();
 }
 
 std::string NativeImage::ToDataURL(gin::Arguments* args) {
+  scoped_refptr<base::RefCountedMemory> png =
+      GetPNG(GetScaleFactorFromOptions(args));
+  return webui::GetPngDataUrl(png->front(), png->size());
+}
+
+v8::Local<v8::Promise> NativeImage::ToPNGAsync(gin::Arguments* args) {
+  v8::Isolate* isolate = args->isolate();
   float scale_factor = GetScaleFactorFromOptions(args);
+  scoped_refptr<base::RefCountedMemory> png =
+      GetCachedEncoding(EncodedKey(EncodedFormat::kPNG, scale_factor, 0));
+  if (png) {
+    return gin_helper::Promise<v8::Local<v8::Value>>::ResolvedPromise(
+        isolate, node::Buffer::Copy(
+                     isolate, reinterpret_cast<const char*>(png->front()),
+                     png->size())
+                     .ToLocalChecked());
+  }
 
-  if (scale_factor == 1.0f) {
-    // Use raw 1x PNG bytes when available
-    scoped_refptr<base::RefCountedMemory> png = image_.As1xPNGBytes();
-    if (png->size() > 0)
-      return webui::GetPngDataUrl(png->front(), png->size());
+  ImageTask task = CreateImageTask(image_, png_reps_, scale_factor);
+  task.output = ImageTask::Output::kPNG;
+  UpdateExternalAllocatedMemory();
+  return PostImageTask(isolate, std::move(task));
+}
+
+v8::Local<v8::Promise> NativeImage::ToJPEGAsync(v8::Isolate* isolate,
+                                                int quality) {
+  scoped_refptr<base::RefCountedMemory> jpeg =
+      GetCachedEncoding(EncodedKey(EncodedFormat::kJPEG, 1.0f, quality));
+  if (jpeg) {
+    return gin_helper::Promise<v8::Local<v8::Value>>::ResolvedPromise(
+        isolate, node::Buffer::Copy(
+                     isolate, reinterpret_cast<const char*>(jpeg->front()),
+                     jpeg->size())
+                     .ToLocalChecked());
   }
 
-  return webui::GetBitmapDataUrl(
-      image_.AsImageSkia().GetRepresentation(scale_factor).GetBitmap());
+  ImageTask task = CreateImageTask(image_, png_reps_, 1.f);
+  task.output = ImageTask::Output::kJPEG;
+  task.quality = quality;
+  UpdateExternalAllocatedMemory();
+  return PostImageTask(isolate, std::move(task));
+}
+
+v8::Local<v8::Promise> NativeImage::ToDataURLAsync(gin::Arguments* args) {
+  float scale_factor = GetScaleFactorFromOptions(args);
+  scoped_refptr<base::RefCountedMemory> png =
+      GetCachedEncoding(EncodedKey(EncodedFormat::kPNG, scale_factor, 0));
+  if (png) {
+    return gin_helper::Promise<std::string>::ResolvedPromise(
+        args->isolate(), webui::GetPngDataUrl(png->front(), png->size()));
+  }
+
+  ImageTask task = CreateImageTask(image_, png_reps_, scale_factor);
+  task.output = ImageTask::Output::kDataURL;
+  UpdateExternalAllocatedMemory();
+  return PostImageTask(args->isolate(), std::move(task));
 }
 
 v8::Local<v8::Value> NativeImage::GetBitmap(gin::Arguments* args) {
@@ -219,6 +662,7 @@ v8::Local<v8::Value> NativeImage::GetBitmap(gin::Arguments* args) {
 
   const SkBitmap bitmap =
       image_.AsImageSkia().GetRepresentation(scale_factor).GetBitmap();
+  UpdateExternalAllocatedMemory();
   SkPixelRef* ref = bitmap.pixelRef();
   if (!ref)
     return node::Buffer::New(args->isolate(), 0).ToLocalChecked();
@@ -249,6 +693,9 @@ bool NativeImage::IsEmpty() {
 }
 
 gfx::Size NativeImage::GetSize() {
+  // gfx::Image decodes PNG data to get its size.
+  if (png_size_)
+    return *png_size_;
   return image_.Size();
 }
 
@@ -262,38 +709,22 @@ float NativeImage::GetAspectRatio() {
 
 gin::Handle<NativeImage> NativeImage::Resize(v8::Isolate* isolate,
                                              base::DictionaryValue options) {
-  gfx::Size size = GetSize();
-  int width = size.width();
-  int height = size.height();
-  bool width_set = options.GetInteger("width", &width);
-  bool height_set = options.GetInteger("height", &height);
-  size.SetSize(width, height);
-
-  if (width_set && !height_set) {
-    // Scale height to preserve original aspect ratio
-    size.set_height(width);
-    size = gfx::ScaleToRoundedSize(size, 1.f, 1.f / GetAspectRatio());
-  } else if (height_set && !width_set) {
-    // Scale width to preserve original aspect ratio
-    size.set_width(height);
-    size = gfx::ScaleToRoundedSize(size, GetAspectRatio(), 1.f);
-  }
-
-  skia::ImageOperations::ResizeMethod method =
-      skia::ImageOperations::ResizeMethod::RESIZE_BEST;
-  std::string quality;
-  options.GetString("quality", &quality);
-  if (quality == "good")
-    method = skia::ImageOperations::ResizeMethod::RESIZE_GOOD;
-  else if (quality == "better")
-    method = skia::ImageOperations::ResizeMethod::RESIZE_BETTER;
-
+  ResizeOptions resize = ParseResizeOptions(options);
   gfx::ImageSkia resized = gfx::ImageSkiaOperations::CreateResizedImage(
-      image_.AsImageSkia(), method, size);
+      image_.AsImageSkia(), resize.method, GetResizedSize(GetSize(), resize));
   return gin::CreateHandle(isolate,
                            new NativeImage(isolate, gfx::Image(resized)));
 }
 
+v8::Local<v8::Promise> NativeImage::ResizeAsync(
+    v8::Isolate* isolate,
+    base::DictionaryValue options) {
+  ImageTask task = CreateImageTask(image_, png_reps_, 1.f);
+  task.resize = ParseResizeOptions(options);
+  UpdateExternalAllocatedMemory();
+  return PostImageTask(isolate, std::move(task));
+}
+
 gin::Handle<NativeImage> NativeImage::Crop(v8::Isolate* isolate,
                                            const gfx::Rect& rect) {
   gfx::ImageSkia cropped =
@@ -339,6 +770,13 @@ void NativeImage::AddRepresentation(const gin_helper::Dictionary& options) {
     gfx::Image image(image_skia);
     image_ = std::move(image);
   }
+
+  if (skia_rep_added) {
+    png_reps_.clear();
+    png_size_.reset();
+    encoded_cache_.Clear();
+  }
+  UpdateExternalAllocatedMemory();
 }
 
 #if !defined(OS_MACOSX)
@@ -388,15 +826,48 @@ gin::Handle<NativeImage> NativeImage::CreateFromPath(
     return gin::CreateHandle(isolate, new NativeImage(isolate, image_path));
   }
 #endif
-  gfx::ImageSkia image_skia;
-  electron::util::PopulateImageSkiaRepsFromPath(&image_skia, image_path);
-  gfx::Image image(image_skia);
-  gin::Handle<NativeImage> handle = Create(isolate, image);
+  gin::Handle<NativeImage> handle;
+  std::vector<gfx::ImagePNGRep> png_reps;
+  if (electron::util::ReadPNGRepsFromPath(&png_reps, image_path)) {
+    handle = CreateFromPNGReps(isolate, std::move(png_reps));
+  } else {
+    gfx::ImageSkia image_skia;
+    electron::util::PopulateImageSkiaRepsFromPath(&image_skia, image_path);
+    handle = Create(isolate, gfx::Image(image_skia));
+  }
+  handle->ApplyPathNamingConventions(image_path);
+  return handle;
+}
+
+// static
+gin::Handle<NativeImage> NativeImage::CreateFromPNGReps(
+    v8::Isolate* isolate,
+    std::vector<gfx::ImagePNGRep> png_reps) {
+  return gin::CreateHandle(isolate,
+                           new NativeImage(isolate, std::move(png_reps)));
+}
+
+void NativeImage::ApplyPathNamingConventions(const base::FilePath& path) {
 #if defined(OS_MACOSX)
-  if (IsTemplateFilename(image_path))
-    handle->SetTemplateImage(true);
+  if (IsTemplateFilename(path))
+    SetTemplateImage(true);
 #endif
-  return handle;
+}
+
+// static
+v8::Local<v8::Promise> NativeImage::CreateFromPathAsync(
+    v8::Isolate* isolate,
+    const base::FilePath& path) {
+#if defined(OS_WIN)
+  // Icons keep their path to load the other sizes on demand.
+  if (path.MatchesExtension(FILE_PATH_LITERAL(".ico"))) {
+    return gin_helper::Promise<v8::Local<v8::Value>>::ResolvedPromise(
+        isolate, CreateFromPath(isolate, path).ToV8());
+  }
+#endif
+  ImageTask task;
+  task.path = path;
+  return PostImageTask(isolate, std::move(task));
 }
 
 // static
@@ -468,13 +939,112 @@ gin::Handle<NativeImage> NativeImage::CreateFromBuffer(
     options.Get("scaleFactor", &scale_factor);
   }
 
+  auto* data = reinterpret_cast<unsigned char*>(node::Buffer::Data(buffer));
+  size_t size = node::Buffer::Length(buffer);
+  gfx::Size pixel_size;
+  if (electron::util::GetPNGSize(data, size, &pixel_size)) {
+    std::vector<unsigned char> png(data, data + size);
+    std::vector<gfx::ImagePNGRep> png_reps;
+    png_reps.emplace_back(base::RefCountedBytes::TakeVector(&png),
+                          scale_factor);
+    return CreateFromPNGReps(args->isolate(), std::move(png_reps));
+  }
+
   gfx::ImageSkia image_skia;
-  electron::util::AddImageSkiaRepFromBuffer(
-      &image_skia, reinterpret_cast<unsigned char*>(node::Buffer::Data(buffer)),
-      node::Buffer::Length(buffer), width, height, scale_factor);
+  electron::util::AddImageSkiaRepFromBuffer(&image_skia, data, size, width,
+                                            height, scale_factor);
   return Create(args->isolate(), gfx::Image(image_skia));
 }
 
+// static
+v8::Local<v8::Promise> NativeImage::CreateFromBufferAsync(
+    gin_helper::ErrorThrower thrower,
+    v8::Local<v8::Value> buffer,
+    gin::Arguments* args) {
+  if (!node::Buffer::HasInstance(buffer)) {
+    thrower.ThrowError("buffer must be a node Buffer");
+    return v8::Local<v8::Promise>();
+  }
+
+  ImageTask task;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options))
+    options.Get("scaleFactor", &task.buffer_scale_factor);
+  const char* data = node::Buffer::Data(buffer);
+  task.buffer.assign(data, data + node::Buffer::Length(buffer));
+  return PostImageTask(args->isolate(), std::move(task));
+}
+
+// static
+v8::Local<v8::Promise> NativeImage::ProcessBatch(gin::Arguments* args) {
+  v8::Isolate* isolate = args->isolate();
+  std::vector<v8::Local<v8::Value>> sources;
+  if (!args->GetNext(&sources)) {
+    args->ThrowTypeError("sources must be an array");
+    return v8::Local<v8::Promise>();
+  }
+
+  ImageTask options_task;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options)) {
+    base::DictionaryValue resize;
+    if (options.Get("resize", &resize))
+      options_task.resize = ParseResizeOptions(resize);
+    options.Get("scaleFactor", &options_task.scale_factor);
+    options.Get("quality", &options_task.quality);
+    std::string format;
+    if (options.Get("format", &format)) {
+      if (format == "png") {
+        options_task.output = ImageTask::Output::kPNG;
+      } else if (format == "jpeg") {
+        options_task.output = ImageTask::Output::kJPEG;
+      } else if (format == "dataURL") {
+        options_task.output = ImageTask::Output::kDataURL;
+      } else if (format != "image") {
+        args->ThrowTypeError("Invalid format: " + format);
+        return v8::Local<v8::Promise>();
+      }
+    }
+  }
+
+  // Validate every source before starting any work.
+  std::vector<ImageTask> tasks;
+  for (v8::Local<v8::Value> source : sources) {
+    ImageTask task;
+    NativeImage* native_image = nullptr;
+    if (source->IsString()) {
+      gin::ConvertFromV8(isolate, source, &task.path);
+    } else if (node::Buffer::HasInstance(source)) {
+      const char* data = node::Buffer::Data(source);
+      task.buffer.assign(data, data + node::Buffer::Length(source));
+    } else if (gin::ConvertFromV8(isolate, source, &native_image)) {
+      task = CreateImageTask(native_image->image_, native_image->png_reps_,
+                             options_task.scale_factor);
+    } else {
+      args->ThrowTypeError(
+          "sources must be paths, Buffers or NativeImage instances");
+      return v8::Local<v8::Promise>();
+    }
+    task.resize = options_task.resize;
+    task.output = options_task.output;
+    task.scale_factor = options_task.scale_factor;
+    task.quality = options_task.quality;
+    tasks.push_back(std::move(task));
+  }
+
+  gin_helper::Promise<v8::Local<v8::Value>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  if (tasks.empty()) {
+    promise.Resolve(v8::Array::New(isolate));
+    return handle;
+  }
+  auto batch = base::MakeRefCounted<ImageBatch>(std::move(promise),
+                                                tasks.size());
+  for (size_t i = 0; i < tasks.size(); ++i)
+    batch->Post(i, std::move(tasks[i]));
+  return handle;
+}
+
 // static
 gin::Handle<NativeImage> NativeImage::CreateFromDataURL(v8::Isolate* isolate,
                                                         const GURL& url) {
@@ -508,6 +1078,9 @@ void NativeImage::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("getBitmap", &NativeImage::GetBitmap)
       .SetMethod("getNativeHandle", &NativeImage::GetNativeHandle)
       .SetMethod("toDataURL", &NativeImage::ToDataURL)
+      .SetMethod("toPNGAsync", &NativeImage::ToPNGAsync)
+      .SetMethod("toJPEGAsync", &NativeImage::ToJPEGAsync)
+      .SetMethod("toDataURLAsync", &NativeImage::ToDataURLAsync)
       .SetMethod("isEmpty", &NativeImage::IsEmpty)
       .SetMethod("getSize", &NativeImage::GetSize)
       .SetMethod("_setTemplateImage", &NativeImage::SetTemplateImage)
@@ -515,6 +1088,7 @@ void NativeImage::BuildPrototype(v8::Isolate* isolate,
       .SetProperty("isMacTemplateImage", &NativeImage::IsTemplateImage,
                    &NativeImage::SetTemplateImage)
       .SetMethod("resize", &NativeImage::Resize)
+      .SetMethod("resizeAsync", &NativeImage::ResizeAsync)
       .SetMethod("crop", &NativeImage::Crop)
       .SetMethod("getAspectRatio", &NativeImage::GetAspectRatio)
       .SetMethod("addRepresentation", &NativeImage::AddRepresentation);
@@ -588,6 +1162,11 @@ void Initialize(v8::Local<v8::Object> exports,
   native_image.SetMethod("createFromDataURL", &NativeImage::CreateFromDataURL);
   native_image.SetMethod("createFromNamedImage",
                          &NativeImage::CreateFromNamedImage);
+  native_image.SetMethod("createFromPathAsync",
+                         &NativeImage::CreateFromPathAsync);
+  native_image.SetMethod("createFromBufferAsync",
+                         &NativeImage::CreateFromBufferAsync);
+  native_image.SetMethod("processBatch", &NativeImage::ProcessBatch);
 }
 
 }  // namespace
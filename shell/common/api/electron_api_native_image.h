@@ -7,12 +7,19 @@
 
 #include <map>
 #include <string>
+#include <tuple>
+#include <vector>
 
+#include "base/containers/mru_cache.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/optional.h"
 #include "base/values.h"
 #include "gin/handle.h"
 #include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/wrappable.h"
+#include "ui/gfx/geometry/size.h"
 #include "ui/gfx/image/image.h"
+#include "ui/gfx/image/image_png_rep.h"
 
 #if defined(OS_WIN)
 #include "base/files/file_path.h"
@@ -26,8 +33,8 @@ class FilePath;
 }
 
 namespace gfx {
+class ImageSkia;
 class Rect;
-class Size;
 }  // namespace gfx
 
 namespace gin_helper {
@@ -64,6 +71,22 @@ class NativeImage : public gin_helper::Wrappable<NativeImage> {
   static gin::Handle<NativeImage> CreateFromNamedImage(gin::Arguments* args,
                                                        const std::string& name);
 
+  // Asynchronous variants decoding on the thread pool.
+  static v8::Local<v8::Promise> CreateFromPathAsync(
+      v8::Isolate* isolate,
+      const base::FilePath& path);
+  static v8::Local<v8::Promise> CreateFromBufferAsync(
+      gin_helper::ErrorThrower thrower,
+      v8::Local<v8::Value> buffer,
+      gin::Arguments* args);
+  static v8::Local<v8::Promise> ProcessBatch(gin::Arguments* args);
+
+  // Creates an image that keeps the encoded |png_reps| and only decodes them
+  // when the pixels are needed.
+  static gin::Handle<NativeImage> CreateFromPNGReps(
+      v8::Isolate* isolate,
+      std::vector<gfx::ImagePNGRep> png_reps);
+
   static void BuildPrototype(v8::Isolate* isolate,
                              v8::Local<v8::FunctionTemplate> prototype);
 
@@ -71,10 +94,15 @@ class NativeImage : public gin_helper::Wrappable<NativeImage> {
   HICON GetHICON(int size);
 #endif
 
-  const gfx::Image& image() const { return image_; }
+  // Applies the naming conventions of the file the image was read from, such
+  // as template images on macOS.
+  void ApplyPathNamingConventions(const base::FilePath& path);
+
+  const gfx::Image& image();
 
  protected:
   NativeImage(v8::Isolate* isolate, const gfx::Image& image);
+  NativeImage(v8::Isolate* isolate, std::vector<gfx::ImagePNGRep> png_reps);
 #if defined(OS_WIN)
   NativeImage(v8::Isolate* isolate, const base::FilePath& hicon_path);
 #endif
@@ -90,11 +118,30 @@ class NativeImage : public gin_helper::Wrappable<NativeImage> {
                                   base::DictionaryValue options);
   gin::Handle<NativeImage> Crop(v8::Isolate* isolate, const gfx::Rect& rect);
   std::string ToDataURL(gin::Arguments* args);
+  v8::Local<v8::Promise> ToPNGAsync(gin::Arguments* args);
+  v8::Local<v8::Promise> ToJPEGAsync(v8::Isolate* isolate, int quality);
+  v8::Local<v8::Promise> ToDataURLAsync(gin::Arguments* args);
+  v8::Local<v8::Promise> ResizeAsync(v8::Isolate* isolate,
+                                     base::DictionaryValue options);
   bool IsEmpty();
   gfx::Size GetSize();
   float GetAspectRatio();
   void AddRepresentation(const gin_helper::Dictionary& options);
 
+  enum class EncodedFormat { kPNG, kJPEG };
+  // Format, scale factor and JPEG quality.
+  using EncodedKey = std::tuple<EncodedFormat, float, int>;
+
+  scoped_refptr<base::RefCountedMemory> GetPNG(float scale_factor);
+  scoped_refptr<base::RefCountedMemory> GetJPEG(int quality);
+  // Returns null when |key| isn't cached.
+  scoped_refptr<base::RefCountedMemory> GetCachedEncoding(
+      const EncodedKey& key);
+  void CacheEncoding(const EncodedKey& key,
+                     scoped_refptr<base::RefCountedMemory> data);
+  // Reports the memory held by the decoded and encoded representations.
+  void UpdateExternalAllocatedMemory();
+
   // Mark the image as template image.
   void SetTemplateImage(bool setAsTemplate);
   // Determine if the image is a template image.
@@ -106,6 +153,17 @@ class NativeImage : public gin_helper::Wrappable<NativeImage> {
 #endif
 
   gfx::Image image_;
+  // The PNG data |image_| was created from, which gfx decodes when the pixels
+  // are first needed. Kept to hand it to the thread pool undecoded and to
+  // return it from toPNG().
+  std::vector<gfx::ImagePNGRep> png_reps_;
+  // Read from the headers of |png_reps_|.
+  base::Optional<gfx::Size> png_size_;
+  // Output of the encoding methods, which is dropped when a representation
+  // is added.
+  base::MRUCache<EncodedKey, scoped_refptr<base::RefCountedMemory>>
+      encoded_cache_;
+  int64_t external_memory_ = 0;
 
   DISALLOW_COPY_AND_ASSIGN(NativeImage);
 };
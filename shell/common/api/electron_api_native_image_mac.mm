@@ -64,10 +64,12 @@ gin::Handle<NativeImage> NativeImage::CreateFromNamedImage(
 }
 
 void NativeImage::SetTemplateImage(bool setAsTemplate) {
+  DecodePendingReps();
   [image_.AsNSImage() setTemplate:setAsTemplate];
 }
 
 bool NativeImage::IsTemplateImage() {
+  DecodePendingReps();
   return [image_.AsNSImage() isTemplate];
 }
 
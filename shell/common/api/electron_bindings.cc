@@ -10,6 +10,7 @@
 #include <utility>
 #include <vector>
 
+#include "base/bind.h"
 #include "base/logging.h"
 #include "base/process/process.h"
 #include "base/process/process_handle.h"
@@ -22,12 +23,15 @@
 #include "services/resource_coordinator/public/cpp/memory_instrumentation/memory_instrumentation.h"
 #include "shell/browser/browser.h"
 #include "shell/common/application_info.h"
+#include "shell/common/cpu_profile.h"
 #include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/locker.h"
 #include "shell/common/gin_helper/promise.h"
 #include "shell/common/heap_snapshot.h"
 #include "shell/common/node_includes.h"
+#include "shell/common/sampling_heap_profile.h"
+#include "shell/common/startup_timeline.h"
 #include "third_party/blink/renderer/platform/heap/process_heap.h"  // nogncheck
 
 namespace electron {
@@ -62,6 +66,7 @@ void ElectronBindings::BindProcess(v8::Isolate* isolate,
   process->SetMethod("hang", &Hang);
   process->SetMethod("log", &Log);
   process->SetMethod("getCreationTime", &GetCreationTime);
+  process->SetMethod("getStartupTimeline", &GetStartupTimeline);
   process->SetMethod("getHeapStatistics", &GetHeapStatistics);
   process->SetMethod("getBlinkMemoryInfo", &GetBlinkMemoryInfo);
   process->SetMethod("getProcessMemoryInfo", &GetProcessMemoryInfo);
@@ -91,6 +96,12 @@ void ElectronBindings::BindTo(v8::Isolate* isolate,
   BindProcess(isolate, &dict, metrics_.get());
 
   dict.SetMethod("takeHeapSnapshot", &TakeHeapSnapshot);
+  dict.SetMethod("takeHeapSnapshotAsync", &TakeHeapSnapshotAsync);
+  dict.SetMethod("startSamplingHeapProfiler", &StartSamplingHeapProfiler);
+  dict.SetMethod("stopSamplingHeapProfiler", &StopSamplingHeapProfiler);
+  dict.SetMethod("getSamplingHeapProfile", &GetSamplingHeapProfile);
+  dict.SetMethod("startCpuProfiling", &StartCpuProfiling);
+  dict.SetMethod("stopCpuProfiling", &StopCpuProfiling);
 #if defined(OS_POSIX)
   dict.SetMethod("setFdLimit", &base::IncreaseFdLimitTo);
 #endif
@@ -196,6 +207,23 @@ v8::Local<v8::Value> ElectronBindings::GetCreationTime(v8::Isolate* isolate) {
   return v8::Number::New(isolate, jsTime);
 }
 
+// static
+v8::Local<v8::Value> ElectronBindings::GetStartupTimeline(
+    v8::Isolate* isolate) {
+  base::TimeTicks start = startup_timeline::GetProcessStartTime();
+  base::TimeTicks previous = start;
+  std::vector<v8::Local<v8::Value>> marks;
+  for (const auto& mark : startup_timeline::GetMarks()) {
+    gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+    dict.Set("name", mark.name);
+    dict.Set("time", (mark.time - start).InMillisecondsF());
+    dict.Set("duration", (mark.time - previous).InMillisecondsF());
+    marks.push_back(dict.GetHandle());
+    previous = mark.time;
+  }
+  return gin::ConvertToV8(isolate, marks);
+}
+
 // static
 v8::Local<v8::Value> ElectronBindings::GetSystemMemoryInfo(
     v8::Isolate* isolate,
@@ -354,4 +382,123 @@ bool ElectronBindings::TakeHeapSnapshot(v8::Isolate* isolate,
   return electron::TakeHeapSnapshot(isolate, &file);
 }
 
+// static
+v8::Local<v8::Promise> ElectronBindings::TakeHeapSnapshotAsync(
+    v8::Isolate* isolate,
+    const base::FilePath& file_path,
+    gin_helper::Arguments* args) {
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  bool compress = false;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options))
+    options.Get("compress", &compress);
+
+  base::File file;
+  {
+    base::ThreadRestrictions::ScopedAllowIO allow_io;
+    file = base::File(file_path,
+                      base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+  }
+  if (!file.IsValid()) {
+    promise.RejectWithErrorMessage("takeHeapSnapshotAsync failed");
+    return handle;
+  }
+
+  // Progress can't be reported to JavaScript, which only runs again once the
+  // snapshot is serialized.
+  electron::StreamHeapSnapshot(
+      isolate, std::move(file), compress, HeapSnapshotProgressCallback(),
+      base::BindOnce(
+          [](gin_helper::Promise<void> promise, bool success) {
+            if (success)
+              promise.Resolve();
+            else
+              promise.RejectWithErrorMessage("takeHeapSnapshotAsync failed");
+          },
+          std::move(promise)));
+  return handle;
+}
+
+// static
+bool ElectronBindings::StartSamplingHeapProfiler(v8::Isolate* isolate,
+                                                 gin_helper::Arguments* args) {
+  SamplingHeapProfilerOptions options;
+  gin_helper::Dictionary dict;
+  if (args->GetNext(&dict)) {
+    double sampling_interval;
+    if (dict.Get("samplingInterval", &sampling_interval)) {
+      if (sampling_interval < 1) {
+        args->ThrowError("samplingInterval must be a positive number");
+        return false;
+      }
+      options.sampling_interval = static_cast<uint64_t>(sampling_interval);
+    }
+    if (dict.Get("stackDepth", &options.stack_depth) &&
+        options.stack_depth < 1) {
+      args->ThrowError("stackDepth must be a positive number");
+      return false;
+    }
+    dict.Get("includeObjectsCollectedByMajorGC",
+             &options.include_objects_collected_by_major_gc);
+    dict.Get("includeObjectsCollectedByMinorGC",
+             &options.include_objects_collected_by_minor_gc);
+  }
+  return electron::StartSamplingHeapProfiler(isolate, options);
+}
+
+// static
+bool ElectronBindings::StartCpuProfiling(v8::Isolate* isolate,
+                                         gin_helper::Arguments* args) {
+  base::TimeDelta sampling_interval = kDefaultCpuProfileSamplingInterval;
+  gin_helper::Dictionary dict;
+  if (args->GetNext(&dict)) {
+    int interval;
+    if (dict.Get("samplingInterval", &interval)) {
+      if (interval < 1) {
+        args->ThrowError("samplingInterval must be a positive number");
+        return false;
+      }
+      sampling_interval = base::TimeDelta::FromMicroseconds(interval);
+    }
+  }
+  return electron::StartCpuProfiling(isolate, sampling_interval);
+}
+
+// static
+v8::Local<v8::Promise> ElectronBindings::StopCpuProfiling(
+    v8::Isolate* isolate,
+    const base::FilePath& file_path) {
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  base::File file;
+  {
+    base::ThreadRestrictions::ScopedAllowIO allow_io;
+    file = base::File(file_path,
+                      base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+  }
+  if (!file.IsValid()) {
+    // Profiling stops either way, a failed stop doesn't leave the profiler
+    // sampling with nobody to collect it.
+    CancelCpuProfiling(isolate);
+    promise.RejectWithErrorMessage("Failed to open " +
+                                   file_path.AsUTF8Unsafe());
+    return handle;
+  }
+
+  electron::StopCpuProfiling(
+      isolate, std::move(file),
+      base::BindOnce(
+          [](gin_helper::Promise<void> promise, bool success) {
+            if (success)
+              promise.Resolve();
+            else
+              promise.RejectWithErrorMessage("stopCpuProfiling failed");
+          },
+          std::move(promise)));
+  return handle;
+}
+
 }  // namespace electron
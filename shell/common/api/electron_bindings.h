@@ -54,6 +54,7 @@ class ElectronBindings {
   static void Hang();
   static v8::Local<v8::Value> GetHeapStatistics(v8::Isolate* isolate);
   static v8::Local<v8::Value> GetCreationTime(v8::Isolate* isolate);
+  static v8::Local<v8::Value> GetStartupTimeline(v8::Isolate* isolate);
   static v8::Local<v8::Value> GetSystemMemoryInfo(v8::Isolate* isolate,
                                                   gin_helper::Arguments* args);
   static v8::Local<v8::Promise> GetProcessMemoryInfo(v8::Isolate* isolate);
@@ -63,6 +64,17 @@ class ElectronBindings {
   static v8::Local<v8::Value> GetIOCounters(v8::Isolate* isolate);
   static bool TakeHeapSnapshot(v8::Isolate* isolate,
                                const base::FilePath& file_path);
+  static v8::Local<v8::Promise> TakeHeapSnapshotAsync(
+      v8::Isolate* isolate,
+      const base::FilePath& file_path,
+      gin_helper::Arguments* args);
+  static bool StartSamplingHeapProfiler(v8::Isolate* isolate,
+                                        gin_helper::Arguments* args);
+  static bool StartCpuProfiling(v8::Isolate* isolate,
+                                gin_helper::Arguments* args);
+  static v8::Local<v8::Promise> StopCpuProfiling(
+      v8::Isolate* isolate,
+      const base::FilePath& file_path);
 
   void ActivateUVLoop(v8::Isolate* isolate);
 
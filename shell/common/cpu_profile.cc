@@ -0,0 +1,259 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/cpu_profile.h"
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/json/string_escape.h"
+#include "base/no_destructor.h"
+#include "base/numerics/safe_conversions.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/synchronization/lock.h"
+#include "base/task/post_task.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "gin/converter.h"
+#include "v8/include/v8-profiler.h"
+
+namespace electron {
+
+namespace {
+
+const char kProfileTitle[] = "electron";
+
+// The profilers of the isolates being profiled, an isolate only has one per
+// thread but the isolates of the workers live on their own threads.
+class CpuProfilers {
+ public:
+  static CpuProfilers* Get() {
+    static base::NoDestructor<CpuProfilers> instance;
+    return instance.get();
+  }
+
+  CpuProfilers() = default;
+
+  bool Contains(v8::Isolate* isolate) {
+    base::AutoLock auto_lock(lock_);
+    return profilers_.find(isolate) != profilers_.end();
+  }
+
+  void Add(v8::Isolate* isolate, v8::CpuProfiler* profiler) {
+    base::AutoLock auto_lock(lock_);
+    profilers_[isolate] = profiler;
+  }
+
+  v8::CpuProfiler* Take(v8::Isolate* isolate) {
+    base::AutoLock auto_lock(lock_);
+    auto it = profilers_.find(isolate);
+    if (it == profilers_.end())
+      return nullptr;
+    v8::CpuProfiler* profiler = it->second;
+    profilers_.erase(it);
+    return profiler;
+  }
+
+ private:
+  base::Lock lock_;
+  std::map<v8::Isolate*, v8::CpuProfiler*> profilers_;
+
+  DISALLOW_COPY_AND_ASSIGN(CpuProfilers);
+};
+
+// A copy of a v8::CpuProfile that can be serialized on another thread.
+struct CpuProfileData {
+  struct Node {
+    unsigned id = 0;
+    std::string function_name;
+    int script_id = 0;
+    std::string url;
+    int line_number = 0;
+    int column_number = 0;
+    unsigned hit_count = 0;
+    std::vector<unsigned> children;
+  };
+
+  std::vector<Node> nodes;
+  std::vector<unsigned> samples;
+  std::vector<int64_t> timestamps;
+  int64_t start_time = 0;
+  int64_t end_time = 0;
+};
+
+CpuProfileData CopyCpuProfile(const v8::CpuProfile* profile) {
+  CpuProfileData data;
+  // The tree is walked without recursing, deep JavaScript stacks would
+  // otherwise overflow the native one.
+  std::vector<const v8::CpuProfileNode*> pending = {profile->GetTopDownRoot()};
+  while (!pending.empty()) {
+    const v8::CpuProfileNode* node = pending.back();
+    pending.pop_back();
+
+    CpuProfileData::Node copy;
+    copy.id = node->GetNodeId();
+    copy.function_name = node->GetFunctionNameStr();
+    copy.script_id = node->GetScriptId();
+    copy.url = node->GetScriptResourceNameStr();
+    // V8 lines and columns start at 1, DevTools' at 0.
+    copy.line_number = node->GetLineNumber() - 1;
+    copy.column_number = node->GetColumnNumber() - 1;
+    copy.hit_count = node->GetHitCount();
+    const int children_count = node->GetChildrenCount();
+    copy.children.reserve(children_count);
+    for (int i = 0; i < children_count; ++i) {
+      const v8::CpuProfileNode* child = node->GetChild(i);
+      copy.children.push_back(child->GetNodeId());
+      pending.push_back(child);
+    }
+    data.nodes.push_back(std::move(copy));
+  }
+
+  const int samples_count = profile->GetSamplesCount();
+  data.samples.reserve(samples_count);
+  data.timestamps.reserve(samples_count);
+  for (int i = 0; i < samples_count; ++i) {
+    data.samples.push_back(profile->GetSample(i)->GetNodeId());
+    data.timestamps.push_back(profile->GetSampleTimestamp(i));
+  }
+  data.start_time = profile->GetStartTime();
+  data.end_time = profile->GetEndTime();
+  return data;
+}
+
+void AppendNode(const CpuProfileData::Node& node, std::string* json) {
+  json->append("{\"id\":");
+  json->append(base::NumberToString(node.id));
+  json->append(",\"callFrame\":{\"functionName\":");
+  base::EscapeJSONString(node.function_name, true, json);
+  json->append(",\"scriptId\":\"");
+  json->append(base::NumberToString(node.script_id));
+  json->append("\",\"url\":");
+  base::EscapeJSONString(node.url, true, json);
+  json->append(",\"lineNumber\":");
+  json->append(base::NumberToString(node.line_number));
+  json->append(",\"columnNumber\":");
+  json->append(base::NumberToString(node.column_number));
+  json->append("},\"hitCount\":");
+  json->append(base::NumberToString(node.hit_count));
+  json->append(",\"children\":[");
+  for (size_t i = 0; i < node.children.size(); ++i) {
+    if (i > 0)
+      json->push_back(',');
+    json->append(base::NumberToString(node.children[i]));
+  }
+  json->append("]}");
+}
+
+// Serializes |data| like DevTools' Profiler.Profile, the samples' timestamps
+// being stored as deltas from the previous one.
+std::string SerializeCpuProfile(const CpuProfileData& data) {
+  std::string json = "{\"nodes\":[";
+  for (size_t i = 0; i < data.nodes.size(); ++i) {
+    if (i > 0)
+      json.push_back(',');
+    AppendNode(data.nodes[i], &json);
+  }
+  json.append("],\"startTime\":");
+  json.append(base::NumberToString(data.start_time));
+  json.append(",\"endTime\":");
+  json.append(base::NumberToString(data.end_time));
+  json.append(",\"samples\":[");
+  for (size_t i = 0; i < data.samples.size(); ++i) {
+    if (i > 0)
+      json.push_back(',');
+    json.append(base::NumberToString(data.samples[i]));
+  }
+  json.append("],\"timeDeltas\":[");
+  int64_t last_time = data.start_time;
+  for (size_t i = 0; i < data.timestamps.size(); ++i) {
+    if (i > 0)
+      json.push_back(',');
+    json.append(base::NumberToString(data.timestamps[i] - last_time));
+    last_time = data.timestamps[i];
+  }
+  json.append("]}");
+  return json;
+}
+
+bool WriteCpuProfile(const CpuProfileData& data, base::File file) {
+  if (!file.IsValid())
+    return false;
+  const std::string json = SerializeCpuProfile(data);
+  if (!base::IsValueInRangeForNumericType<int>(json.size()))
+    return false;
+  const int size = static_cast<int>(json.size());
+  return file.WriteAtCurrentPos(json.data(), size) == size;
+}
+
+v8::CpuProfile* StopProfiler(v8::Isolate* isolate, v8::CpuProfiler* profiler) {
+  v8::HandleScope handle_scope(isolate);
+  return profiler->StopProfiling(gin::StringToV8(isolate, kProfileTitle));
+}
+
+}  // namespace
+
+bool StartCpuProfiling(v8::Isolate* isolate,
+                       base::TimeDelta sampling_interval) {
+  CpuProfilers* profilers = CpuProfilers::Get();
+  if (profilers->Contains(isolate))
+    return false;
+
+  // Debug naming gives the names DevTools shows, e.g. for methods assigned
+  // to object properties.
+  v8::CpuProfiler* profiler =
+      v8::CpuProfiler::New(isolate, v8::kDebugNaming, v8::kLazyLogging);
+  profiler->SetSamplingInterval(
+      base::saturated_cast<int>(sampling_interval.InMicroseconds()));
+  v8::HandleScope handle_scope(isolate);
+  profiler->StartProfiling(gin::StringToV8(isolate, kProfileTitle), true);
+  profilers->Add(isolate, profiler);
+  return true;
+}
+
+void StopCpuProfiling(v8::Isolate* isolate,
+                      base::File file,
+                      base::OnceCallback<void(bool)> callback) {
+  v8::CpuProfiler* profiler = CpuProfilers::Get()->Take(isolate);
+  if (!profiler) {
+    base::SequencedTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::BindOnce(std::move(callback), false));
+    return;
+  }
+
+  // The profile belongs to the profiler, so it is copied before both are
+  // released on this thread.
+  v8::CpuProfile* profile = StopProfiler(isolate, profiler);
+  const bool stopped = profile != nullptr;
+  CpuProfileData data;
+  if (stopped) {
+    data = CopyCpuProfile(profile);
+    profile->Delete();
+  }
+  profiler->Dispose();
+  if (!stopped) {
+    base::SequencedTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::BindOnce(std::move(callback), false));
+    return;
+  }
+
+  base::PostTaskAndReplyWithResult(
+      FROM_HERE,
+      {base::ThreadPool(), base::MayBlock(), base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(&WriteCpuProfile, std::move(data), std::move(file)),
+      std::move(callback));
+}
+
+void CancelCpuProfiling(v8::Isolate* isolate) {
+  v8::CpuProfiler* profiler = CpuProfilers::Get()->Take(isolate);
+  if (!profiler)
+    return;
+  if (v8::CpuProfile* profile = StopProfiler(isolate, profiler))
+    profile->Delete();
+  profiler->Dispose();
+}
+
+}  // namespace electron
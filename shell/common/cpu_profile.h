@@ -0,0 +1,38 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_CPU_PROFILE_H_
+#define SHELL_COMMON_CPU_PROFILE_H_
+
+#include "base/callback.h"
+#include "base/files/file.h"
+#include "base/time/time.h"
+#include "v8/include/v8.h"
+
+namespace electron {
+
+// V8's default, DevTools uses the same.
+constexpr base::TimeDelta kDefaultCpuProfileSamplingInterval =
+    base::TimeDelta::FromMilliseconds(1);
+
+// Starts sampling the JavaScript stacks of |isolate|, which must be the
+// isolate of the calling thread. Returns false when it is already profiled.
+bool StartCpuProfiling(v8::Isolate* isolate, base::TimeDelta sampling_interval);
+
+// Stops profiling |isolate| and writes the profile to |file| in the format of
+// DevTools' .cpuprofile files. Only the samples are copied on the calling
+// thread, the profile is serialized and written on the thread pool.
+// |callback| is run on the calling sequence with whether the file was
+// written, which is false when |isolate| wasn't profiled.
+void StopCpuProfiling(v8::Isolate* isolate,
+                      base::File file,
+                      base::OnceCallback<void(bool)> callback);
+
+// Stops profiling |isolate| without writing the profile, must be called
+// before a profiled isolate is disposed.
+void CancelCpuProfiling(v8::Isolate* isolate);
+
+}  // namespace electron
+
+#endif  // SHELL_COMMON_CPU_PROFILE_H_
@@ -77,6 +77,8 @@ bool CrashReporter::GetUploadToServer() {
   return true;
 }
 
+void CrashReporter::SetUploadsDeferred(bool deferred) {}
+
 std::vector<CrashReporter::UploadReportResult>
 CrashReporter::GetUploadedReports(const base::FilePath& crashes_dir) {
   base::ThreadRestrictions::ScopedAllowIO allow_io;
@@ -47,6 +47,9 @@ class CrashReporter {
 
   virtual void SetUploadToServer(bool upload_to_server);
   virtual bool GetUploadToServer();
+  // Leaves the reports in the crashes directory for the crash pipeline to
+  // upload, instead of uploading them when the crash happens.
+  virtual void SetUploadsDeferred(bool deferred);
   virtual void AddExtraParameter(const std::string& key,
                                  const std::string& value);
   virtual void RemoveExtraParameter(const std::string& key);
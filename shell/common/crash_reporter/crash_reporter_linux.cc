@@ -85,6 +85,10 @@ bool CrashReporterLinux::GetUploadToServer() {
   return upload_to_server_;
 }
 
+void CrashReporterLinux::SetUploadsDeferred(bool deferred) {
+  uploads_deferred_ = deferred;
+}
+
 void CrashReporterLinux::EnableCrashDumping(const base::FilePath& crashes_dir) {
   {
     base::ThreadRestrictions::ScopedAllowIO allow_io;
@@ -122,7 +126,7 @@ bool CrashReporterLinux::CrashDone(const MinidumpDescriptor& minidump,
   info.fd = minidump.fd();
   info.distro = base::g_linux_distro;
   info.distro_length = my_strlen(base::g_linux_distro);
-  info.upload = self->upload_to_server_;
+  info.upload = self->upload_to_server_ && !self->uploads_deferred_;
   info.process_start_time = self->process_start_time_;
   info.oom_size = base::g_oom_size;
   info.pid = self->pid_;
@@ -37,6 +37,7 @@ class CrashReporterLinux : public CrashReporter {
   void SetUploadToServer(bool upload_to_server) override;
   void SetUploadParameters() override;
   bool GetUploadToServer() override;
+  void SetUploadsDeferred(bool deferred) override;
 
  private:
   friend struct base::DefaultSingletonTraits<CrashReporterLinux>;
@@ -57,6 +58,7 @@ class CrashReporterLinux : public CrashReporter {
   pid_t pid_ = 0;
   std::string upload_url_;
   bool upload_to_server_ = true;
+  bool uploads_deferred_ = false;
 
   DISALLOW_COPY_AND_ASSIGN(CrashReporterLinux);
 };
@@ -0,0 +1,326 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/crash_reporter/linux/minidump_signature.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_file.h"
+#include "base/hash/md5.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/strings/utf_string_conversions.h"
+#include "breakpad/src/google_breakpad/common/minidump_format.h"
+#include "build/build_config.h"
+
+namespace crash_reporter {
+
+namespace {
+
+const char kCRLF[] = "\r\n";
+const char kFormDataPrefix[] = "Content-Disposition: form-data; name=\"";
+const char kMinidumpName[] = "upload_file_minidump";
+const char kMinidumpHeaders[] =
+    "\"; filename=\"dump\"\r\n"
+    "Content-Type: application/octet-stream\r\n\r\n";
+const char kValueHeaders[] = "\"\r\n\r\n";
+
+// Reads a T at |offset| of |data|.
+template <typename T>
+bool ReadAt(base::StringPiece data, uint64_t offset, T* out) {
+  if (offset > data.size() || data.size() - offset < sizeof(T))
+    return false;
+  memcpy(out, data.data() + offset, sizeof(T));
+  return true;
+}
+
+bool ReadPC(base::StringPiece minidump,
+            const MDLocationDescriptor& context,
+            uint64_t* pc) {
+#if defined(ARCH_CPU_X86_64)
+  MDRawContextAMD64 raw_context;
+  if (!ReadAt(minidump, context.rva, &raw_context))
+    return false;
+  *pc = raw_context.rip;
+#elif defined(ARCH_CPU_X86)
+  MDRawContextX86 raw_context;
+  if (!ReadAt(minidump, context.rva, &raw_context))
+    return false;
+  *pc = raw_context.eip;
+#elif defined(ARCH_CPU_ARM64)
+  MDRawContextARM64 raw_context;
+  if (!ReadAt(minidump, context.rva, &raw_context))
+    return false;
+  *pc = raw_context.iregs[MD_CONTEXT_ARM64_REG_PC];
+#elif defined(ARCH_CPU_ARMEL)
+  MDRawContextARM raw_context;
+  if (!ReadAt(minidump, context.rva, &raw_context))
+    return false;
+  *pc = raw_context.iregs[MD_CONTEXT_ARM_REG_PC];
+#else
+  return false;
+#endif
+  return true;
+}
+
+bool ReadModuleName(base::StringPiece minidump,
+                    MDRVA rva,
+                    std::string* name) {
+  uint32_t length;
+  if (!ReadAt(minidump, rva, &length) || length % 2 ||
+      length > minidump.size() - rva - sizeof(length))
+    return false;
+  base::string16 utf16(length / 2, 0);
+  memcpy(&utf16[0], minidump.data() + rva + sizeof(length), length);
+  *name = base::FilePath(base::UTF16ToUTF8(utf16)).BaseName().value();
+  return true;
+}
+
+// Formats the identifier like dump_syms does, which is the first 16 bytes of
+// the ELF build id or the PDB GUID as a GUID, followed by the age.
+std::string ReadDebugId(base::StringPiece minidump,
+                        const MDLocationDescriptor& cv_record) {
+  uint32_t cv_signature;
+  if (!ReadAt(minidump, cv_record.rva, &cv_signature))
+    return std::string();
+
+  MDGUID guid = {};
+  uint32_t age = 0;
+  if (cv_signature == MD_CVINFOELF_SIGNATURE) {
+    // The build id can be shorter than a GUID.
+    if (cv_record.data_size < sizeof(cv_signature) ||
+        cv_record.data_size > minidump.size() - cv_record.rva)
+      return std::string();
+    size_t id_size = std::min<size_t>(
+        cv_record.data_size - sizeof(cv_signature), sizeof(guid));
+    memcpy(&guid, minidump.data() + cv_record.rva + sizeof(cv_signature),
+           id_size);
+  } else if (cv_signature == MD_CVINFOPDB70_SIGNATURE) {
+    MDCVInfoPDB70 pdb;
+    if (!ReadAt(minidump, cv_record.rva, &pdb))
+      return std::string();
+    guid = pdb.signature;
+    age = pdb.age;
+  } else {
+    return std::string();
+  }
+
+  std::string id = base::StringPrintf("%08X%04X%04X", guid.data1, guid.data2,
+                                      guid.data3);
+  for (uint8_t byte : guid.data4)
+    id += base::StringPrintf("%02X", byte);
+  id += base::StringPrintf("%X", age);
+  return id;
+}
+
+// Moves the first |count| space separated fields of |line| into |fields|,
+// leaving the rest of the line, which may contain spaces.
+bool TakeFields(base::StringPiece* line,
+                size_t count,
+                std::vector<base::StringPiece>* fields) {
+  for (size_t i = 0; i < count; ++i) {
+    size_t end = line->find(' ');
+    if (end == base::StringPiece::npos)
+      return false;
+    fields->push_back(line->substr(0, end));
+    line->remove_prefix(end + 1);
+  }
+  return true;
+}
+
+}  // namespace
+
+CrashReportFile::CrashReportFile() = default;
+CrashReportFile::CrashReportFile(const CrashReportFile&) = default;
+CrashReportFile::~CrashReportFile() = default;
+
+bool ParseCrashReportFile(base::StringPiece data, CrashReportFile* report) {
+  // The report starts with the delimiter of the first part, which is the
+  // boundary preceded by two hyphens.
+  size_t line_end = data.find(kCRLF);
+  if (line_end == base::StringPiece::npos || line_end <= 2 ||
+      !data.starts_with("--"))
+    return false;
+  const std::string delimiter = data.substr(0, line_end).as_string();
+  const std::string part_end = kCRLF + delimiter + kCRLF;
+  report->boundary = delimiter.substr(2);
+
+  size_t pos = line_end + 2;
+  while (data.substr(pos).starts_with(kFormDataPrefix)) {
+    pos += strlen(kFormDataPrefix);
+    size_t name_end = data.find('"', pos);
+    if (name_end == base::StringPiece::npos)
+      return false;
+    base::StringPiece name = data.substr(pos, name_end - pos);
+    base::StringPiece rest = data.substr(name_end);
+
+    // The minidump is the last part.
+    if (name == kMinidumpName && rest.starts_with(kMinidumpHeaders)) {
+      const std::string end = kCRLF + delimiter + "--" + kCRLF;
+      rest.remove_prefix(strlen(kMinidumpHeaders));
+      if (!rest.ends_with(end))
+        return false;
+      report->minidump = rest.substr(0, rest.size() - end.size());
+      return true;
+    }
+
+    if (!rest.starts_with(kValueHeaders))
+      return false;
+    size_t value_start = name_end + strlen(kValueHeaders);
+    size_t value_end = data.find(part_end, value_start);
+    if (value_end == base::StringPiece::npos)
+      return false;
+    report->crash_keys[name.as_string()] =
+        data.substr(value_start, value_end - value_start).as_string();
+    pos = value_end + part_end.size();
+  }
+  return false;
+}
+
+CrashSignature::CrashSignature() = default;
+CrashSignature::CrashSignature(const CrashSignature&) = default;
+CrashSignature::~CrashSignature() = default;
+
+std::string CrashSignature::GetId() const {
+  return base::MD5String(base::StringPrintf(
+      "%s\n%u\n%s\n%s\n%" PRIx64, process_type.c_str(), exception_code,
+      module.c_str(), debug_id.c_str(), offset));
+}
+
+std::string CrashSignature::GetReason() const {
+  switch (exception_code) {
+    case MD_EXCEPTION_CODE_LIN_SIGILL:
+      return "SIGILL";
+    case MD_EXCEPTION_CODE_LIN_SIGTRAP:
+      return "SIGTRAP";
+    case MD_EXCEPTION_CODE_LIN_SIGABRT:
+      return "SIGABRT";
+    case MD_EXCEPTION_CODE_LIN_SIGBUS:
+      return "SIGBUS";
+    case MD_EXCEPTION_CODE_LIN_SIGFPE:
+      return "SIGFPE";
+    case MD_EXCEPTION_CODE_LIN_SIGSEGV:
+      return "SIGSEGV";
+    case MD_EXCEPTION_CODE_LIN_DUMP_REQUESTED:
+      return "DUMP_REQUESTED";
+    default:
+      return base::StringPrintf("signal %u", exception_code);
+  }
+}
+
+bool ComputeCrashSignature(base::StringPiece minidump,
+                           CrashSignature* signature) {
+  MDRawHeader header;
+  if (!ReadAt(minidump, 0, &header) ||
+      header.signature != MD_HEADER_SIGNATURE ||
+      header.stream_count > minidump.size() / sizeof(MDRawDirectory))
+    return false;
+
+  const MDRawDirectory* exception_entry = nullptr;
+  const MDRawDirectory* modules_entry = nullptr;
+  std::vector<MDRawDirectory> directory(header.stream_count);
+  for (uint32_t i = 0; i < header.stream_count; ++i) {
+    uint64_t offset = header.stream_directory_rva +
+                      static_cast<uint64_t>(i) * sizeof(MDRawDirectory);
+    if (!ReadAt(minidump, offset, &directory[i]))
+      return false;
+    if (directory[i].stream_type == MD_EXCEPTION_STREAM)
+      exception_entry = &directory[i];
+    else if (directory[i].stream_type == MD_MODULE_LIST_STREAM)
+      modules_entry = &directory[i];
+  }
+
+  MDRawExceptionStream exception;
+  uint64_t pc;
+  if (!exception_entry ||
+      !ReadAt(minidump, exception_entry->location.rva, &exception) ||
+      !ReadPC(minidump, exception.thread_context, &pc))
+    return false;
+  signature->exception_code = exception.exception_record.exception_code;
+
+  uint32_t module_count = 0;
+  if (modules_entry)
+    ReadAt(minidump, modules_entry->location.rva, &module_count);
+  for (uint32_t i = 0; i < module_count; ++i) {
+    // The modules are packed, MDRawModule has trailing padding.
+    MDRawModule module = {};
+    uint64_t offset = modules_entry->location.rva + sizeof(module_count) +
+                      static_cast<uint64_t>(i) * MD_MODULE_SIZE;
+    if (offset > minidump.size() || minidump.size() - offset < MD_MODULE_SIZE)
+      return false;
+    memcpy(&module, minidump.data() + offset,
+           std::min<size_t>(sizeof(module), MD_MODULE_SIZE));
+    if (pc < module.base_of_image ||
+        pc - module.base_of_image >= module.size_of_image)
+      continue;
+    if (!ReadModuleName(minidump, module.module_name_rva, &signature->module))
+      return false;
+    signature->debug_id = ReadDebugId(minidump, module.cv_record);
+    signature->offset = pc - module.base_of_image;
+    break;
+  }
+  return true;
+}
+
+std::string SymbolizeCrashSignature(const base::FilePath& symbols_dir,
+                                    const CrashSignature& signature) {
+  if (symbols_dir.empty() || signature.module.empty() ||
+      signature.debug_id.empty())
+    return std::string();
+  base::ScopedFILE file(base::OpenFile(symbols_dir.Append(signature.module)
+                                           .Append(signature.debug_id)
+                                           .Append(signature.module + ".sym"),
+                                       "r"));
+  if (!file)
+    return std::string();
+
+  // The symbol files of a browser are hundreds of megabytes, so they are read
+  // line by line. FUNC records cover the address ranges of functions, PUBLIC
+  // ones only give the start of exported symbols.
+  std::string public_name;
+  uint64_t public_address = 0;
+  std::string function_name;
+  char* buffer = nullptr;
+  size_t buffer_size = 0;
+  ssize_t length;
+  while (function_name.empty() &&
+         (length = getline(&buffer, &buffer_size, file.get())) > 0) {
+    base::StringPiece line(buffer, length);
+    line = base::TrimString(line, "\r\n", base::TRIM_TRAILING);
+    bool is_function = line.starts_with("FUNC ");
+    if (!is_function && !line.starts_with("PUBLIC "))
+      continue;
+    line.remove_prefix(line.find(' ') + 1);
+    if (line.starts_with("m "))
+      line.remove_prefix(2);
+
+    std::vector<base::StringPiece> fields;
+    uint64_t address;
+    if (!TakeFields(&line, is_function ? 3 : 2, &fields) ||
+        !base::HexStringToUInt64(fields[0], &address) ||
+        address > signature.offset)
+      continue;
+    if (is_function) {
+      uint64_t size;
+      if (base::HexStringToUInt64(fields[1], &size) &&
+          signature.offset - address < size)
+        function_name = line.as_string();
+    } else if (address >= public_address) {
+      public_address = address;
+      public_name = line.as_string();
+    }
+  }
+  free(buffer);
+  return function_name.empty() ? public_name : function_name;
+}
+
+}  // namespace crash_reporter
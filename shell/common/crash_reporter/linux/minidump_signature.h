@@ -0,0 +1,75 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_CRASH_REPORTER_LINUX_MINIDUMP_SIGNATURE_H_
+#define SHELL_COMMON_CRASH_REPORTER_LINUX_MINIDUMP_SIGNATURE_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/strings/string_piece.h"
+
+namespace crash_reporter {
+
+// A crash report as saved by HandleCrashDump() when it isn't uploaded: a
+// multipart/form-data body holding the crash keys and the minidump.
+struct CrashReportFile {
+  CrashReportFile();
+  CrashReportFile(const CrashReportFile&);
+  ~CrashReportFile();
+
+  // The boundary of the parts, as given in the Content-Type of the upload.
+  std::string boundary;
+  std::map<std::string, std::string> crash_keys;
+  // Points into the data passed to ParseCrashReportFile().
+  base::StringPiece minidump;
+};
+
+// Returns false when |data| isn't a complete crash report, e.g. because the
+// crashing process is still writing it.
+bool ParseCrashReportFile(base::StringPiece data, CrashReportFile* report);
+
+// What identifies a crash: where the crashing thread was, relative to the
+// module it was running, and why it crashed.
+struct CrashSignature {
+  CrashSignature();
+  CrashSignature(const CrashSignature&);
+  ~CrashSignature();
+
+  std::string process_type;
+  // The signal, or MD_EXCEPTION_CODE_LIN_DUMP_REQUESTED.
+  uint32_t exception_code = 0;
+  // Base name of the module of the crashing instruction, empty when it isn't
+  // in a module, e.g. in JIT code.
+  std::string module;
+  // Breakpad debug identifier of |module|, locating its symbol file.
+  std::string debug_id;
+  // Offset of the crashing instruction in |module|, 0 without module.
+  uint64_t offset = 0;
+
+  // Returns a stable identifier of the signature.
+  std::string GetId() const;
+  // Returns e.g. "SIGSEGV".
+  std::string GetReason() const;
+};
+
+// Computes the signature of the crash described by the |minidump| written by
+// a process of this build, but the process type which is a crash key.
+// Returns false when it isn't a valid minidump.
+bool ComputeCrashSignature(base::StringPiece minidump,
+                           CrashSignature* signature);
+
+// Looks up the function containing the crashing instruction of |signature|
+// in the Breakpad symbol file of its module under |symbols_dir|, laid out as
+// by dump_syms: <module>/<debug id>/<module>.sym. Returns an empty string
+// when it can't be found.
+std::string SymbolizeCrashSignature(const base::FilePath& symbols_dir,
+                                    const CrashSignature& signature);
+
+}  // namespace crash_reporter
+
+#endif  // SHELL_COMMON_CRASH_REPORTER_LINUX_MINIDUMP_SIGNATURE_H_
@@ -4,10 +4,34 @@
 
 #include "shell/common/heap_snapshot.h"
 
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/macros.h"
+#include "base/sequenced_task_runner.h"
+#include "base/synchronization/condition_variable.h"
+#include "base/synchronization/lock.h"
+#include "base/task/post_task.h"
+#include "base/task_runner_util.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "base/threading/thread_restrictions.h"
+#include "shell/common/gin_helper/dictionary.h"
+#include "third_party/zlib/zlib.h"
 #include "v8/include/v8-profiler.h"
 
 namespace {
 
+// Serialized chunks waiting to be written, beyond which the serialization
+// waits for the writer so the snapshot isn't buffered in memory.
+const size_t kMaxPendingChunks = 8;
+
+// The use of the ForTesting flavor is a hack workaround to avoid having to
+// patch it as a friend into the guard class.
+class HeapSnapshotScopedAllowBaseSyncPrimitives
+    : public base::ScopedAllowBaseSyncPrimitivesForTesting {};
+
 class HeapSnapshotOutputStream : public v8::OutputStream {
  public:
   explicit HeapSnapshotOutputStream(base::File* file) : file_(file) {
@@ -30,6 +54,166 @@ class HeapSnapshotOutputStream : public v8::OutputStream {
   bool is_complete_ = false;
 };
 
+// Compresses and writes the chunks of a serialized snapshot, lives on the
+// thread pool but for WaitForRoom().
+class HeapSnapshotFileWriter {
+ public:
+  HeapSnapshotFileWriter(base::File file, bool compress)
+      : file_(std::move(file)),
+        compress_(compress),
+        chunk_written_(&pending_chunks_lock_) {
+    if (compress_) {
+      // 16 + MAX_WBITS makes zlib write a gzip header. The fastest level
+      // keeps up with the serialization while still shrinking the mostly
+      // repetitive JSON several times.
+      failed_ = deflateInit2(&zstream_, Z_BEST_SPEED, Z_DEFLATED,
+                             16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK;
+      zstream_initialized_ = !failed_;
+    }
+  }
+
+  ~HeapSnapshotFileWriter() {
+    if (zstream_initialized_)
+      deflateEnd(&zstream_);
+  }
+
+  // Called on the serializing thread before posting a chunk, blocks it while
+  // too many chunks are waiting to be written.
+  void WaitForRoom() {
+    base::AutoLock lock(pending_chunks_lock_);
+    if (pending_chunks_ >= kMaxPendingChunks) {
+      HeapSnapshotScopedAllowBaseSyncPrimitives allow_base_sync_primitives;
+      while (pending_chunks_ >= kMaxPendingChunks)
+        chunk_written_.Wait();
+    }
+    pending_chunks_++;
+  }
+
+  void Write(std::string chunk) {
+    if (!failed_) {
+      if (compress_)
+        Deflate(chunk, Z_NO_FLUSH);
+      else
+        failed_ = !WriteToFile(chunk.data(), chunk.size());
+    }
+    base::AutoLock lock(pending_chunks_lock_);
+    pending_chunks_--;
+    chunk_written_.Signal();
+  }
+
+  // Returns whether the whole snapshot was written, |complete| telling
+  // whether it was entirely serialized.
+  bool Finish(bool complete) {
+    if (complete && compress_ && !failed_)
+      Deflate(std::string(), Z_FINISH);
+    return complete && !failed_;
+  }
+
+ private:
+  bool WriteToFile(const char* data, size_t size) {
+    return file_.WriteAtCurrentPos(data, size) == static_cast<int>(size);
+  }
+
+  void Deflate(const std::string& input, int flush) {
+    zstream_.next_in =
+        reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+    zstream_.avail_in = input.size();
+    buffer_.resize(65536);
+    do {
+      zstream_.next_out = reinterpret_cast<Bytef*>(buffer_.data());
+      zstream_.avail_out = buffer_.size();
+      if (deflate(&zstream_, flush) == Z_STREAM_ERROR) {
+        failed_ = true;
+        return;
+      }
+      size_t size = buffer_.size() - zstream_.avail_out;
+      if (size > 0 && !WriteToFile(buffer_.data(), size)) {
+        failed_ = true;
+        return;
+      }
+    } while (zstream_.avail_out == 0);
+  }
+
+  base::File file_;
+  bool compress_;
+  bool failed_ = false;
+  z_stream zstream_ = {};
+  bool zstream_initialized_ = false;
+  std::vector<char> buffer_;
+
+  base::Lock pending_chunks_lock_;
+  base::ConditionVariable chunk_written_;
+  size_t pending_chunks_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(HeapSnapshotFileWriter);
+};
+
+// Hands the serialized chunks over to a HeapSnapshotFileWriter.
+//
+// A few chunks are queued without waiting for the writer, so the calling
+// thread is mostly blocked by the serialization, and only waits for the
+// writer when the compression or the disk can't keep up.
+class HeapSnapshotStreamingOutputStream : public v8::OutputStream {
+ public:
+  HeapSnapshotStreamingOutputStream(
+      scoped_refptr<base::SequencedTaskRunner> task_runner,
+      HeapSnapshotFileWriter* writer,
+      const electron::HeapSnapshotProgressCallback& progress)
+      : task_runner_(std::move(task_runner)),
+        writer_(writer),
+        progress_(progress) {}
+
+  bool IsComplete() const { return is_complete_; }
+
+  // v8::OutputStream
+  int GetChunkSize() override { return 1 << 20; }
+  void EndOfStream() override { is_complete_ = true; }
+
+  v8::OutputStream::WriteResult WriteAsciiChunk(char* data, int size) override {
+    // The writer is deleted by the last task posted to |task_runner_|.
+    writer_->WaitForRoom();
+    task_runner_->PostTask(FROM_HERE,
+                           base::BindOnce(&HeapSnapshotFileWriter::Write,
+                                          base::Unretained(writer_),
+                                          std::string(data, size)));
+    written_ += size;
+    if (progress_) {
+      electron::HeapSnapshotProgress progress;
+      progress.phase = electron::HeapSnapshotProgress::Phase::kWrite;
+      progress.done = written_;
+      progress_.Run(progress);
+    }
+    return kContinue;
+  }
+
+ private:
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+  HeapSnapshotFileWriter* writer_;
+  electron::HeapSnapshotProgressCallback progress_;
+  uint64_t written_ = 0;
+  bool is_complete_ = false;
+};
+
+class HeapSnapshotActivityControl : public v8::ActivityControl {
+ public:
+  explicit HeapSnapshotActivityControl(
+      const electron::HeapSnapshotProgressCallback& progress)
+      : progress_(progress) {}
+
+  // v8::ActivityControl
+  ControlOption ReportProgressValue(int done, int total) override {
+    electron::HeapSnapshotProgress progress;
+    progress.phase = electron::HeapSnapshotProgress::Phase::kSnapshot;
+    progress.done = done;
+    progress.total = total;
+    progress_.Run(progress);
+    return kContinue;
+  }
+
+ private:
+  electron::HeapSnapshotProgressCallback progress_;
+};
+
 }  // namespace
 
 namespace electron {
@@ -53,4 +237,61 @@ bool TakeHeapSnapshot(v8::Isolate* isolate, base::File* file) {
   return stream.IsComplete();
 }
 
+void StreamHeapSnapshot(v8::Isolate* isolate,
+                        base::File file,
+                        bool compress,
+                        const HeapSnapshotProgressCallback& progress,
+                        base::OnceCallback<void(bool)> callback) {
+  DCHECK(isolate);
+
+  if (!file.IsValid()) {
+    base::SequencedTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::BindOnce(std::move(callback), false));
+    return;
+  }
+
+  auto task_runner = base::CreateSequencedTaskRunner(
+      {base::ThreadPool(), base::MayBlock(), base::TaskPriority::USER_VISIBLE});
+  auto* writer = new HeapSnapshotFileWriter(std::move(file), compress);
+
+  HeapSnapshotActivityControl control(progress);
+  auto* snapshot = isolate->GetHeapProfiler()->TakeHeapSnapshot(
+      progress ? &control : nullptr);
+  bool complete = false;
+  if (snapshot) {
+    HeapSnapshotStreamingOutputStream stream(task_runner, writer, progress);
+    snapshot->Serialize(&stream, v8::HeapSnapshot::kJSON);
+    const_cast<v8::HeapSnapshot*>(snapshot)->Delete();
+    complete = stream.IsComplete();
+  }
+
+  base::PostTaskAndReplyWithResult(
+      task_runner.get(), FROM_HERE,
+      base::BindOnce(&HeapSnapshotFileWriter::Finish, base::Owned(writer),
+                     complete),
+      std::move(callback));
+}
+
 }  // namespace electron
+
+namespace gin {
+
+// static
+v8::Local<v8::Value> Converter<electron::HeapSnapshotProgress>::ToV8(
+    v8::Isolate* isolate,
+    const electron::HeapSnapshotProgress& progress) {
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  switch (progress.phase) {
+    case electron::HeapSnapshotProgress::Phase::kSnapshot:
+      dict.Set("phase", "snapshot");
+      dict.Set("total", static_cast<double>(progress.total));
+      break;
+    case electron::HeapSnapshotProgress::Phase::kWrite:
+      dict.Set("phase", "write");
+      break;
+  }
+  dict.Set("done", static_cast<double>(progress.done));
+  return dict.GetHandle();
+}
+
+}  // namespace gin
@@ -5,13 +5,57 @@
 #ifndef SHELL_COMMON_HEAP_SNAPSHOT_H_
 #define SHELL_COMMON_HEAP_SNAPSHOT_H_
 
+#include <cstdint>
+
+#include "base/callback.h"
 #include "base/files/file.h"
+#include "gin/converter.h"
 #include "v8/include/v8.h"
 
 namespace electron {
 
+struct HeapSnapshotProgress {
+  enum class Phase {
+    // The heap is walked, |done| and |total| count objects.
+    kSnapshot,
+    // The snapshot is serialized, |done| counts bytes and |total| is 0.
+    kWrite,
+  };
+
+  Phase phase = Phase::kSnapshot;
+  uint64_t done = 0;
+  uint64_t total = 0;
+};
+
+using HeapSnapshotProgressCallback =
+    base::RepeatingCallback<void(const HeapSnapshotProgress&)>;
+
 bool TakeHeapSnapshot(v8::Isolate* isolate, base::File* file);
 
+// Takes a heap snapshot of |isolate| and writes it to |file|, gzip compressed
+// when |compress| is true. Only the snapshot and its serialization happen on
+// the calling thread, the serialized chunks are handed to the thread pool to
+// be compressed and written, the calling thread waiting when a few of them
+// are pending. |progress| is run on the calling thread while the
+// snapshot is taken, so it must not run JavaScript, and |callback| is run on
+// the calling sequence once the file is written.
+void StreamHeapSnapshot(v8::Isolate* isolate,
+                        base::File file,
+                        bool compress,
+                        const HeapSnapshotProgressCallback& progress,
+                        base::OnceCallback<void(bool)> callback);
+
 }  // namespace electron
 
+namespace gin {
+
+template <>
+struct Converter<electron::HeapSnapshotProgress> {
+  static v8::Local<v8::Value> ToV8(
+      v8::Isolate* isolate,
+      const electron::HeapSnapshotProgress& progress);
+};
+
+}  // namespace gin
+
 #endif  // SHELL_COMMON_HEAP_SNAPSHOT_H_
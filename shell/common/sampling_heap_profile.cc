@@ -0,0 +1,86 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/sampling_heap_profile.h"
+
+#include <memory>
+#include <vector>
+
+#include "base/strings/string_number_conversions.h"
+#include "shell/common/gin_helper/dictionary.h"
+#include "v8/include/v8-profiler.h"
+
+namespace electron {
+
+namespace {
+
+// Converts |node| like DevTools' SamplingHeapProfileNode.
+v8::Local<v8::Value> NodeToV8(v8::Isolate* isolate,
+                              const v8::AllocationProfile::Node* node) {
+  gin_helper::Dictionary call_frame = gin::Dictionary::CreateEmpty(isolate);
+  call_frame.Set("functionName", node->name);
+  call_frame.Set("scriptId", base::NumberToString(node->script_id));
+  call_frame.Set("url", node->script_name);
+  // V8 lines and columns start at 1, DevTools' at 0.
+  call_frame.Set("lineNumber", node->line_number - 1);
+  call_frame.Set("columnNumber", node->column_number - 1);
+
+  size_t self_size = 0;
+  for (const auto& allocation : node->allocations)
+    self_size += allocation.size * allocation.count;
+
+  std::vector<v8::Local<v8::Value>> children;
+  children.reserve(node->children.size());
+  for (const auto* child : node->children)
+    children.push_back(NodeToV8(isolate, child));
+
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  dict.Set("callFrame", call_frame);
+  dict.Set("selfSize", static_cast<double>(self_size));
+  dict.Set("id", node->node_id);
+  dict.Set("children", children);
+  return dict.GetHandle();
+}
+
+}  // namespace
+
+bool StartSamplingHeapProfiler(v8::Isolate* isolate,
+                               const SamplingHeapProfilerOptions& options) {
+  int flags = v8::HeapProfiler::kSamplingNoFlags;
+  if (options.include_objects_collected_by_major_gc)
+    flags |= v8::HeapProfiler::kSamplingIncludeObjectsCollectedByMajorGC;
+  if (options.include_objects_collected_by_minor_gc)
+    flags |= v8::HeapProfiler::kSamplingIncludeObjectsCollectedByMinorGC;
+  return isolate->GetHeapProfiler()->StartSamplingHeapProfiler(
+      options.sampling_interval, options.stack_depth,
+      static_cast<v8::HeapProfiler::SamplingFlags>(flags));
+}
+
+void StopSamplingHeapProfiler(v8::Isolate* isolate) {
+  isolate->GetHeapProfiler()->StopSamplingHeapProfiler();
+}
+
+v8::Local<v8::Value> GetSamplingHeapProfile(v8::Isolate* isolate) {
+  std::unique_ptr<v8::AllocationProfile> profile(
+      isolate->GetHeapProfiler()->GetAllocationProfile());
+  if (!profile)
+    return v8::Null(isolate);
+
+  std::vector<v8::Local<v8::Value>> samples;
+  samples.reserve(profile->GetSamples().size());
+  for (const auto& sample : profile->GetSamples()) {
+    gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+    dict.Set("size", static_cast<double>(sample.size * sample.count));
+    dict.Set("nodeId", sample.node_id);
+    dict.Set("ordinal", static_cast<double>(sample.sample_id));
+    samples.push_back(dict.GetHandle());
+  }
+
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  dict.Set("head", NodeToV8(isolate, profile->GetRootNode()));
+  dict.Set("samples", samples);
+  return dict.GetHandle();
+}
+
+}  // namespace electron
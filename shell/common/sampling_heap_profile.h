@@ -0,0 +1,36 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_SAMPLING_HEAP_PROFILE_H_
+#define SHELL_COMMON_SAMPLING_HEAP_PROFILE_H_
+
+#include <cstdint>
+
+#include "v8/include/v8.h"
+
+namespace electron {
+
+struct SamplingHeapProfilerOptions {
+  // Average number of bytes between two sampled allocations, V8's default
+  // keeps the overhead low enough to profile continuously.
+  uint64_t sampling_interval = 512 * 1024;
+  int stack_depth = 16;
+  bool include_objects_collected_by_major_gc = false;
+  bool include_objects_collected_by_minor_gc = false;
+};
+
+// Starts sampling the allocations of |isolate|, returns false when the
+// profiler is already started.
+bool StartSamplingHeapProfiler(v8::Isolate* isolate,
+                               const SamplingHeapProfilerOptions& options);
+
+void StopSamplingHeapProfiler(v8::Isolate* isolate);
+
+// Returns the allocations sampled since the profiler started in the format of
+// DevTools' .heapprofile files, or null when the profiler isn't started.
+v8::Local<v8::Value> GetSamplingHeapProfile(v8::Isolate* isolate);
+
+}  // namespace electron
+
+#endif  // SHELL_COMMON_SAMPLING_HEAP_PROFILE_H_
@@ -2,9 +2,13 @@
 // Use of this source code is governed by the MIT license that can be
 // found in the LICENSE file.
 
+#include <climits>
+#include <cstring>
 #include <string>
+#include <vector>
 
 #include "base/files/file_util.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/strings/pattern.h"
 #include "base/strings/string_util.h"
 #include "base/threading/thread_restrictions.h"
@@ -150,6 +154,88 @@ bool PopulateImageSkiaRepsFromPath(gfx::ImageSkia* image,
         image, path.InsertBeforeExtensionASCII(pair.name), pair.scale);
   return succeed;
 }
+
+// Returns false when |path| exists but isn't a PNG image.
+bool AddPNGRepFromPath(std::vector<gfx::ImagePNGRep>* reps,
+                       const base::FilePath& path,
+                       float scale_factor) {
+  std::string file_contents;
+  {
+    base::ThreadRestrictions::ScopedAllowIO allow_io;
+    if (!asar::ReadFileToString(path, &file_contents))
+      return true;
+  }
+
+  gfx::Size pixel_size;
+  if (!GetPNGSize(reinterpret_cast<const unsigned char*>(file_contents.data()),
+                  file_contents.size(), &pixel_size))
+    return false;
+
+  reps->emplace_back(base::RefCountedString::TakeString(&file_contents),
+                     scale_factor);
+  return true;
+}
+
+bool ReadPNGRepsFromPath(std::vector<gfx::ImagePNGRep>* reps,
+                         const base::FilePath& path) {
+  // Other files would be read again to be decoded.
+  if (!path.MatchesExtension(FILE_PATH_LITERAL(".png")))
+    return false;
+
+  std::string filename(path.BaseName().RemoveExtension().AsUTF8Unsafe());
+  if (base::MatchPattern(filename, "*@*x")) {
+    // Don't search for other representations if the DPI has been specified.
+    if (!AddPNGRepFromPath(reps, path, GetScaleFactorFromPath(path)))
+      return false;
+  } else {
+    if (!AddPNGRepFromPath(reps, path, 1.0f))
+      return false;
+    for (const ScaleFactorPair& pair : kScaleFactorPairs) {
+      if (!AddPNGRepFromPath(reps, path.InsertBeforeExtensionASCII(pair.name),
+                             pair.scale))
+        return false;
+    }
+  }
+  return !reps->empty();
+}
+
+bool GetPNGSize(const unsigned char* data, size_t size, gfx::Size* pixel_size) {
+  // The signature is followed by the IHDR chunk, which starts with the width
+  // and height as big-endian 32-bit integers.
+  static const unsigned char kSignature[] = {0x89, 'P',  'N',  'G',
+                                             '\r', '\n', 0x1a, '\n'};
+  if (size < 24 || memcmp(data, kSignature, sizeof(kSignature)) != 0 ||
+      memcmp(data + 12, "IHDR", 4) != 0)
+    return false;
+
+  auto read_int = [](const unsigned char* p) {
+    return (static_cast<uint32_t>(p[0]) << 24) |
+           (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+  };
+  uint32_t width = read_int(data + 16);
+  uint32_t height = read_int(data + 20);
+  if (width == 0 || height == 0 || width > INT_MAX || height > INT_MAX)
+    return false;
+
+  // Each chunk is its length, its type, its data and a CRC. Walking them up
+  // to IEND catches truncated data without inflating anything.
+  size_t offset = sizeof(kSignature);
+  while (true) {
+    if (size - offset < 12)
+      return false;
+    const uint32_t length = read_int(data + offset);
+    if (length > size - offset - 12)
+      return false;
+    if (memcmp(data + offset + 4, "IEND", 4) == 0)
+      break;
+    offset += 12 + length;
+  }
+
+  pixel_size->SetSize(static_cast<int>(width), static_cast<int>(height));
+  return true;
+}
+
 #if defined(OS_WIN)
 bool ReadImageSkiaFromICO(gfx::ImageSkia* image, HICON icon) {
   // Convert the icon from the Windows specific HICON to gfx::ImageSkia.
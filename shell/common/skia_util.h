@@ -6,7 +6,9 @@
 #define SHELL_COMMON_SKIA_UTIL_H_
 
 #include <string>
+#include <vector>
 
+#include "ui/gfx/image/image_png_rep.h"
 #include "ui/gfx/image/image_skia.h"
 
 namespace electron {
@@ -16,6 +18,16 @@ namespace util {
 bool PopulateImageSkiaRepsFromPath(gfx::ImageSkia* image,
                                    const base::FilePath& path);
 
+// Reads the same files as PopulateImageSkiaRepsFromPath without decoding them.
+// Returns false when none is found, when |path| doesn't have the .png
+// extension or when any of them isn't a PNG image.
+bool ReadPNGRepsFromPath(std::vector<gfx::ImagePNGRep>* reps,
+                         const base::FilePath& path);
+
+// Reads the pixel size from the header of PNG encoded |data|, returns false
+// when |data| isn't a PNG image or is truncated.
+bool GetPNGSize(const unsigned char* data, size_t size, gfx::Size* pixel_size);
+
 bool AddImageSkiaRepFromBuffer(gfx::ImageSkia* image,
                                const unsigned char* data,
                                size_t size,
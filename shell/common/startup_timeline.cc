@@ -0,0 +1,87 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/startup_timeline.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "base/no_destructor.h"
+#include "base/process/process.h"
+#include "base/synchronization/lock.h"
+#include "base/trace_event/trace_event.h"
+
+namespace electron {
+
+namespace startup_timeline {
+
+namespace {
+
+struct Timeline {
+  base::Lock lock;
+  base::TimeTicks process_start;
+  std::vector<Mark> marks;
+};
+
+Timeline* GetTimeline() {
+  static base::NoDestructor<Timeline> timeline;
+  return timeline.get();
+}
+
+// Must be called with the lock held.
+base::TimeTicks GetProcessStartTimeLocked(Timeline* timeline,
+                                          base::TimeTicks now) {
+  if (timeline->process_start.is_null()) {
+    if (!timeline->marks.empty())
+      now = timeline->marks.front().time;
+    // Only the wall clock creation time is available, translate it to ticks.
+    // It is coarse on some platforms, so never let it be after |now|.
+    base::Time creation_time = base::Process::Current().CreationTime();
+    timeline->process_start = now;
+    if (!creation_time.is_null() && creation_time < base::Time::Now())
+      timeline->process_start -= base::Time::Now() - creation_time;
+  }
+  return timeline->process_start;
+}
+
+}  // namespace
+
+void AddMark(const char* name) {
+  base::TimeTicks now = base::TimeTicks::Now();
+  base::TimeTicks previous;
+  {
+    Timeline* timeline = GetTimeline();
+    base::AutoLock auto_lock(timeline->lock);
+    if (std::any_of(timeline->marks.begin(), timeline->marks.end(),
+                    [name](const Mark& mark) {
+                      return std::strcmp(mark.name, name) == 0;
+                    }))
+      return;
+    previous = timeline->marks.empty()
+                   ? GetProcessStartTimeLocked(timeline, now)
+                   : timeline->marks.back().time;
+    timeline->marks.push_back({name, now});
+  }
+
+  TRACE_EVENT_NESTABLE_ASYNC_BEGIN_WITH_TIMESTAMP0(
+      "electron", name, TRACE_ID_LOCAL(GetTimeline()), previous);
+  TRACE_EVENT_NESTABLE_ASYNC_END_WITH_TIMESTAMP0(
+      "electron", name, TRACE_ID_LOCAL(GetTimeline()), now);
+}
+
+std::vector<Mark> GetMarks() {
+  Timeline* timeline = GetTimeline();
+  base::AutoLock auto_lock(timeline->lock);
+  return timeline->marks;
+}
+
+base::TimeTicks GetProcessStartTime() {
+  Timeline* timeline = GetTimeline();
+  base::AutoLock auto_lock(timeline->lock);
+  return GetProcessStartTimeLocked(timeline, base::TimeTicks::Now());
+}
+
+}  // namespace startup_timeline
+
+}  // namespace electron
@@ -0,0 +1,41 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_STARTUP_TIMELINE_H_
+#define SHELL_COMMON_STARTUP_TIMELINE_H_
+
+#include <vector>
+
+#include "base/time/time.h"
+
+namespace electron {
+
+// Records when the current process reached each of its startup phases.
+//
+// Only the first mark of each name is kept, so marks can be added from code
+// that runs for every window or frame. Marks are also emitted as trace events
+// in the "electron" category, each phase as a slice that starts at the
+// previous mark.
+namespace startup_timeline {
+
+struct Mark {
+  // Must be a string literal, it is used as the trace event name.
+  const char* name;
+  base::TimeTicks time;
+};
+
+// Thread-safe.
+void AddMark(const char* name);
+
+std::vector<Mark> GetMarks();
+
+// Returns when the process was created, or the time of the first mark when
+// the OS does not report it.
+base::TimeTicks GetProcessStartTime();
+
+}  // namespace startup_timeline
+
+}  // namespace electron
+
+#endif  // SHELL_COMMON_STARTUP_TIMELINE_H_
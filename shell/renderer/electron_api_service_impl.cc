@@ -8,10 +8,13 @@
 #include <utility>
 #include <vector>
 
+#include "base/bind.h"
 #include "base/environment.h"
 #include "base/macros.h"
 #include "base/threading/thread_restrictions.h"
+#include "mojo/public/cpp/bindings/remote.h"
 #include "mojo/public/cpp/system/platform_handle.h"
+#include "shell/common/cpu_profile.h"
 #include "shell/common/electron_constants.h"
 #include "shell/common/gin_converters/blink_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
@@ -213,6 +216,8 @@ void ElectronApiServiceImpl::UpdateCrashpadPipeName(
 
 void ElectronApiServiceImpl::TakeHeapSnapshot(
     mojo::ScopedHandle file,
+    bool compress,
+    mojo::PendingRemote<mojom::HeapSnapshotObserver> observer,
     TakeHeapSnapshotCallback callback) {
   base::ThreadRestrictions::ScopedAllowIO allow_io;
 
@@ -225,10 +230,59 @@ void ElectronApiServiceImpl::TakeHeapSnapshot(
   }
   base::File base_file(platform_file);
 
-  bool success =
-      electron::TakeHeapSnapshot(blink::MainThreadIsolate(), &base_file);
+  // Progress is sent over IPC as the snapshot is taken, when no JavaScript can
+  // run in this process.
+  mojo::Remote<mojom::HeapSnapshotObserver> observer_remote;
+  HeapSnapshotProgressCallback progress;
+  if (observer) {
+    observer_remote.Bind(std::move(observer));
+    progress = base::BindRepeating(
+        [](mojom::HeapSnapshotObserver* observer,
+           const HeapSnapshotProgress& progress) {
+          observer->OnProgress(
+              progress.phase == HeapSnapshotProgress::Phase::kSnapshot
+                  ? mojom::HeapSnapshotPhase::kSnapshot
+                  : mojom::HeapSnapshotPhase::kWrite,
+              progress.done, progress.total);
+        },
+        base::Unretained(observer_remote.get()));
+  }
+
+  electron::StreamHeapSnapshot(blink::MainThreadIsolate(),
+                               std::move(base_file), compress, progress,
+                               std::move(callback));
+}
+
+void ElectronApiServiceImpl::StartCpuProfiling(
+    int32_t sampling_interval_us,
+    StartCpuProfilingCallback callback) {
+  std::move(callback).Run(electron::StartCpuProfiling(
+      blink::MainThreadIsolate(),
+      base::TimeDelta::FromMicroseconds(sampling_interval_us)));
+}
+
+void ElectronApiServiceImpl::StopCpuProfiling(
+    mojo::ScopedHandle file,
+    StopCpuProfilingCallback callback) {
+  v8::Isolate* isolate = blink::MainThreadIsolate();
+  // A null file is how the browser cancels the profiling.
+  if (!file.is_valid()) {
+    CancelCpuProfiling(isolate);
+    std::move(callback).Run(false);
+    return;
+  }
+
+  base::PlatformFile platform_file;
+  if (mojo::UnwrapPlatformFile(std::move(file), &platform_file) !=
+      MOJO_RESULT_OK) {
+    LOG(ERROR) << "Unable to get the file handle from mojo.";
+    CancelCpuProfiling(isolate);
+    std::move(callback).Run(false);
+    return;
+  }
 
-  std::move(callback).Run(success);
+  electron::StopCpuProfiling(isolate, base::File(platform_file),
+                             std::move(callback));
 }
 
 }  // namespace electron
@@ -38,8 +38,15 @@ class ElectronApiServiceImpl : public mojom::ElectronRenderer,
                                    int32_t object_id) override;
 #endif
   void UpdateCrashpadPipeName(const std::string& pipe_name) override;
-  void TakeHeapSnapshot(mojo::ScopedHandle file,
-                        TakeHeapSnapshotCallback callback) override;
+  void TakeHeapSnapshot(
+      mojo::ScopedHandle file,
+      bool compress,
+      mojo::PendingRemote<mojom::HeapSnapshotObserver> observer,
+      TakeHeapSnapshotCallback callback) override;
+  void StartCpuProfiling(int32_t sampling_interval_us,
+                         StartCpuProfilingCallback callback) override;
+  void StopCpuProfiling(mojo::ScopedHandle file,
+                        StopCpuProfilingCallback callback) override;
 
   base::WeakPtr<ElectronApiServiceImpl> GetWeakPtr() {
     return weak_factory_.GetWeakPtr();
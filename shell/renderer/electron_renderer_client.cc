@@ -18,6 +18,7 @@
 #include "shell/common/node_includes.h"
 #include "shell/common/node_util.h"
 #include "shell/common/options_switches.h"
+#include "shell/common/startup_timeline.h"
 #include "shell/renderer/electron_render_frame_observer.h"
 #include "shell/renderer/web_worker_observer.h"
 #include "third_party/blink/public/web/web_document.h"
@@ -143,6 +144,7 @@ void ElectronRendererClient::DidCreateScriptContext(
 
   // Load everything.
   node_bindings_->LoadEnvironment(env);
+  startup_timeline::AddMark("environment-loaded");
 
   if (node_bindings_->uv_env() == nullptr) {
     // Make uv loop being wrapped by window context.
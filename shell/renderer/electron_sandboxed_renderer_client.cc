@@ -18,6 +18,7 @@
 #include "shell/common/node_includes.h"
 #include "shell/common/node_util.h"
 #include "shell/common/options_switches.h"
+#include "shell/common/startup_timeline.h"
 #include "shell/renderer/electron_render_frame_observer.h"
 #include "third_party/blink/public/web/blink.h"
 #include "third_party/blink/public/web/web_document.h"
@@ -223,6 +224,7 @@ void ElectronSandboxedRendererClient::DidCreateScriptContext(
   util::CompileAndCall(
       isolate->GetCurrentContext(), "electron/js2c/sandbox_bundle",
       &sandbox_preload_bundle_params, &sandbox_preload_bundle_args, nullptr);
+  startup_timeline::AddMark("environment-loaded");
 
   v8::HandleScope handle_scope(isolate);
   v8::Context::Scope context_scope(context);
@@ -9,9 +9,14 @@
 #include <utility>
 #include <vector>
 
+#include "base/bind.h"
 #include "base/command_line.h"
+#include "base/hash/sha1.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "components/network_hints/renderer/web_prescient_networking_impl.h"
 #include "content/common/buildflags.h"
 #include "content/public/common/content_constants.h"
@@ -20,10 +25,14 @@
 #include "content/public/renderer/render_thread.h"
 #include "content/public/renderer/render_view.h"
 #include "electron/buildflags/buildflags.h"
+#include "gin/converter.h"
 #include "printing/buildflags/buildflags.h"
+#include "services/service_manager/public/cpp/interface_provider.h"
+#include "shell/common/api/api.mojom.h"
 #include "shell/common/color_util.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/options_switches.h"
+#include "shell/common/startup_timeline.h"
 #include "shell/renderer/browser_exposed_renderer_interfaces.h"
 #include "shell/renderer/content_settings_observer.h"
 #include "shell/renderer/electron_api_service_impl.h"
@@ -33,6 +42,7 @@
 #include "third_party/blink/public/web/blink.h"
 #include "third_party/blink/public/web/web_custom_element.h"  // NOLINT(build/include_alpha)
 #include "third_party/blink/public/web/web_frame_widget.h"
+#include "third_party/blink/public/web/web_local_frame.h"
 #include "third_party/blink/public/web/web_plugin_params.h"
 #include "third_party/blink/public/web/web_script_source.h"
 #include "third_party/blink/public/web/web_security_policy.h"
@@ -92,6 +102,33 @@ std::vector<std::string> ParseSchemesCLISwitch(base::CommandLine* command_line,
                            base::SPLIT_WANT_NONEMPTY);
 }
 
+// The V8 version is part of the key so that an upgrade never reuses the data
+// of the previous build. The browser only accepts lowercase hex SHA-1 keys.
+std::string GetCodeCacheKey(v8::Isolate* isolate,
+                            v8::Local<v8::String> source) {
+  std::string data = v8::V8::GetVersion();
+  data += '\0';
+  data += gin::V8ToString(isolate, source);
+  return base::ToLowerASCII(base::HexEncode(base::SHA1HashString(data).data(),
+                                            base::kSHA1Length));
+}
+
+// Runs after the task that compiled the script, so the cache also covers the
+// functions that the script has called by then.
+void ProduceCodeCache(v8::Isolate* isolate,
+                      v8::Global<v8::UnboundScript> script,
+                      const std::string& key,
+                      mojom::ElectronBrowserPtr browser_ptr) {
+  v8::HandleScope handle_scope(isolate);
+  std::unique_ptr<v8::ScriptCompiler::CachedData> data(
+      v8::ScriptCompiler::CreateCodeCache(script.Get(isolate)));
+  if (!data || data->length <= 0)
+    return;
+  browser_ptr->SetCodeCache(
+      key, mojo_base::BigBuffer(base::make_span(
+               data->data, static_cast<size_t>(data->length))));
+}
+
 }  // namespace
 
 RendererClientBase::RendererClientBase() {
@@ -117,6 +154,7 @@ RendererClientBase::~RendererClientBase() = default;
 void RendererClientBase::DidCreateScriptContext(
     v8::Handle<v8::Context> context,
     content::RenderFrame* render_frame) {
+  startup_timeline::AddMark("script-context-created");
   // global.setHidden("contextId", `${processHostId}-${++next_context_id_}`)
   auto context_id = base::StringPrintf(
       "%s-%" PRId64, renderer_client_id_.c_str(), ++next_context_id_);
@@ -136,6 +174,7 @@ void RendererClientBase::AddRenderBindings(
     v8::Local<v8::Object> binding_object) {}
 
 void RendererClientBase::RenderThreadStarted() {
+  startup_timeline::AddMark("render-thread-started");
   auto* command_line = base::CommandLine::ForCurrentProcess();
 
 #if BUILDFLAG(USE_EXTERNAL_POPUP_MENU)
@@ -401,6 +440,7 @@ RendererClientBase::CreatePrescientNetworking(
 
 void RendererClientBase::RunScriptsAtDocumentStart(
     content::RenderFrame* render_frame) {
+  startup_timeline::AddMark("document-start");
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   extensions_renderer_client_.get()->RunScriptsAtDocumentStart(render_frame);
 #endif
@@ -415,6 +455,7 @@ void RendererClientBase::RunScriptsAtDocumentIdle(
 
 void RendererClientBase::RunScriptsAtDocumentEnd(
     content::RenderFrame* render_frame) {
+  startup_timeline::AddMark("document-end");
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   extensions_renderer_client_.get()->RunScriptsAtDocumentEnd(render_frame);
 #endif
@@ -432,10 +473,50 @@ v8::Local<v8::Context> RendererClientBase::GetContext(
 v8::Local<v8::Value> RendererClientBase::RunScript(
     v8::Local<v8::Context> context,
     v8::Local<v8::String> source) {
-  auto maybe_script = v8::Script::Compile(context, source);
+  content::RenderFrame* render_frame = content::RenderFrame::FromWebFrame(
+      blink::WebLocalFrame::FrameForContext(context));
+  if (!render_frame) {
+    auto maybe_script = v8::Script::Compile(context, source);
+    v8::Local<v8::Script> script;
+    if (!maybe_script.ToLocal(&script))
+      return v8::Local<v8::Value>();
+    return script->Run(context).ToLocalChecked();
+  }
+
+  // Scripts run in a frame are compiled with the code cache the browser has
+  // stored for them, and produce a new one when there is none or V8 rejects
+  // it.
+  v8::Isolate* isolate = context->GetIsolate();
+  std::string key = GetCodeCacheKey(isolate, source);
+  mojom::ElectronBrowserPtr browser_ptr;
+  render_frame->GetRemoteInterfaces()->GetInterface(
+      mojo::MakeRequest(&browser_ptr));
+  mojo_base::BigBuffer cached_data;
+  browser_ptr->GetCodeCache(key, &cached_data);
+
+  v8::ScriptCompiler::CachedData* cache = nullptr;
+  auto options = v8::ScriptCompiler::kNoCompileOptions;
+  if (cached_data.size() > 0) {
+    cache = new v8::ScriptCompiler::CachedData(
+        cached_data.data(), static_cast<int>(cached_data.size()));
+    options = v8::ScriptCompiler::kConsumeCodeCache;
+  }
+  // |script_source| takes ownership of |cache|.
+  v8::ScriptCompiler::Source script_source(source, cache);
+  auto maybe_script =
+      v8::ScriptCompiler::Compile(context, &script_source, options);
   v8::Local<v8::Script> script;
   if (!maybe_script.ToLocal(&script))
     return v8::Local<v8::Value>();
+
+  if (!cache || script_source.GetCachedData()->rejected) {
+    base::ThreadTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE,
+        base::BindOnce(&ProduceCodeCache, isolate,
+                       v8::Global<v8::UnboundScript>(
+                           isolate, script->GetUnboundScript()),
+                       key, std::move(browser_ptr)));
+  }
   return script->Run(context).ToLocalChecked();
 }
 
@@ -8,7 +8,7 @@ import * as path from 'path'
 import { app, BrowserWindow, Menu, session } from 'electron'
 import { emittedOnce } from './events-helpers'
 import { closeWindow, closeAllWindows } from './window-helpers'
-import { ifdescribe } from './spec-helpers'
+import { ifdescribe, ifit } from './spec-helpers'
 import split = require('split')
 
 const features = process.electronBinding('features')
@@ -254,6 +254,32 @@ describe('app module', () => {
       expect(secondInstanceArgsReceived).to.eql(expected,
         `expected ${JSON.stringify(expected)} but got ${data2.toString('ascii')}`)
     })
+
+    const canHandOffEarly = process.platform === 'darwin' || (process.platform === 'linux' && !!process.env.XDG_RUNTIME_DIR)
+    ifit(canHandOffEarly)('hands the arguments over before the second instance starts with earlyHandoff', async () => {
+      const appPath = path.join(fixturesPath, 'api', 'singleton-early-handoff')
+      const first = cp.spawn(process.execPath, [appPath])
+      const firstExited = emittedOnce(first, 'exit')
+
+      const firstStdoutLines = first.stdout.pipe(split())
+      while ((await emittedOnce(firstStdoutLines, 'data')).toString() !== 'started') {
+        // wait.
+      }
+      const data2Promise = emittedOnce(firstStdoutLines, 'data')
+
+      // Started from the app directory, the relative app path must match the
+      // absolute one of the first instance.
+      const secondInstanceArgs = [process.execPath, '.', '--some-switch', 'some-arg']
+      const second = cp.spawn(secondInstanceArgs[0], secondInstanceArgs.slice(1), { cwd: appPath })
+      // The second instance exits from main() instead of running the app,
+      // which would exit with 1.
+      const [code2] = await emittedOnce(second, 'exit')
+      expect(code2).to.equal(0)
+      const [code1] = await firstExited
+      expect(code1).to.equal(0)
+      const data2 = (await data2Promise)[0].toString('ascii')
+      expect(JSON.parse(data2)).to.eql(secondInstanceArgs)
+    })
   })
 
   describe('app.relaunch', () => {
@@ -1016,7 +1042,7 @@ describe('app module', () => {
         expect(entry.memory).to.have.property('workingSetSize').that.is.greaterThan(0)
         expect(entry.memory).to.have.property('peakWorkingSetSize').that.is.greaterThan(0)
 
-        if (process.platform === 'win32') {
+        if (process.platform === 'win32' || process.platform === 'linux') {
           expect(entry.memory).to.have.property('privateBytes').that.is.greaterThan(0)
         }
 
@@ -1037,6 +1063,105 @@ describe('app module', () => {
     })
   })
 
+  describe('startMetricsSampling() API', () => {
+    afterEach(() => {
+      app.stopMetricsSampling()
+    })
+
+    it('keeps a bounded history of samples for each process', async () => {
+      app.startMetricsSampling({ interval: 100, historySize: 3 })
+      await new Promise(resolve => setTimeout(resolve, 1000))
+
+      const latest = app.getLatestMetrics()
+      const browser = latest.find(sample => sample.type === 'Browser')!
+      expect(browser).to.have.property('pid', process.pid)
+      expect(browser.timestamp).to.be.a('number').that.is.greaterThan(0)
+      expect(browser.cpu).to.have.ownProperty('percentCPUUsage').that.is.a('number')
+      expect(browser.memory).to.have.property('workingSetSize').that.is.greaterThan(0)
+
+      const history = app.getMetricsHistory(process.pid)
+      expect(history).to.have.lengthOf(3)
+      expect(history[0].timestamp).to.be.at.most(history[2].timestamp)
+      expect(history[2]).to.deep.equal(browser)
+    })
+
+    it('emits process-metrics-threshold when a metric goes above its threshold', async () => {
+      app.startMetricsSampling({ interval: 100, thresholds: { workingSetSize: 1 } })
+      const [, sample, metric, value, threshold] = await emittedOnce(app, 'process-metrics-threshold')
+      expect(sample.pid).to.be.above(0)
+      expect(metric).to.equal('workingSetSize')
+      expect(value).to.be.greaterThan(threshold)
+      expect(threshold).to.equal(1)
+    })
+
+    it('throws on unknown metrics', () => {
+      expect(() => {
+        app.startMetricsSampling({ thresholds: { unknownMetric: 1 } })
+      }).to.throw(/Unsupported metric: unknownMetric/)
+    })
+
+    it('returns no samples once stopped', () => {
+      app.startMetricsSampling()
+      app.stopMetricsSampling()
+      expect(app.getLatestMetrics()).to.be.an('array').that.is.empty()
+      expect(app.getMetricsHistory(process.pid)).to.be.an('array').that.is.empty()
+    })
+  })
+
+  describe('getMainThreadMetrics() API', () => {
+    afterEach(() => {
+      app.setLongTaskThreshold(50)
+    })
+
+    it('records the durations of the main thread tasks', async () => {
+      app.resetMainThreadMetrics()
+      await new Promise(resolve => setTimeout(resolve, 10))
+
+      const metrics = app.getMainThreadMetrics()
+      expect(metrics.taskDuration.count).to.be.greaterThan(0)
+      expect(metrics.queueingDelay.count).to.be.greaterThan(0)
+      expect(metrics.taskDuration.buckets[0]).to.have.property('lowerBound', 0)
+      const bucketsCount = metrics.taskDuration.buckets.reduce((sum, bucket) => sum + bucket.count, 0)
+      expect(bucketsCount).to.equal(metrics.taskDuration.count)
+      expect(metrics.longTaskThreshold).to.equal(50)
+    })
+
+    it('emits long-task for tasks over the threshold', async () => {
+      app.setLongTaskThreshold(20)
+      app.resetMainThreadMetrics()
+      setTimeout(() => {
+        const end = Date.now() + 30
+        while (Date.now() < end);
+      })
+      const [, task] = await emittedOnce(app, 'long-task')
+      expect(task.duration).to.be.at.least(20)
+      expect(task.startTime).to.be.a('number').that.is.greaterThan(0)
+      expect(task.postedFrom).to.be.an('object')
+      expect(app.getMainThreadMetrics().longTasks).to.deep.include(task)
+    })
+
+    it('does not report slow long-task listeners as long tasks', async () => {
+      app.setLongTaskThreshold(20)
+      app.resetMainThreadMetrics()
+      const busyWait = () => {
+        const end = Date.now() + 30
+        while (Date.now() < end);
+      }
+      app.once('long-task', busyWait)
+      setTimeout(busyWait)
+      await emittedOnce(app, 'long-task')
+      await new Promise(resolve => setTimeout(resolve, 100))
+      const { longTasks } = app.getMainThreadMetrics()
+      expect(longTasks).to.have.lengthOf(1)
+    })
+
+    it('throws on thresholds under 1 millisecond', () => {
+      expect(() => {
+        app.setLongTaskThreshold(0)
+      }).to.throw(/threshold must be at least 1 millisecond/)
+    })
+  })
+
   describe('getGPUFeatureStatus() API', () => {
     it('returns the graphic features statuses', () => {
       const features = app.getGPUFeatureStatus()
@@ -8,7 +8,7 @@ import { AddressInfo } from 'net'
 import { app, BrowserWindow, BrowserView, ipcMain, OnBeforeSendHeadersListenerDetails, protocol, screen, webContents, session, WebContents } from 'electron'
 
 import { emittedOnce } from './events-helpers'
-import { ifit, ifdescribe } from './spec-helpers'
+import { ifit, ifdescribe, delay } from './spec-helpers'
 import { closeWindow, closeAllWindows } from './window-helpers'
 
 const fixtures = path.resolve(__dirname, '..', 'spec', 'fixtures')
@@ -1084,6 +1084,46 @@ describe('BrowserWindow module', () => {
       // Values can be 0,2,3,4, or 6. We want 6, which is RGB + Alpha
       expect(imgBuffer[25]).to.equal(6)
     })
+
+    it('resolves with encoded data when a format is given', async () => {
+      const w = new BrowserWindow({ show: false, width: 200, height: 200 })
+      w.loadURL('data:text/html,<body style="background:red"></body>')
+      await emittedOnce(w, 'ready-to-show')
+      w.show()
+
+      const png = await w.capturePage(undefined, { format: 'png' }) as Buffer
+      expect(png).to.be.an.instanceOf(Buffer)
+      expect(png.slice(1, 4).toString()).to.equal('PNG')
+
+      const jpeg = await w.capturePage({ x: 0, y: 0, width: 100, height: 100 }, { format: 'jpeg', quality: 50 }) as Buffer
+      expect(jpeg.slice(0, 2).equals(Buffer.from([0xff, 0xd8]))).to.be.true()
+
+      const webp = await w.capturePage(undefined, { format: 'webp' }) as Buffer
+      expect(webp.slice(8, 12).toString()).to.equal('WEBP')
+    })
+
+    it('captures in tiles', async () => {
+      const w = new BrowserWindow({ show: false, width: 200, height: 200 })
+      w.loadURL('data:text/html,<body style="background:red"></body>')
+      await emittedOnce(w, 'ready-to-show')
+      w.show()
+
+      const tiles = await w.capturePage({ x: 0, y: 0, width: 100, height: 100 }, { format: 'png', tileHeight: 40 }) as Electron.CapturedTile[]
+      expect(tiles.map(tile => tile.rect)).to.deep.equal([
+        { x: 0, y: 0, width: 100, height: 40 },
+        { x: 0, y: 40, width: 100, height: 40 },
+        { x: 0, y: 80, width: 100, height: 20 }
+      ])
+      for (const tile of tiles) {
+        expect(tile.data.slice(1, 4).toString()).to.equal('PNG')
+      }
+    })
+
+    it('rejects invalid capture options', async () => {
+      const w = new BrowserWindow({ show: false })
+      await expect(w.capturePage(undefined, { format: 'gif' } as any)).to.eventually.be.rejectedWith(/Invalid format/)
+      await expect(w.capturePage(undefined, { format: 'png', tileHeight: -1 })).to.eventually.be.rejectedWith(/tileHeight/)
+    })
   })
 
   describe('BrowserWindow.setProgressBar(progress)', () => {
@@ -1863,6 +1903,35 @@ describe('BrowserWindow module', () => {
         expect(test).to.equal('preload')
       })
 
+      it('runs the preload script from the code cache', async () => {
+        const getStats = () => (process as any).electronBinding('web_contents')._getCodeCacheStats()
+        const runPreload = async () => {
+          const w = new BrowserWindow({
+            show: false,
+            webPreferences: {
+              sandbox: true,
+              preload
+            }
+          })
+          w.loadFile(path.join(fixtures, 'api', 'preload.html'))
+          const [, test] = await emittedOnce(ipcMain, 'answer')
+          expect(test).to.equal('preload')
+          // The renderer sends its data after the task that ran the preload.
+          await w.webContents.executeJavaScript('0')
+          await delay(100)
+          await closeWindow(w)
+        }
+
+        // Either stores an entry for the preload or hits one from an earlier
+        // run, so the next window is always a hit.
+        await runPreload()
+        const before = getStats()
+        await runPreload()
+        const after = getStats()
+        expect(after.hits).to.be.greaterThan(before.hits)
+        expect(after.rejected).to.equal(before.rejected)
+      })
+
       it('exposes ipcRenderer to preload script (path has special chars)', async () => {
         const preloadSpecialChars = path.join(fixtures, 'module', 'preload-sandboxæø åü.js')
         const w = new BrowserWindow({
@@ -2,6 +2,7 @@ import { expect } from 'chai'
 import { app, contentTracing, TraceConfig, TraceCategoriesAndOptions } from 'electron'
 import * as fs from 'fs'
 import * as path from 'path'
+import * as zlib from 'zlib'
 import { ifdescribe } from './spec-helpers'
 
 const timeout = async (milliseconds: number) => {
@@ -126,4 +127,49 @@ ifdescribe(!(process.platform === 'linux' && ['arm', 'arm64'].includes(process.a
       expect(resultFilePath).to.be.a('string').that.is.not.empty('result path')
     })
   })
+
+  describe('streamRecording', function () {
+    this.timeout(5e3)
+
+    const ringBuffer = { categoryFilter: '*', traceOptions: 'record-continuously' }
+
+    it('delivers the trace data in chunks', async () => {
+      await app.whenReady()
+      await contentTracing.startRecording(ringBuffer)
+      await timeout(10)
+
+      const chunks: Buffer[] = []
+      await contentTracing.streamRecording({ onChunk: (chunk) => chunks.push(chunk) })
+      expect(chunks).to.not.be.empty()
+      expect(chunks.every(chunk => Buffer.isBuffer(chunk))).to.be.true('chunks are buffers')
+      const trace = JSON.parse(Buffer.concat(chunks).toString())
+      expect(trace.traceEvents).to.be.an('array')
+    })
+
+    it('writes compressed trace data to a file', async () => {
+      await app.whenReady()
+      await contentTracing.startRecording(ringBuffer)
+      await timeout(10)
+
+      await contentTracing.streamRecording({ resultFilePath: outputFilePath, compress: true })
+      const trace = JSON.parse(zlib.gunzipSync(fs.readFileSync(outputFilePath)).toString())
+      expect(trace.traceEvents).to.be.an('array')
+    })
+
+    it('keeps recording when restart is set', async () => {
+      await app.whenReady()
+      await contentTracing.startRecording(ringBuffer)
+      await timeout(10)
+
+      await contentTracing.streamRecording({ onChunk: () => {}, restart: true })
+      await timeout(10)
+      const resultFilePath = await contentTracing.stopRecording(outputFilePath)
+      expect(fs.statSync(resultFilePath).size).to.be.above(0)
+    })
+
+    it('rejects when nothing is being recorded', async () => {
+      await app.whenReady()
+      await expect(contentTracing.streamRecording({ onChunk: () => {} })).to.eventually.be.rejectedWith(/not being recorded/)
+    })
+  })
 })
@@ -10,6 +10,7 @@ import * as url from 'url'
 import { ipcMain, app, BrowserWindow, crashReporter, BrowserWindowConstructorOptions } from 'electron'
 import { AddressInfo } from 'net'
 import { closeWindow, closeAllWindows } from './window-helpers'
+import { emittedOnce } from './events-helpers'
 import { EventEmitter } from 'events'
 
 temp.track()
@@ -347,6 +348,53 @@ ifdescribe(!process.mas && !process.env.DISABLE_CRASH_REPORTER_TESTS && process.
   })
 })
 
+ifdescribe(!process.env.DISABLE_CRASH_REPORTER_TESTS && process.platform === 'linux')('crashReporter pipeline', function () {
+  this.timeout(60000)
+  const fixtures = path.resolve(__dirname, '..', 'spec', 'fixtures')
+
+  after(() => {
+    try {
+      temp.cleanupSync()
+    } catch (e) {
+      // ignore.
+      console.warn(e.stack)
+    }
+  })
+
+  it('throws on invalid pipeline options', () => {
+    const start = (pipeline: any) => () => crashReporter.start({
+      companyName: 'Umbrella Corporation',
+      submitURL: 'http://127.0.0.1:1',
+      pipeline
+    } as any)
+    expect(start({ uploadInterval: 0 })).to.throw(/uploadInterval must be a number of at least 1/)
+    expect(start({ batchSize: 0 })).to.throw(/batchSize must be an integer of at least 1/)
+    expect(start({ maxReportsPerSignature: -1 })).to.throw(/maxReportsPerSignature must be an integer of at least 0/)
+  })
+
+  it('groups crashes by signature and rate limits their reports', async () => {
+    const exportDir = temp.mkdirSync('electronCrashPipelineSpec-')
+    const appPath = path.join(fixtures, 'api', 'crash-pipeline')
+    const appProcess = childProcess.spawn(process.execPath, [appPath, exportDir])
+    let output = ''
+    appProcess.stdout.on('data', (data) => { output += data })
+    const [code] = await emittedOnce(appProcess, 'exit')
+    expect(code).to.equal(0)
+
+    const signatures = JSON.parse(output.trim().split('\n').pop()!)
+    expect(signatures).to.be.an('array').with.lengthOf(1)
+    const [signature] = signatures
+    expect(signature.processType).to.equal('renderer')
+    expect(signature.reason).to.be.a('string').that.is.not.empty()
+    expect(signature.count).to.equal(2)
+    expect(signature.uploadedCount).to.equal(1)
+    expect(signature.droppedCount).to.equal(1)
+
+    const exported = fs.readdirSync(exportDir).filter(name => name.endsWith('.dmp.gz'))
+    expect(exported).to.have.lengthOf(1)
+  })
+})
+
 type CrashInfo = {
   prod: string
   ver: string
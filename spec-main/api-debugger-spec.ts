@@ -159,6 +159,62 @@ describe('debugger module', () => {
       w.webContents.debugger.sendCommand('Console.enable')
     })
 
+    describe('debugger.setMessageOptions', () => {
+      it('only emits the events of the given methods', async () => {
+        w.webContents.loadURL('about:blank')
+        w.webContents.debugger.attach()
+        w.webContents.debugger.setMessageOptions({ methods: ['Runtime.consoleAPICalled'] })
+
+        const methods: string[] = []
+        w.webContents.debugger.on('message', (event, method) => { methods.push(method) })
+        await w.webContents.debugger.sendCommand('Runtime.enable')
+        const called = emittedOnce(w.webContents.debugger, 'message')
+        await w.webContents.debugger.sendCommand('Runtime.evaluate', { expression: 'console.log("a")' })
+        const [, method, params] = await called
+        expect(method).to.equal('Runtime.consoleAPICalled')
+        expect(params.args[0].value).to.equal('a')
+        expect(methods).to.not.include('Runtime.executionContextCreated')
+
+        w.webContents.debugger.detach()
+      })
+
+      it('emits raw-message with the message as JSON', async () => {
+        w.webContents.loadURL('about:blank')
+        w.webContents.debugger.attach()
+        w.webContents.debugger.setMessageOptions({ methods: ['Runtime.*'], format: 'json' })
+
+        const called = emittedOnce(w.webContents.debugger, 'raw-message')
+        await w.webContents.debugger.sendCommand('Runtime.enable')
+        await w.webContents.debugger.sendCommand('Runtime.evaluate', { expression: 'console.log("a")' })
+        const [, method, message] = await called
+        expect(method).to.match(/^Runtime\./)
+        expect(message).to.be.a('string')
+        expect(JSON.parse(message).method).to.equal(method)
+
+        w.webContents.debugger.detach()
+      })
+
+      it('emits raw-message with the message as a Buffer', async () => {
+        w.webContents.loadURL('about:blank')
+        w.webContents.debugger.attach()
+        w.webContents.debugger.setMessageOptions({ format: 'buffer' })
+
+        const called = emittedOnce(w.webContents.debugger, 'raw-message')
+        await w.webContents.debugger.sendCommand('Runtime.enable')
+        const [, method, message] = await called
+        expect(Buffer.isBuffer(message)).to.equal(true)
+        expect(JSON.parse(message.toString()).method).to.equal(method)
+
+        w.webContents.debugger.detach()
+      })
+
+      it('throws for an unknown format', () => {
+        expect(() => {
+          w.webContents.debugger.setMessageOptions({ format: 'xml' as any })
+        }).to.throw(/format must be/)
+      })
+    })
+
     it('returns error message when command fails', async () => {
       w.webContents.loadURL('about:blank')
       w.webContents.debugger.attach()
@@ -1,7 +1,11 @@
 import { expect } from 'chai'
 import { net, session, ClientRequest, BrowserWindow } from 'electron'
+import * as fs from 'fs'
 import * as http from 'http'
+import * as os from 'os'
+import * as path from 'path'
 import * as url from 'url'
+import { MessageChannel } from 'worker_threads'
 import { AddressInfo, Socket } from 'net'
 import { emittedOnce } from './events-helpers'
 
@@ -1410,6 +1414,104 @@ describe('net module', () => {
     })
   })
 
+  describe('Response body streaming', () => {
+    it('coalesces the body into chunks of chunkSize', async () => {
+      const body = randomBuffer(kOneMegaByte)
+      const serverUrl = await respondOnce.toSingleURL((request, response) => {
+        for (let i = 0; i < body.length; i += kOneKiloByte) {
+          response.write(body.slice(i, i + kOneKiloByte))
+        }
+        response.end()
+      })
+      const chunkSize = 100 * kOneKiloByte
+      const urlRequest = net.request({ url: serverUrl, chunkSize })
+      urlRequest.end()
+      const [response] = await emittedOnce(urlRequest, 'response')
+      const chunks: Buffer[] = []
+      response.on('data', (chunk: Buffer) => chunks.push(chunk))
+      await emittedOnce(response, 'end')
+      for (const chunk of chunks.slice(0, -1)) {
+        expect(chunk.length).to.equal(chunkSize)
+      }
+      expect(Buffer.concat(chunks).equals(body)).to.equal(true)
+    })
+
+    it('grows chunks instead of allocating a large chunkSize up front', async () => {
+      const body = randomBuffer(3 * kOneMegaByte)
+      const serverUrl = await respondOnce.toSingleURL((request, response) => {
+        response.end(body)
+      })
+      const urlRequest = net.request({ url: serverUrl, chunkSize: 64 * kOneMegaByte })
+      urlRequest.end()
+      const [response] = await emittedOnce(urlRequest, 'response')
+      const chunks: Buffer[] = []
+      response.on('data', (chunk: Buffer) => chunks.push(chunk))
+      await emittedOnce(response, 'end')
+      expect(chunks).to.have.lengthOf(1)
+      expect(chunks[0].equals(body)).to.equal(true)
+    })
+
+    it('keeps the body intact when JS transfers the chunk memory', async () => {
+      const body = randomBuffer(kOneMegaByte)
+      const serverUrl = await respondOnce.toSingleURL((request, response) => {
+        for (let i = 0; i < body.length; i += kOneKiloByte) {
+          response.write(body.slice(i, i + kOneKiloByte))
+        }
+        response.end()
+      })
+      const urlRequest = net.request(serverUrl)
+      urlRequest.end()
+      const [response] = await emittedOnce(urlRequest, 'response')
+      const { port1 } = new MessageChannel()
+      const copies: Buffer[] = []
+      response.on('data', (chunk: Buffer) => {
+        copies.push(Buffer.from(chunk))
+        // Detaches the shared buffer the next chunks would otherwise be written to.
+        port1.postMessage(chunk.buffer, [chunk.buffer])
+      })
+      await emittedOnce(response, 'end')
+      port1.close()
+      expect(Buffer.concat(copies).equals(body)).to.equal(true)
+    })
+
+    it('rejects an invalid chunkSize', () => {
+      expect(() => net.request({ url: 'http://127.0.0.1', chunkSize: -1 })).to.throw(/chunkSize/)
+    })
+
+    it('stops reading the body while the response is paused', async () => {
+      const serverUrl = await respondOnce.toSingleURL((request, response) => {
+        response.end(randomBuffer(32 * kOneMegaByte))
+      })
+      const urlRequest = net.request(serverUrl)
+      urlRequest.end()
+      const [response] = await emittedOnce(urlRequest, 'response')
+      let received = 0
+      response.on('download-progress', (current: number) => { received = current })
+      await emittedOnce(response, 'readable')
+      await new Promise(resolve => setTimeout(resolve, 500))
+      expect(received).to.be.below(32 * kOneMegaByte)
+      response.resume()
+      await emittedOnce(response, 'end')
+    })
+
+    it('writes the body to downloadPath without emitting data', async () => {
+      const body = randomBuffer(kOneMegaByte)
+      const serverUrl = await respondOnce.toSingleURL((request, response) => {
+        response.end(body)
+      })
+      const downloadPath = path.join(os.tmpdir(), `electron-net-spec-${Date.now()}`)
+      cleanupTasks.push(() => fs.unlinkSync(downloadPath))
+      const urlRequest = net.request({ url: serverUrl, downloadPath })
+      urlRequest.end()
+      const [response] = await emittedOnce(urlRequest, 'response')
+      let dataEmitted = false
+      response.on('data', () => { dataEmitted = true })
+      await emittedOnce(response, 'end')
+      expect(dataEmitted).to.equal(false)
+      expect(fs.readFileSync(downloadPath).equals(body)).to.equal(true)
+    })
+  })
+
   describe('Stability and performance', () => {
     it('should free unreferenced, never-started request objects without crash', (done) => {
       net.request('https://test')
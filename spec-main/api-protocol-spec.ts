@@ -124,6 +124,178 @@ describe('protocol module', () => {
     })
   })
 
+  describe('protocol.registerStaticProtocol', () => {
+    const normalPath = path.join(fixturesPath, 'pages', 'a.html')
+    const normalContent = fs.readFileSync(normalPath)
+    const asarContent = fs.readFileSync(path.join(fixturesPath, 'test.asar', 'a.asar', 'file1'))
+
+    it('serves files below root', async () => {
+      expect(protocol.registerStaticProtocol(protocolName, { root: fixturesPath })).to.be.true('registered')
+      const r = await ajax(protocolName + '://pages/a.html')
+      expect(r.data).to.equal(String(normalContent))
+      expect(r.headers).to.include('access-control-allow-origin: *')
+    })
+
+    it('serves files inside asar archives', async () => {
+      protocol.registerStaticProtocol(protocolName, { root: path.join(fixturesPath, 'test.asar') })
+      const r = await ajax(protocolName + '://a.asar/file1')
+      expect(r.data).to.equal(String(asarContent))
+    })
+
+    it('applies rewrites and custom headers', async () => {
+      protocol.registerStaticProtocol(protocolName, {
+        root: fixturesPath,
+        rewrites: { '//fake-host/': '/pages/a.html' },
+        headers: { 'X-Great-Header': 'sogreat' }
+      })
+      const r = await ajax(protocolName + '://fake-host/')
+      expect(r.data).to.equal(String(normalContent))
+      expect(r.headers).to.include('x-great-header: sogreat')
+    })
+
+    it('refuses paths outside of root', async () => {
+      protocol.registerStaticProtocol(protocolName, { root: path.join(fixturesPath, 'pages') })
+      await expect(ajax(protocolName + '://fake-host/%2e%2e/%2e%2e/pages/a.html')).to.be.eventually.rejectedWith(Error, '404')
+    })
+
+    it('fails when the scheme is already registered', async () => {
+      await registerStringProtocol(protocolName, (req, cb) => cb())
+      expect(protocol.registerStaticProtocol(protocolName, { root: fixturesPath })).to.be.false('registered')
+    })
+
+    it('throws when root is not absolute', () => {
+      expect(() => protocol.registerStaticProtocol(protocolName, { root: 'relative' })).to.throw(/absolute path/)
+    })
+  })
+
+  describe('protocol.enableResponseCache', () => {
+    it('serves repeated requests without calling the handler', async () => {
+      let calls = 0
+      await registerBufferProtocol(protocolName, (request, callback) => {
+        calls++
+        callback({ mimeType: 'text/plain', data: Buffer.from(text) })
+      })
+      expect(protocol.enableResponseCache(protocolName)).to.be.true('enabled')
+      expect((await ajax(protocolName + '://fake-host')).data).to.equal(text)
+      expect((await ajax(protocolName + '://fake-host')).data).to.equal(text)
+      expect(calls).to.equal(1)
+      expect(protocol.getResponseCacheInfo(protocolName)).to.deep.include({ entries: 1, hits: 1, misses: 1 })
+    })
+
+    it('applies to pages that are already loaded', async () => {
+      let calls = 0
+      await registerBufferProtocol(protocolName, (request, callback) => {
+        calls++
+        callback({ mimeType: 'text/plain', data: Buffer.from(text) })
+      })
+      await contents.loadFile(path.join(__dirname, 'fixtures', 'pages', 'jquery.html'))
+      protocol.enableResponseCache(protocolName)
+      for (let i = 0; i < 2; i++) {
+        const { data } = await contents.executeJavaScript(`ajax("${protocolName}://fake-host")`)
+        expect(data).to.equal(text)
+      }
+      expect(calls).to.equal(1)
+    })
+
+    it('keys responses by the vary headers', async () => {
+      let calls = 0
+      await registerStringProtocol(protocolName, (request, callback) => {
+        calls++
+        callback(request.headers['X-Lang'])
+      })
+      protocol.enableResponseCache(protocolName, { varyHeaders: ['X-Lang'] })
+      expect((await ajax(protocolName + '://fake-host', { headers: { 'X-Lang': 'en' } })).data).to.equal('en')
+      expect((await ajax(protocolName + '://fake-host', { headers: { 'X-Lang': 'fr' } })).data).to.equal('fr')
+      expect((await ajax(protocolName + '://fake-host', { headers: { 'X-Lang': 'en' } })).data).to.equal('en')
+      expect(calls).to.equal(2)
+    })
+
+    it('honors Cache-Control: no-store', async () => {
+      let calls = 0
+      await registerStringProtocol(protocolName, (request, callback) => {
+        calls++
+        callback({ data: text, headers: { 'Cache-Control': 'no-store' } })
+      })
+      protocol.enableResponseCache(protocolName)
+      await ajax(protocolName + '://fake-host')
+      await ajax(protocolName + '://fake-host')
+      expect(calls).to.equal(2)
+      expect(protocol.getResponseCacheInfo(protocolName)).to.deep.include({ entries: 0 })
+    })
+
+    it('caches the path of file responses', async () => {
+      const filePath = path.join(fixturesPath, 'pages', 'a.html')
+      let calls = 0
+      await registerFileProtocol(protocolName, (request, callback) => {
+        calls++
+        callback(filePath)
+      })
+      protocol.enableResponseCache(protocolName)
+      await ajax(protocolName + '://fake-host')
+      // The path is stored once the file has been opened in the background.
+      while (protocol.getResponseCacheInfo(protocolName)!.entries === 0) {
+        await new Promise(resolve => setTimeout(resolve, 10))
+      }
+      const r = await ajax(protocolName + '://fake-host')
+      expect(r.data).to.equal(String(fs.readFileSync(filePath)))
+      expect(calls).to.equal(1)
+    })
+
+    it('does not cache the path of missing files', async () => {
+      let calls = 0
+      await registerFileProtocol(protocolName, (request, callback) => {
+        calls++
+        callback(path.join(fixturesPath, 'does-not-exist.html'))
+      })
+      protocol.enableResponseCache(protocolName)
+      await expect(ajax(protocolName + '://fake-host')).to.be.eventually.rejected()
+      await new Promise(resolve => setTimeout(resolve, 100))
+      await expect(ajax(protocolName + '://fake-host')).to.be.eventually.rejected()
+      expect(calls).to.equal(2)
+      expect(protocol.getResponseCacheInfo(protocolName)!.entries).to.equal(0)
+    })
+
+    it('evicts entries beyond maxSize', async () => {
+      await registerBufferProtocol(protocolName, (request, callback) => {
+        callback(Buffer.alloc(1024, 'a'))
+      })
+      protocol.enableResponseCache(protocolName, { maxSize: 2048 })
+      for (let i = 0; i < 4; i++) await ajax(`${protocolName}://fake-host/${i}`)
+      const info = protocol.getResponseCacheInfo(protocolName)!
+      expect(info.entries).to.equal(1)
+      expect(info.size).to.be.at.most(2048)
+    })
+
+    it('can be invalidated', async () => {
+      let calls = 0
+      await registerStringProtocol(protocolName, (request, callback) => {
+        calls++
+        callback(text)
+      })
+      protocol.enableResponseCache(protocolName)
+      await ajax(protocolName + '://fake-host/a')
+      await ajax(protocolName + '://fake-host/b')
+      expect(protocol.invalidateResponseCache(protocolName, protocolName + '://fake-host/a')).to.be.true('invalidated')
+      expect(protocol.getResponseCacheInfo(protocolName)).to.deep.include({ entries: 1 })
+      await ajax(protocolName + '://fake-host/a')
+      expect(calls).to.equal(3)
+      protocol.invalidateResponseCache(protocolName)
+      expect(protocol.getResponseCacheInfo(protocolName)).to.deep.include({ entries: 0 })
+    })
+
+    it('is disabled when the protocol is unregistered', async () => {
+      await registerStringProtocol(protocolName, (request, callback) => callback(text))
+      expect(protocol.enableResponseCache(protocolName)).to.be.true('enabled')
+      await unregisterProtocol(protocolName)
+      expect(protocol.getResponseCacheInfo(protocolName)).to.be.null('cache info')
+      expect(protocol.disableResponseCache(protocolName)).to.be.false('disabled')
+    })
+
+    it('fails for schemes without a handler', () => {
+      expect(protocol.enableResponseCache('not-exist')).to.be.false('enabled')
+    })
+  })
+
   describe('protocol.unregisterProtocol', () => {
     it('returns error when scheme does not exist', async () => {
       await expect(unregisterProtocol('not-exist')).to.be.eventually.rejectedWith(Error)
@@ -155,6 +327,13 @@ describe('protocol module', () => {
       expect(r.data).to.equal(text)
     })
 
+    it('sends large external string as response', async () => {
+      const large = Buffer.alloc(4 * 1024 * 1024, 'a').toString('latin1')
+      await registerStringProtocol(protocolName, (request, callback) => callback(large))
+      const r = await ajax(protocolName + '://fake-host')
+      expect(r.data).to.equal(large)
+    })
+
     it('fails when sending object other than string', async () => {
       const notAString = () => {}
       await registerStringProtocol(protocolName, (request, callback) => callback(notAString as any))
@@ -188,10 +367,33 @@ describe('protocol module', () => {
       expect(r.data).to.equal(text)
     })
 
+    it('sends array of Buffers as response', async () => {
+      await registerBufferProtocol(protocolName, (request, callback) => {
+        callback({
+          data: [buffer.slice(0, 5), Buffer.alloc(0), buffer.slice(5)] as any,
+          mimeType: 'text/html'
+        })
+      })
+      const r = await ajax(protocolName + '://fake-host')
+      expect(r.data).to.equal(text)
+    })
+
+    it('sends large Buffer as response', async () => {
+      const large = Buffer.alloc(16 * 1024 * 1024, 'a')
+      await registerBufferProtocol(protocolName, (request, callback) => callback(large))
+      const r = await ajax(protocolName + '://fake-host')
+      expect(r.data.length).to.equal(large.length)
+    })
+
     it('fails when sending string', async () => {
       await registerBufferProtocol(protocolName, (request, callback) => callback(text as any))
       await expect(ajax(protocolName + '://fake-host')).to.be.eventually.rejectedWith(Error, '404')
     })
+
+    it('fails when array contains non-Buffer', async () => {
+      await registerBufferProtocol(protocolName, (request, callback) => callback([buffer, text] as any))
+      await expect(ajax(protocolName + '://fake-host')).to.be.eventually.rejectedWith(Error, '404')
+    })
   })
 
   describe('protocol.registerFileProtocol', () => {
@@ -9,6 +9,7 @@ import * as send from 'send'
 import * as auth from 'basic-auth'
 import { closeAllWindows } from './window-helpers'
 import { emittedOnce } from './events-helpers'
+import { delay } from './spec-helpers'
 import { AddressInfo } from 'net'
 
 /* The whole session API doesn't use standard callbacks */
@@ -126,6 +127,40 @@ describe('session module', () => {
       expect(cs.some(c => c.name === name && c.value === value)).to.equal(true)
     })
 
+    describe('ses.cookies.query()', () => {
+      it('returns the matching cookies in pages', async () => {
+        const { cookies } = session.defaultSession
+        for (const name of ['c', 'a', 'b']) {
+          await cookies.set({ url, name, value: name })
+        }
+
+        const first = await cookies.query({ domain: '127.0.0.1' }, { limit: 2 })
+        expect(first.total).to.equal(3)
+        expect(first.cookies.map((c: any) => c.name)).to.deep.equal(['a', 'b'])
+        const second = await cookies.query({ domain: '127.0.0.1' }, { offset: 2, limit: 2 })
+        expect(second.total).to.equal(3)
+        expect(second.cookies.map((c: any) => c.name)).to.deep.equal(['c'])
+      })
+
+      it('returns compact rows', async () => {
+        const { cookies } = session.defaultSession
+        await cookies.set({ url, name: 'compact', value: 'value' })
+
+        const result = await cookies.query({ url, name: 'compact' }, { format: 'compact' })
+        expect(result.total).to.equal(1)
+        const row = result.cookies[0]
+        expect(row[result.fields.indexOf('name')]).to.equal('compact')
+        expect(row[result.fields.indexOf('value')]).to.equal('value')
+        expect(row[result.fields.indexOf('session')]).to.equal(true)
+        expect(row[result.fields.indexOf('expirationDate')]).to.equal(null)
+      })
+
+      it('rejects an invalid format', async () => {
+        const { cookies } = session.defaultSession
+        await expect(cookies.query({}, { format: 'table' as any })).to.eventually.be.rejectedWith(/format must be/)
+      })
+    })
+
     it('yields an error when setting a cookie with missing required fields', async () => {
       const { cookies } = session.defaultSession
       const name = '1'
@@ -209,6 +244,52 @@ describe('session module', () => {
       expect(removeEventRemoved).to.equal(true)
     })
 
+    describe('ses.cookies.subscribeChanges()', () => {
+      it('delivers the changes of a time window in one batch', async () => {
+        const { cookies } = session.defaultSession
+        const batches: any[][] = []
+        const id = cookies.subscribeChanges({ delay: 50 }, (changes: any[]) => batches.push(changes))
+        try {
+          await Promise.all(['a', 'b', 'c'].map(name => cookies.set({ url, name, value: name })))
+          await delay(200)
+        } finally {
+          cookies.unsubscribeChanges(id)
+        }
+        expect(batches).to.have.lengthOf(1)
+        const added = batches[0].filter(c => !c.removed)
+        expect(added.map(c => c.cookie.name).sort()).to.deep.equal(['a', 'b', 'c'])
+        expect(added.every(c => c.cause === 'explicit')).to.equal(true)
+      })
+
+      it('drops changes of other domains', async () => {
+        const { cookies } = session.defaultSession
+        const changes: any[] = []
+        const id = cookies.subscribeChanges({ domains: ['example.com'], delay: 10 }, (batch: any[]) => changes.push(...batch))
+        try {
+          await cookies.set({ url, name: 'other', value: '1' })
+          await delay(100)
+        } finally {
+          cookies.unsubscribeChanges(id)
+        }
+        expect(changes).to.be.empty()
+      })
+
+      it('delivers changes of the subscribed domains', async () => {
+        const { cookies } = session.defaultSession
+        const changes: any[] = []
+        const id = cookies.subscribeChanges({ domains: ['127.0.0.1'], delay: 10 }, (batch: any[]) => changes.push(...batch))
+        try {
+          await cookies.set({ url, name: 'matching', value: '1' })
+          await delay(100)
+        } finally {
+          cookies.unsubscribeChanges(id)
+        }
+        const added = changes.filter(c => !c.removed)
+        expect(added.map(c => c.cookie.name)).to.deep.equal(['matching'])
+        expect(added[0].cookie.domain).to.equal('127.0.0.1')
+      })
+    })
+
     describe('ses.cookies.flushStore()', async () => {
       it('flushes the cookies to disk', async () => {
         const name = 'foo'
@@ -340,6 +421,72 @@ describe('session module', () => {
     })
   })
 
+  describe('ses.setSpareRendererPool(options)', () => {
+    const ses = session.fromPartition('spare-renderer-pool')
+    afterEach(closeAllWindows)
+    afterEach(() => {
+      ses.setSpareRendererPool({ size: 0 })
+    })
+
+    it('gives spare renderers to windows with the same preferences', async () => {
+      const webPreferences = { nodeIntegration: true }
+      ses.setSpareRendererPool({ size: 1, webPreferences })
+      await delay(500)
+
+      const w = new BrowserWindow({ show: false, webPreferences: { ...webPreferences, session: ses } })
+      await w.loadURL('about:blank')
+      expect(await w.webContents.executeJavaScript('typeof require')).to.equal('function')
+    })
+
+    it('does not give spare renderers to windows with other preferences', async () => {
+      ses.setSpareRendererPool({ size: 1, webPreferences: { nodeIntegration: true } })
+      await delay(500)
+
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: false, session: ses } })
+      await w.loadURL('about:blank')
+      expect(await w.webContents.executeJavaScript('typeof require')).to.equal('undefined')
+    })
+
+    it('keeps the spare renderer for the first navigation', async () => {
+      const webPreferences = { nodeIntegration: true }
+      ses.setSpareRendererPool({ size: 1, webPreferences })
+      await delay(500)
+
+      const w = new BrowserWindow({ show: false, webPreferences: { ...webPreferences, session: ses } })
+      const spareProcessId = w.webContents.getProcessId()
+      await w.loadURL('about:blank')
+      expect(w.webContents.getProcessId()).to.equal(spareProcessId)
+    })
+
+    it('still swaps renderers on cross-site navigations', async () => {
+      const server = http.createServer((req, res) => { res.end() })
+      await new Promise(resolve => server.listen(0, '127.0.0.1', resolve))
+      const { port } = server.address() as AddressInfo
+      try {
+        ses.setSpareRendererPool({ size: 1, webPreferences: { nodeIntegration: true } })
+        await delay(500)
+
+        const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true, session: ses } })
+        await w.loadURL(`http://127.0.0.1:${port}`)
+        const firstProcessId = w.webContents.getProcessId()
+        await w.loadURL(`http://localhost:${port}`)
+        expect(w.webContents.getProcessId()).to.not.equal(firstProcessId)
+
+        const other = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } })
+        await other.loadURL(`http://127.0.0.1:${port}`)
+        const otherProcessId = other.webContents.getProcessId()
+        await other.loadURL(`http://localhost:${port}`)
+        expect(other.webContents.getProcessId()).to.not.equal(otherProcessId)
+      } finally {
+        server.close()
+      }
+    })
+
+    it('throws for a negative size', () => {
+      expect(() => ses.setSpareRendererPool({ size: -1 })).to.throw(/non-negative/)
+    })
+  })
+
   describe('ses.setProxy(options)', () => {
     let server: http.Server
     let customSession: Electron.Session
@@ -3,8 +3,9 @@ import { AddressInfo } from 'net'
 import * as path from 'path'
 import * as fs from 'fs'
 import * as http from 'http'
+import * as zlib from 'zlib'
 import * as ChildProcess from 'child_process'
-import { BrowserWindow, ipcMain, webContents, session, WebContents, app, clipboard } from 'electron'
+import { BrowserWindow, ipcMain, webContents, session, WebContents, app, clipboard, screen } from 'electron'
 import { emittedOnce } from './events-helpers'
 import { closeAllWindows } from './window-helpers'
 import { ifdescribe, ifit } from './spec-helpers'
@@ -1398,6 +1399,28 @@ describe('webContents module', () => {
       }
     })
 
+    it('writes a gzip compressed snapshot and reports progress', async () => {
+      const w = new BrowserWindow({ show: false })
+      await w.loadURL('about:blank')
+
+      const filePath = path.join(app.getPath('temp'), 'test-compressed.heapsnapshot')
+      const phases = new Set<string>()
+      try {
+        await w.webContents.takeHeapSnapshot(filePath, {
+          compress: true,
+          onProgress: (progress) => {
+            expect(progress.done).to.be.a('number')
+            phases.add(progress.phase)
+          }
+        })
+        const snapshot = JSON.parse(zlib.gunzipSync(fs.readFileSync(filePath)).toString())
+        expect(snapshot).to.have.property('snapshot')
+        expect([...phases]).to.include('write')
+      } finally {
+        fs.unlinkSync(filePath)
+      }
+    })
+
     it('fails with invalid file path', async () => {
       const w = new BrowserWindow({
         show: false,
@@ -1413,6 +1436,42 @@ describe('webContents module', () => {
     })
   })
 
+  describe('startCpuProfiling()', () => {
+    afterEach(closeAllWindows)
+
+    it('profiles sandboxed renderers', async () => {
+      const w = new BrowserWindow({
+        show: false,
+        webPreferences: {
+          sandbox: true
+        }
+      })
+      await w.loadURL('about:blank')
+
+      const filePath = path.join(app.getPath('temp'), 'test-renderer.cpuprofile')
+      try {
+        await w.webContents.startCpuProfiling({ samplingInterval: 100 })
+        await expect(w.webContents.startCpuProfiling()).to.be.eventually.rejectedWith(Error, 'The renderer is already being profiled')
+        await w.webContents.executeJavaScript('for (let i = 0; i < 1e6; i++) Math.sqrt(i)')
+        await w.webContents.stopCpuProfiling(filePath)
+        const profile = JSON.parse(fs.readFileSync(filePath, 'utf8'))
+        expect(profile.nodes).to.be.an('array').that.is.not.empty()
+        expect(profile.samples).to.have.lengthOf(profile.timeDeltas.length)
+      } finally {
+        fs.unlinkSync(filePath)
+      }
+    })
+
+    it('stops the profiler when the file can not be written', async () => {
+      const w = new BrowserWindow({ show: false })
+      await w.loadURL('about:blank')
+
+      await w.webContents.startCpuProfiling()
+      await expect(w.webContents.stopCpuProfiling('')).to.be.eventually.rejectedWith(Error, 'stopCpuProfiling failed')
+      await w.webContents.startCpuProfiling()
+    })
+  })
+
   describe('setBackgroundThrottling()', () => {
     afterEach(closeAllWindows)
     it('does not crash when allowing', () => {
@@ -1433,6 +1492,47 @@ describe('webContents module', () => {
     })
   })
 
+  ifdescribe(features.isOffscreenRenderingEnabled())('createOffscreenRenderPool()', () => {
+    let pool: Electron.OffscreenRenderPool
+    beforeEach(() => {
+      pool = webContents.createOffscreenRenderPool({ size: 2, width: 100, height: 100, maxQueueSize: 2 })
+    })
+    afterEach(() => {
+      pool.destroy()
+    })
+
+    it('renders html to a png buffer', async () => {
+      const png = await pool.render({ html: '<body style="background: red"></body>' }) as Buffer
+      expect(png).to.be.an.instanceOf(Buffer)
+      expect(png.slice(1, 4).toString()).to.equal('PNG')
+    })
+
+    it('renders to a NativeImage of the requested size', async () => {
+      const image = await pool.render({ html: '<p>pool</p>', width: 50, height: 40, format: 'image' }) as Electron.NativeImage
+      const { width, height } = image.getSize()
+      const { scaleFactor } = screen.getPrimaryDisplay()
+      expect(width).to.be.closeTo(50 * scaleFactor, 2)
+      expect(height).to.be.closeTo(40 * scaleFactor, 2)
+    })
+
+    it('rejects when the queue is full and emits drain', async () => {
+      const jobs = []
+      for (let i = 0; i < 4; i++) jobs.push(pool.render({ html: `<p>${i}</p>` }))
+      const drained = emittedOnce(pool, 'drain')
+      await expect(pool.render({ html: '<p>overflow</p>' })).to.eventually.be.rejectedWith('Render queue is full')
+      await Promise.all(jobs)
+      await drained
+      expect(pool.getStats()).to.include({ size: 2, busy: 0, queued: 0, completed: 4 })
+    })
+
+    it('rejects pending jobs when destroyed', async () => {
+      const job = pool.render({ html: '<p>destroyed</p>' })
+      pool.destroy()
+      await expect(job).to.eventually.be.rejectedWith('OffscreenRenderPool has been destroyed')
+      expect(pool.isDestroyed()).to.be.true('isDestroyed')
+    })
+  })
+
   ifdescribe(features.isPrintingEnabled())('getPrinters()', () => {
     afterEach(closeAllWindows)
     it('can get printer list', async () => {
@@ -78,6 +78,47 @@ describe('webRequest module', () => {
       await expect(ajax(`${defaultURL}filter/test`)).to.eventually.be.rejectedWith('404')
     })
 
+    it('filters requests redirected to a matching URL', async () => {
+      ses.webRequest.onBeforeRequest({ urls: [defaultURL] }, (details, callback) => {
+        callback({ cancel: true })
+      })
+      await expect(ajax(`${defaultURL}serverRedirect`)).to.eventually.be.rejectedWith('404')
+    })
+
+    it('only proxies requests matching the filter', async () => {
+      const getStats = () => (process as any).electronBinding('session')._getWebRequestStats(ses)
+      ses.webRequest.onBeforeRequest({ urls: [defaultURL + 'filter/*'] }, (details, callback) => {
+        callback({ cancel: true })
+      })
+      const before = getStats()
+      expect((await ajax(`${defaultURL}nofilter/test`)).data).to.equal('/nofilter/test')
+      await expect(ajax(`${defaultURL}filter/test`)).to.eventually.be.rejectedWith('404')
+      const after = getStats()
+      expect(after.bypassed - before.bypassed).to.equal(1)
+      expect(after.proxied - before.proxied).to.equal(1)
+    })
+
+    it('can filter URLs with a wildcard host', async () => {
+      const filter = { urls: ['*://*/filter/*'] }
+      ses.webRequest.onBeforeRequest(filter, (details, callback) => {
+        callback({ cancel: true })
+      })
+      const { data } = await ajax(`${defaultURL}nofilter/test`)
+      expect(data).to.equal('/nofilter/test')
+      await expect(ajax(`${defaultURL}filter/test`)).to.eventually.be.rejectedWith('404')
+    })
+
+    it('can filter URLs with many patterns', async () => {
+      const urls = Array.from({ length: 5000 }, (_, i) => `*://*.ads${i}.example.com/*`)
+      urls.push(defaultURL + 'filter/*')
+      ses.webRequest.onBeforeRequest({ urls }, (details, callback) => {
+        callback({ cancel: true })
+      })
+      const { data } = await ajax(`${defaultURL}nofilter/test`)
+      expect(data).to.equal('/nofilter/test')
+      await expect(ajax(`${defaultURL}filter/test`)).to.eventually.be.rejectedWith('404')
+    })
+
     it('receives details object', async () => {
       ses.webRequest.onBeforeRequest((details, callback) => {
         expect(details.id).to.be.a('number')
@@ -332,6 +373,16 @@ describe('webRequest module', () => {
       const { data } = await ajax(defaultURL)
       expect(data).to.equal('/')
     })
+
+    it('is only emitted for requests matching the filter', async () => {
+      const urls: string[] = []
+      ses.webRequest.onCompleted({ urls: [defaultURL + 'filter/*'] }, (details) => {
+        urls.push(details.url)
+      })
+      expect((await ajax(`${defaultURL}nofilter/test`)).data).to.equal('/nofilter/test')
+      expect((await ajax(`${defaultURL}filter/test`)).data).to.equal('/filter/test')
+      expect(urls).to.deep.equal([`${defaultURL}filter/test`])
+    })
   })
 
   describe('webRequest.onErrorOccurred', () => {
@@ -16,6 +16,46 @@ describe('clipboard module', () => {
     })
   })
 
+  describe('clipboard.readPNG()', () => {
+    it('returns the image as PNG data', () => {
+      const p = path.join(fixtures, 'assets', 'logo.png')
+      const i = nativeImage.createFromPath(p)
+      clipboard.writeImage(i)
+      const png = clipboard.readPNG()
+      expect(png).to.be.an.instanceOf(Uint8Array)
+      expect(nativeImage.createFromBuffer(Buffer.from(png)).toDataURL()).to.equal(i.toDataURL())
+    })
+  })
+
+  describe('clipboard.writePNG()', () => {
+    it('writes an image readable as a NativeImage', () => {
+      const p = path.join(fixtures, 'assets', 'logo.png')
+      const i = nativeImage.createFromPath(p)
+      clipboard.writePNG(i.toPNG())
+      expect(clipboard.readImage().toDataURL()).to.equal(i.toDataURL())
+    })
+
+    it('throws an error when the buffer is not a PNG image', () => {
+      expect(() => {
+        clipboard.writePNG(Buffer.from('not a png'))
+      }).to.throw(/buffer must be a PNG image/)
+    })
+  })
+
+  describe('clipboard.readPNGAsync() and clipboard.writePNGAsync()', () => {
+    it('round-trips an image', async () => {
+      const p = path.join(fixtures, 'assets', 'logo.png')
+      const i = nativeImage.createFromPath(p)
+      await clipboard.writePNGAsync(i.toPNG())
+      const png = await clipboard.readPNGAsync()
+      expect(nativeImage.createFromBuffer(Buffer.from(png)).toDataURL()).to.equal(i.toDataURL())
+    })
+
+    it('rejects when the buffer is not a PNG image', async () => {
+      await expect(clipboard.writePNGAsync(Buffer.from('not a png'))).to.be.eventually.rejectedWith(Error, /buffer must be a PNG image/)
+    })
+  })
+
   describe('clipboard.readText()', () => {
     it('returns unicode string correctly', () => {
       const text = '千江有水千江月，万里无云万里天'
@@ -2,6 +2,7 @@
 
 const { expect } = require('chai')
 const { nativeImage } = require('electron')
+const fs = require('fs')
 const path = require('path')
 
 describe('nativeImage module', () => {
@@ -465,6 +466,121 @@ describe('nativeImage module', () => {
     })
   })
 
+  describe('lazy decoding and encoding cache', () => {
+    const logoPath = path.join(__dirname, 'fixtures', 'assets', 'logo.png')
+
+    it('reports the size of PNG images', () => {
+      const image = nativeImage.createFromPath(logoPath)
+      expect(image.isEmpty()).to.be.false()
+      expect(image.getSize()).to.deep.equal({ width: 538, height: 190 })
+      expect(image.getAspectRatio()).to.be.closeTo(538 / 190, 0.001)
+
+      const imageFromBuffer = nativeImage.createFromBuffer(image.toPNG(), { scaleFactor: 2.0 })
+      expect(imageFromBuffer.getSize()).to.deep.equal({ width: 269, height: 95 })
+    })
+
+    it('decodes the same pixels as before', () => {
+      const image = nativeImage.createFromPath(logoPath)
+      const bitmap = image.toBitmap()
+      expect(bitmap).to.have.lengthOf(538 * 190 * 4)
+      expect(nativeImage.createFromBuffer(image.toPNG()).toBitmap().equals(bitmap)).to.be.true()
+    })
+
+    it('reports PNG images with a corrupt body as empty', () => {
+      const png = nativeImage.createFromPath(logoPath).toPNG()
+      const truncated = nativeImage.createFromBuffer(png.slice(0, png.length / 2))
+      expect(truncated.isEmpty()).to.be.true()
+      expect(truncated.getSize()).to.deep.equal({ width: 0, height: 0 })
+    })
+
+    it('returns the same encoding on repeated calls', () => {
+      const image = nativeImage.createFromPath(logoPath)
+      for (const scaleFactor of [1.0, 2.0]) {
+        expect(image.toPNG({ scaleFactor }).equals(image.toPNG({ scaleFactor }))).to.be.true()
+        expect(image.toDataURL({ scaleFactor })).to.equal(image.toDataURL({ scaleFactor }))
+      }
+      expect(image.toJPEG(80).equals(image.toJPEG(80))).to.be.true()
+      expect(image.toJPEG(80).equals(image.toJPEG(10))).to.be.false()
+    })
+
+    it('returns the PNG data it was created from', () => {
+      const png = fs.readFileSync(logoPath)
+      expect(nativeImage.createFromPath(logoPath).toPNG().equals(png)).to.be.true()
+      expect(nativeImage.createFromBuffer(png).toPNG().equals(png)).to.be.true()
+    })
+
+    it('drops cached encodings when a representation is added', () => {
+      const [imageDataOne] = getImages({ width: 1, height: 1 })
+      const [imageDataTwo] = getImages({ width: 2, height: 2 })
+      const image = nativeImage.createFromPath(imageDataOne.path)
+      expect(image.toDataURL({ scaleFactor: 2.0 })).to.equal(imageDataOne.dataUrl)
+
+      image.addRepresentation({ scaleFactor: 2.0, dataURL: imageDataTwo.dataUrl })
+      expect(image.toDataURL({ scaleFactor: 2.0 })).to.equal(imageDataTwo.dataUrl)
+    })
+  })
+
+  describe('asynchronous variants', () => {
+    const logoPath = path.join(__dirname, 'fixtures', 'assets', 'logo.png')
+
+    it('createFromPathAsync() matches createFromPath()', async () => {
+      const image = await nativeImage.createFromPathAsync(logoPath)
+      expect(image.getSize()).to.deep.equal({ width: 538, height: 190 })
+      expect(image.toDataURL()).to.equal(nativeImage.createFromPath(logoPath).toDataURL())
+
+      const invalid = await nativeImage.createFromPathAsync('does-not-exist.png')
+      expect(invalid.isEmpty()).to.be.true()
+    })
+
+    it('createFromBufferAsync() decodes encoded buffers', async () => {
+      const [imageData] = getImages({ width: 2, height: 2 })
+      const image = await nativeImage.createFromBufferAsync(nativeImage.createFromPath(imageData.path).toJPEG(100))
+      expect(image.getSize()).to.deep.equal({ width: 2, height: 2 })
+
+      expect(() => nativeImage.createFromBufferAsync(12345)).to.throw(/buffer must be a node Buffer/)
+    })
+
+    it('toPNGAsync(), toJPEGAsync() and toDataURLAsync() match the synchronous results', async () => {
+      for (const imageData of getImages({ hasDataUrl: true })) {
+        const image = nativeImage.createFromPath(imageData.path)
+        expect(await image.toDataURLAsync()).to.equal(imageData.dataUrl)
+        expect((await image.toPNGAsync()).equals(image.toPNG())).to.be.true()
+        expect((await image.toJPEGAsync(80)).equals(image.toJPEG(80))).to.be.true()
+      }
+
+      const empty = nativeImage.createEmpty()
+      expect(await empty.toPNGAsync()).to.have.lengthOf(0)
+    })
+
+    it('resizeAsync() matches resize()', async () => {
+      const image = nativeImage.createFromPath(logoPath)
+      for (const resizeTo of [{}, { width: 269 }, { height: 200 }, { width: 80, height: 65 }, { width: 0, height: 0 }]) {
+        const resized = await image.resizeAsync(resizeTo)
+        expect(resized.getSize()).to.deep.equal(image.resize(resizeTo).getSize())
+      }
+      expect((await nativeImage.createEmpty().resizeAsync({ width: 1, height: 1 })).isEmpty()).to.be.true()
+    })
+
+    it('processBatch() processes every source in order', async () => {
+      const [smallImage] = getImages({ width: 1, height: 1 })
+      const sources = [logoPath, nativeImage.createFromPath(smallImage.path), nativeImage.createFromPath(logoPath).toPNG(), 'does-not-exist.png']
+      const images = await nativeImage.processBatch(sources, { resize: { width: 100 } })
+      expect(images.map(image => image.getSize())).to.deep.equal([
+        { width: 100, height: 35 },
+        { width: 100, height: 100 },
+        { width: 100, height: 35 },
+        { width: 0, height: 0 }
+      ])
+
+      const [dataUrl] = await nativeImage.processBatch([smallImage.path], { format: 'dataURL' })
+      expect(dataUrl).to.equal(smallImage.dataUrl)
+
+      expect(await nativeImage.processBatch([])).to.deep.equal([])
+      expect(() => nativeImage.processBatch([{}])).to.throw(/sources must be/)
+      expect(() => nativeImage.processBatch([], { format: 'gif' })).to.throw(/Invalid format/)
+    })
+  })
+
   describe('crop(bounds)', () => {
     it('returns an empty image when called on an empty image', () => {
       expect(nativeImage.createEmpty().crop({ width: 1, height: 2, x: 0, y: 0 }).isEmpty()).to.be.true()
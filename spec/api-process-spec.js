@@ -1,6 +1,7 @@
 const { ipcRenderer } = require('electron')
 const fs = require('fs')
 const path = require('path')
+const zlib = require('zlib')
 
 const { expect } = require('chai')
 
@@ -12,6 +13,21 @@ describe('process module', () => {
     })
   })
 
+  describe('process.getStartupTimeline()', () => {
+    it('returns the startup phases in order', () => {
+      const marks = process.getStartupTimeline()
+      const names = marks.map(mark => mark.name)
+      expect(names).to.include.members(['render-thread-started', 'script-context-created', 'environment-loaded'])
+      expect(new Set(names).size).to.equal(names.length)
+      let previous = 0
+      for (const mark of marks) {
+        expect(mark.time).to.be.a('number').and.be.at.least(previous)
+        expect(mark.duration).to.be.closeTo(mark.time - previous, 0.01)
+        previous = mark.time
+      }
+    })
+  })
+
   describe('process.getCPUUsage()', () => {
     it('returns a cpu usage object', () => {
       const cpuUsage = process.getCPUUsage()
@@ -115,4 +131,97 @@ describe('process module', () => {
       expect(success).to.be.false()
     })
   })
+
+  describe('process.takeHeapSnapshotAsync()', () => {
+    let filePath
+    beforeEach(async () => {
+      filePath = path.join(await ipcRenderer.invoke('get-temp-dir'), 'test-async.heapsnapshot')
+    })
+    afterEach(() => {
+      try {
+        fs.unlinkSync(filePath)
+      } catch (e) {
+        // ignore error
+      }
+    })
+
+    it('writes the snapshot', async () => {
+      await process.takeHeapSnapshotAsync(filePath)
+      const snapshot = JSON.parse(fs.readFileSync(filePath, 'utf8'))
+      expect(snapshot).to.have.property('snapshot')
+    })
+
+    it('writes a gzip compressed snapshot', async () => {
+      await process.takeHeapSnapshotAsync(filePath, { compress: true })
+      const snapshot = JSON.parse(zlib.gunzipSync(fs.readFileSync(filePath)).toString())
+      expect(snapshot).to.have.property('snapshot')
+    })
+
+    it('rejects on failure', async () => {
+      await expect(process.takeHeapSnapshotAsync('')).to.be.eventually.rejectedWith(Error, 'takeHeapSnapshotAsync failed')
+    })
+  })
+
+  describe('process.startSamplingHeapProfiler()', () => {
+    afterEach(() => {
+      process.stopSamplingHeapProfiler()
+    })
+
+    it('samples the allocations in the DevTools format', () => {
+      expect(process.startSamplingHeapProfiler({ samplingInterval: 1024 })).to.be.true()
+      expect(process.startSamplingHeapProfiler()).to.be.false()
+
+      const retained = []
+      for (let i = 0; i < 1000; i++) {
+        retained.push(new Array(100).fill(i))
+      }
+
+      const profile = process.getSamplingHeapProfile()
+      expect(profile.head).to.have.property('callFrame').that.has.property('functionName')
+      expect(profile.head.children).to.be.an('array')
+      expect(profile.samples).to.be.an('array').that.is.not.empty()
+      expect(retained).to.have.lengthOf(1000)
+    })
+
+    it('returns no profile once stopped', () => {
+      process.startSamplingHeapProfiler()
+      process.stopSamplingHeapProfiler()
+      expect(process.getSamplingHeapProfile()).to.be.null()
+    })
+  })
+
+  describe('process.startCpuProfiling()', () => {
+    let filePath
+    beforeEach(async () => {
+      filePath = path.join(await ipcRenderer.invoke('get-temp-dir'), 'test.cpuprofile')
+    })
+    afterEach(() => {
+      try {
+        fs.unlinkSync(filePath)
+      } catch (e) {
+        // ignore error
+      }
+    })
+
+    it('writes a profile in the DevTools format', async () => {
+      expect(process.startCpuProfiling({ samplingInterval: 100 })).to.be.true()
+      expect(process.startCpuProfiling()).to.be.false()
+
+      const end = Date.now() + 50
+      while (Date.now() < end) {
+        Math.sqrt(Math.random())
+      }
+
+      await process.stopCpuProfiling(filePath)
+      const profile = JSON.parse(fs.readFileSync(filePath, 'utf8'))
+      expect(profile.nodes).to.be.an('array').that.is.not.empty()
+      expect(profile.nodes[0]).to.have.property('callFrame').that.has.property('functionName', '(root)')
+      expect(profile.samples).to.have.lengthOf(profile.timeDeltas.length)
+      expect(profile.endTime).to.be.at.least(profile.startTime)
+    })
+
+    it('rejects when the profiler is not running', async () => {
+      await expect(process.stopCpuProfiling(filePath)).to.be.eventually.rejectedWith(Error, 'stopCpuProfiling failed')
+    })
+  })
 })
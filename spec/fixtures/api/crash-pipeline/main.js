@@ -0,0 +1,56 @@
+const { app, BrowserWindow, crashReporter } = require('electron')
+const path = require('path')
+const url = require('url')
+
+const exportDir = process.argv[process.argv.length - 1]
+app.setPath('temp', path.join(exportDir, 'temp'))
+
+crashReporter.start({
+  companyName: 'Umbrella Corporation',
+  productName: 'Zombies',
+  submitURL: 'http://127.0.0.1:1',
+  pipeline: {
+    uploadURL: url.pathToFileURL(exportDir).href,
+    uploadInterval: 1,
+    maxReportsPerSignature: 1
+  }
+})
+
+// Waits until both crashes have been sorted, which happens a few seconds
+// after they were written.
+const waitForSignatures = async () => {
+  while (true) {
+    const signatures = await crashReporter.getCrashSignatures()
+    const rendererSignatures = signatures.filter(s => s.processType === 'renderer')
+    if (rendererSignatures.reduce((count, s) => count + s.count, 0) >= 2 &&
+        rendererSignatures.every(s => s.pendingCount === 0)) {
+      return rendererSignatures
+    }
+    await new Promise(resolve => setTimeout(resolve, 500))
+  }
+}
+
+const crashRenderer = async () => {
+  const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } })
+  await w.loadURL('about:blank')
+  const gone = new Promise(resolve => w.webContents.once('crashed', resolve))
+  w.webContents.executeJavaScript(`
+    require('electron').crashReporter.start({
+      companyName: 'Umbrella Corporation',
+      submitURL: 'http://127.0.0.1:1'
+    })
+    process.crash()
+  `).catch(() => {})
+  await gone
+  w.destroy()
+}
+
+app.whenReady().then(async () => {
+  await crashRenderer()
+  await crashRenderer()
+  console.log(JSON.stringify(await waitForSignatures()))
+  app.quit()
+}).catch((error) => {
+  console.error(error)
+  app.exit(1)
+})
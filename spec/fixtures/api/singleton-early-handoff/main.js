@@ -0,0 +1,18 @@
+const { app } = require('electron')
+
+app.whenReady().then(() => {
+  console.log('started') // ping parent
+})
+
+const gotTheLock = app.requestSingleInstanceLock({ earlyHandoff: true })
+
+app.on('second-instance', (event, args) => {
+  setImmediate(() => {
+    console.log(JSON.stringify(args))
+    app.exit(0)
+  })
+})
+
+if (!gotTheLock) {
+  app.exit(1)
+}